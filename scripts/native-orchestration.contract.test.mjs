@@ -3,7 +3,9 @@ import assert from 'node:assert/strict';
 import { existsSync, readFileSync } from 'node:fs';
 
 const mainText = readFileSync(new URL('../src/main.cpp', import.meta.url), 'utf8');
-const resistanceText = readFileSync(new URL('../src/ResistanceEvaluator.cpp', import.meta.url), 'utf8');
+const actorValueSnapshotText = readFileSync(new URL('../src/ActorValueSnapshot.cpp', import.meta.url), 'utf8');
+const statsCollectorText = readFileSync(new URL('../src/StatsCollector.cpp', import.meta.url), 'utf8');
+const gameSettingsHeaderText = readFileSync(new URL('../src/GameSettings.h', import.meta.url), 'utf8');
 const hotkeysText = readFileSync(new URL('../src/WidgetHotkeys.cpp', import.meta.url), 'utf8');
 const interopContractsText = readFileSync(new URL('../src/WidgetInteropContracts.h', import.meta.url), 'utf8');
 const jsListenersText = readFileSync(new URL('../src/WidgetJsListeners.cpp', import.meta.url), 'utf8');
@@ -25,15 +27,26 @@ test('native orchestration is extracted into WidgetRuntime module', () => {
 
 test('resistance evaluator clamps documented resistance ranges', () => {
   assert.match(
-    resistanceText,
-    /case RE::ActorValue::kResistMagic:[\s\S]*case RE::ActorValue::kPoisonResist:[\s\S]*numeric_limits<float>::lowest[\s\S]*85\.0f, true \};/,
+    actorValueSnapshotText,
+    /numeric_limits<float>::lowest\)\(\), limits\.elementalResistCap\);/,
   );
+  for (const value of ['kResistMagic', 'kResistFire', 'kResistFrost', 'kResistShock', 'kPoisonResist']) {
+    assert.match(actorValueSnapshotText, new RegExp(`EvaluateElemental\\(values, PlayerValue::${value}, limits\\)`));
+  }
+  assert.match(statsCollectorText, /StatLimits\{\s*GameSettings::PlayerMaxResistance\(\),/);
+  assert.match(gameSettingsHeaderText, /kDefaultPlayerMaxResistance = 85\.0f;/);
   assert.match(
-    resistanceText,
-    /case RE::ActorValue::kResistDisease:[\s\S]*return \{ 0\.0f, 100\.0f, true \};/,
+    actorValueSnapshotText,
+    /values\[PlayerValue::kResistDisease\], kDiseaseResistMin, kDiseaseResistCap\);/,
   );
 });
 
+test('actor values are read in one table-driven pass', () => {
+  assert.match(statsCollectorText, /static constexpr std::array kPlayerValueReads\{/);
+  assert.equal(statsCollectorText.match(/GetActorValue\(/g)?.length, 1);
+  assert.equal(statsCollectorText.match(/GetActorValueModifier\(/g)?.length, 1);
+});
+
 test('default hotkeys include F11 widget visibility toggle', () => {
   assert.match(interopContractsText, /kToggleWidgetsVisibilityScript\[] = "toggleWidgetsVisibility\(\)"/);
   assert.match(
@@ -42,12 +55,16 @@ test('default hotkeys include F11 widget visibility toggle', () => {
   );
   assert.match(
     hotkeysText,
-    /Register\(kF11ScanCode, KeyEventType::KEY_DOWN, \[\]\(\) \{[\s\S]*InvokeScript\(TulliusWidgets::WidgetInteropContracts::kToggleWidgetsVisibilityScript\);[\s\S]*\}\);/,
+    /Register\(kF11ScanCode, KeyEventType::KEY_DOWN, \[\]\(\) \{\s*PostGameTask\(GameTaskKind::kToggleWidgetsVisibility\);\s*\}\);/,
+  );
+  assert.match(
+    hotkeysText,
+    /void ToggleWidgetsVisibility\(const GameTask&\)\s*\{[\s\S]*?InvokeScript\(TulliusWidgets::WidgetInteropContracts::kToggleWidgetsVisibilityScript\);/,
   );
 });
 
 test('settings hotkey uses tracked settings-panel state and closes explicitly', () => {
-  assert.match(hotkeysText, /DispatchToGameThread\(\[\]\(\) \{/);
+  assert.match(hotkeysText, /GameTaskQueue::GetSingleton\(\)\.Post\(kind\);/);
   assert.match(hotkeysText, /if \(IsSettingsPanelOpen\(\)\) \{/);
   assert.match(interopContractsText, /kCloseSettingsScript\[] = "closeSettings\(\)"/);
   assert.match(interopContractsText, /kToggleSettingsScript\[] = "toggleSettings\(\)"/);
@@ -66,12 +83,13 @@ test('settings bridge listener uses async native settings save path', () => {
 test('settings bridge listener tracks settings panel visibility for native hotkeys', () => {
   assert.match(interopContractsText, /kOnSettingsVisibilityChanged\[] = "onSettingsVisibilityChanged"/);
   assert.match(jsListenersText, /RegisterJSListener\(view, TulliusWidgets::WidgetInteropContracts::kOnSettingsVisibilityChanged/);
-  assert.match(jsListenersText, /SetSettingsOpen\(open\)/);
+  assert.match(jsListenersText, /PostGameTask\(GameTaskKind::kSetSettingsOpen, open \? 1 : 0\)/);
+  assert.match(jsListenersText, /SetHandler\(GameTaskKind::kSetSettingsOpen, [^\n]*SetSettingsOpen\(task\.a != 0\)/);
 });
 
 test('settings sync bridge result includes optional revision-aware ack support', () => {
   assert.match(interopContractsText, /kOnSettingsSyncResult\[] = "onSettingsSyncResult"/);
-  assert.match(jsListenersText, /TryReadUIntField\(payloadView, "rev"\)/);
+  assert.match(jsListenersText, /TryReadTopLevelUInt\(payloadView, "rev", revision\)/);
   assert.match(jsListenersText, /NotifySettingsSyncResult\(saved, revision\)/);
 });
 
@@ -98,3 +116,50 @@ test('view focus path shows the view and requests PrismaUI focus with pauseGame
   assert.match(viewBridgeText, /api_->Show\(view\);/);
   assert.match(viewBridgeText, /api_->Focus\(view, pauseGame, disableFocusMenu\)/);
 });
+
+test('stats dispatch skips interop calls for unchanged payload fingerprints', () => {
+  const statsDispatcherText = readFileSync(new URL('../src/StatsDispatcher.cpp', import.meta.url), 'utf8');
+  assert.match(statsDispatcherText, /fingerprint == lastSentFingerprint_/);
+  assert.match(widgetRuntimeText, /if \(stats\.empty\(\)\) \{[\s\S]*dispatchesSkippedUnchanged\.fetch_add/);
+  assert.match(widgetRuntimeHeaderText, /DispatchCounters GetDispatchCounters\(\);/);
+});
+
+test('stats requests of a frame are merged into one dispatch from the main loop hook', () => {
+  assert.match(mainText, /if \(!g\.runtimeDiagnostics\.runtimeSupported \|\| !g\.runtimeDiagnostics\.addressLibraryPresent\) \{[\s\S]*?return;\s*\}\s*SKSE::AllocTrampoline\(1 << 10\);\s*TulliusWidgets::WidgetFrameHook::Install\(&OnGameFrame\);\s*TulliusWidgets::WidgetRuntime::SetFrameCoalescing\(true\);/);
+  assert.match(mainText, /InitializeRuntimeDiagnostics\(a_skse\);[\s\S]*?InstallFrameHook\(\);/);
+  assert.match(mainText, /static void OnGameFrame\(\) \{\s*TulliusWidgets::GameTaskQueue::GetSingleton\(\)\.Drain\(\);\s*TulliusWidgets::WidgetRuntime::RunFrameStatsDispatch\(\);/);
+  assert.match(widgetRuntimeText, /pendingFrameDispatch \|= force \? kFrameDispatchForced : kFrameDispatchThrottled;/);
+  // Event sinks can fire off the game thread; their requests are queued.
+  assert.match(widgetEventsText, /void SendStats\(\)\s*\{\s*GameTaskQueue::GetSingleton\(\)\.Post\(GameTaskKind::kStatsDispatch, 0\);/);
+  assert.match(widgetEventsText, /void SendStatsForced\(\)\s*\{\s*GameTaskQueue::GetSingleton\(\)\.Post\(GameTaskKind::kStatsDispatch, 1\);/);
+});
+
+test('game-thread work goes through one typed queue drained from the frame hook', () => {
+  assert.match(mainText, /SetFrameCoalescing\(true\);\s*TulliusWidgets::GameTaskQueue::GetSingleton\(\)\.SetDrainedPerFrame\(true\);/);
+  assert.match(mainText, /GameTaskQueue::GetSingleton\(\)\.SetFrameBudget\(performance\.gameTaskBudget\);/);
+  assert.doesNotMatch(mainText, /AddTask\(/);
+  assert.doesNotMatch(hotkeysText, /AddTask\(/);
+  assert.doesNotMatch(jsListenersText, /AddTask\(/);
+  assert.doesNotMatch(widgetEventsText, /AddTask\(/);
+  assert.match(widgetRuntimeText, /Post\(\s*GameTaskKind::kDeliverStats,/);
+  assert.match(widgetRuntimeText, /Post\(GameTaskKind::kHeartbeatTimers, timers\);/);
+});
+
+test('positional stats encoding is negotiated with the view after the key table is sent', () => {
+  const bootstrapText = readFileSync(new URL('../src/WidgetBootstrap.cpp', import.meta.url), 'utf8');
+  const statsDispatcherText = readFileSync(new URL('../src/StatsDispatcher.cpp', import.meta.url), 'utf8');
+  assert.match(interopContractsText, /kUpdateStatsSchema\[] = "updateStatsSchema"/);
+  assert.match(interopContractsText, /kOnStatsCapabilities\[] = "onStatsCapabilities"/);
+  assert.match(bootstrapText, /callbacks\.sendStatsSchema\(\);[\s\S]*callbacks\.sendStatsForced\(\);/);
+  assert.match(jsListenersText, /TryReadTopLevelUInt\(payload, "schemaVersion", reportedVersion\)/);
+  assert.match(mainText, /ResetViewSchemaVersion\(\);[\s\S]*?TulliusWidgets::StatsCollector::RequestKeyframe\(\);/);
+  assert.match(statsDispatcherText, /payload\.schemaVersion != lastSent\.schemaVersion/);
+});
+
+test('stats name table is dropped on game load and view reload', () => {
+  const statsDispatcherText = readFileSync(new URL('../src/StatsDispatcher.cpp', import.meta.url), 'utf8');
+  assert.match(mainText, /SetGameLoaded\(loaded\);[\s\S]*?ResetNameTable\(\);[\s\S]*?RequestKeyframe\(\);/);
+  assert.match(mainText, /ResetViewSchemaVersion\(\);\s*TulliusWidgets::StatsCollector::ResetNameTable\(\);/);
+  assert.match(statsDispatcherText, /names_\.Reset\(\);\s*keyframeRequested_\.store\(true/);
+  assert.match(statsDispatcherText, /writer_\.Build\(payload, StatsNameUpdate\{ 0, names_\.Entries\(\) \}\)/);
+});
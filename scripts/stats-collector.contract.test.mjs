@@ -6,13 +6,23 @@ const statsCollectorText = readFileSync(new URL('../src/StatsCollector.cpp', imp
 const statsPayloadText = readFileSync(new URL('../src/StatsPayload.h', import.meta.url), 'utf8');
 const statsWriterHeaderText = readFileSync(new URL('../src/StatsJsonWriter.h', import.meta.url), 'utf8');
 const statsWriterText = readFileSync(new URL('../src/StatsJsonWriter.cpp', import.meta.url), 'utf8');
+const statsDispatcherHeaderText = readFileSync(new URL('../src/StatsDispatcher.h', import.meta.url), 'utf8');
+const statsDispatcherText = readFileSync(new URL('../src/StatsDispatcher.cpp', import.meta.url), 'utf8');
+const statsSchemaText = readFileSync(new URL('../src/StatsPayloadSchema.h', import.meta.url), 'utf8');
+const statsSchemaDocText = readFileSync(new URL('../docs/stats-payload-schema.md', import.meta.url), 'utf8');
+const statsSchemaFieldsText = readFileSync(new URL('../docs/stats-payload-schema.fields.txt', import.meta.url), 'utf8');
+const statsTypesText = readFileSync(new URL('../view/src/types/stats.ts', import.meta.url), 'utf8');
+const timedEffectTableText = readFileSync(new URL('../src/TimedEffectTable.cpp', import.meta.url), 'utf8');
 
 test('stats collector separates payload definitions, collection, and JSON writing by file', () => {
   assert.match(statsPayloadText, /struct StatsPayload \{/);
-  assert.match(statsPayloadText, /StatsPayload CollectStatsPayload\(RE::PlayerCharacter\* player\);/);
+  assert.match(statsPayloadText, /void CaptureStatsPayload\(RE::PlayerCharacter\* player, StatsCaptureFrame& frame, std::uint32_t sections = kStatsSectionAll\);/);
+  assert.match(statsPayloadText, /void FinishStatsPayload\(const StatsCaptureFrame& frame, StatsPayload& payload, StatsScratch& strings, StatsNameTable& names\);/);
   assert.match(statsWriterHeaderText, /class StatsJsonWriter \{/);
-  assert.match(statsCollectorText, /const auto payload = StatsCollectorInternal::CollectStatsPayload\(player\);/);
-  assert.match(statsCollectorText, /StatsCollectorInternal::StatsJsonWriter writer;/);
+  assert.match(statsDispatcherHeaderText, /class StatsDispatcher \{/);
+  assert.match(statsCollectorText, /StatsCollectorInternal::CaptureStatsPayload\(player, frame, sections\);[\s\S]*?rateSample = WidgetRuntime::UpdateRateSample\{[\s\S]*?\};\s*state\.frames\.Publish\(\);/);
+  assert.match(statsCollectorText, /StatsCollectorInternal::FinishStatsPayload\(frame, capture\.payload, capture\.strings, capture\.names\);/);
+  assert.match(statsDispatcherHeaderText, /StatsJsonWriter writer_\{\};/);
   assert.doesNotMatch(statsCollectorText, /struct StatsPayload \{/);
   assert.doesNotMatch(statsCollectorText, /class StatsJsonWriter \{/);
 });
@@ -20,8 +30,128 @@ test('stats collector separates payload definitions, collection, and JSON writin
 test('stats collector writer still emits core payload contract sections', () => {
   assert.match(statsWriterText, /\\"schemaVersion\\"/);
   assert.match(statsWriterText, /\\"seq\\"/);
-  assert.match(statsWriterText, /\\"calcMeta\\"/);
-  assert.match(statsWriterText, /\\"timedEffects\\"/);
-  assert.match(statsWriterText, /\\"expectedLevelThreshold\\"/);
-  assert.match(statsWriterText, /\\"isInCombat\\"/);
+  assert.match(statsSchemaText, /Object<"calcMeta">/);
+  assert.match(statsSchemaText, /Array<"timedEffects">/);
+  assert.match(statsSchemaText, /Field<"expectedLevelThreshold">/);
+  assert.match(statsSchemaText, /Field<"isInCombat">/);
+});
+
+test('stats collector emits keyframes and section deltas chained by baseSeq', () => {
+  assert.match(statsWriterHeaderText, /std::string_view BuildDelta\(\s*const StatsPayload& payload,\s*std::uint32_t sections,\s*std::uint32_t baseSequence,/);
+  assert.match(statsWriterText, /\\"keyframe\\"/);
+  assert.match(statsWriterText, /\\"baseSeq\\"/);
+  assert.match(statsPayloadText, /kStatsSectionAll = /);
+  assert.match(statsDispatcherText, /DiffStatsSections\(lastSent, payload\)/);
+  assert.match(statsCollectorText, /void StatsCollector::RequestKeyframe\(\)/);
+});
+
+test('stats writer formats numbers without snprintf', () => {
+  assert.doesNotMatch(statsWriterText, /snprintf/);
+  assert.doesNotMatch(statsSchemaText, /snprintf/);
+  assert.match(statsSchemaText, /JsonUtils::AppendFixed2\(out, value\);/);
+  assert.match(statsSchemaText, /JsonUtils::AppendInteger\(out, value\);/);
+});
+
+const META_PATHS = ['schemaVersion', 'seq', 'keyframe', 'baseSeq'];
+// Fields the view stamps locally on receipt; they never travel over the bridge.
+const VIEW_ONLY_PATHS = ['time.snapshotAtMs', 'timedEffects[].stableKey', 'timedEffects[].snapshotAtMs'];
+
+// `path:type` lines from DumpStatsPayloadSchema(); a host test keeps the
+// file in sync with kStatsPayloadSchema.
+function readSchemaFieldList(text) {
+  return text
+    .split('\n')
+    .filter((line) => line.length > 0)
+    .map((line) => line.slice(0, line.lastIndexOf(':')))
+    .filter((path) => !META_PATHS.includes(path));
+}
+
+function flattenJson(value, prefix = '') {
+  if (Array.isArray(value)) {
+    return value.length > 0 ? flattenJson(value[0], `${prefix}[]`) : [];
+  }
+  if (value !== null && typeof value === 'object') {
+    return Object.entries(value).flatMap(([key, child]) => flattenJson(child, prefix ? `${prefix}.${key}` : key));
+  }
+  return [prefix];
+}
+
+function flattenInterfaces(text, rootName) {
+  const interfaces = new Map();
+  for (const match of text.matchAll(/export interface (\w+) \{([^}]*)\}/g)) {
+    const fields = [...match[2].matchAll(/^\s*(\w+)\??:\s*([\w[\]]+);/gm)].map(([, name, type]) => ({ name, type }));
+    interfaces.set(match[1], fields);
+  }
+  const walk = (name, prefix) =>
+    interfaces.get(name).flatMap(({ name: field, type }) => {
+      const path = prefix ? `${prefix}.${field}` : field;
+      const isArray = type.endsWith('[]');
+      const elementType = isArray ? type.slice(0, -2) : type;
+      const elementPath = isArray ? `${path}[]` : path;
+      return interfaces.has(elementType) ? walk(elementType, elementPath) : [elementPath];
+    });
+  return walk(rootName, '');
+}
+
+const sorted = (paths) => [...paths].sort();
+const schemaPaths = readSchemaFieldList(statsSchemaFieldsText);
+
+test('stats writer delegates section layout to the compile-time schema table', () => {
+  assert.match(statsWriterText, /StatsSchema::WriteSections\(json_, payload, sections, kStatsPayloadSchema\);/);
+  assert.doesNotMatch(statsWriterText, /void StatsJsonWriter::Append(Resistances|PlayerInfo|TimedEffects)\(/);
+  assert.match(statsSchemaText, /inline std::string DumpStatsPayloadSchema\(\)/);
+  for (const section of ['Resistances', 'Defense', 'Offense', 'CalcMeta', 'Equipped', 'Movement', 'Time', 'PlayerInfo', 'AlertData', 'TimedEffects', 'Combat']) {
+    assert.match(statsSchemaText, new RegExp(`StatsSchema::Section<kStatsSection${section}>\\(`));
+  }
+});
+
+test('stats schema table has no duplicate wire paths', () => {
+  assert.ok(schemaPaths.length > 50);
+  assert.equal(new Set(schemaPaths).size, schemaPaths.length);
+});
+
+test('stats schema table matches the documented updateStats example', () => {
+  const block = statsSchemaDocText.match(/```json\n([\s\S]*?)\n```/);
+  assert.ok(block, 'updateStats JSON example not found');
+  const docPaths = flattenJson(JSON.parse(block[1])).filter((path) => !META_PATHS.includes(path));
+  assert.deepEqual(sorted(docPaths), sorted(schemaPaths));
+});
+
+test('stats schema table matches the view CombatStats type', () => {
+  const viewPaths = flattenInterfaces(statsTypesText, 'CombatStats').filter((path) => !VIEW_ONLY_PATHS.includes(path));
+  assert.deepEqual(sorted(viewPaths), sorted(schemaPaths));
+});
+
+test('stats strings are escaped in place and effect names normalized natively', () => {
+  const gameStatsHookText = readFileSync(new URL('../view/src/hooks/useGameStats.ts', import.meta.url), 'utf8');
+  assert.match(statsSchemaText, /JsonUtils::AppendEscaped\(out, value\);/);
+  assert.doesNotMatch(statsSchemaText, /JsonUtils::Escape\(/);
+  assert.match(timedEffectTableText, /JsonUtils::NormalizeDisplayText\(sourceName\);\s*JsonUtils::NormalizeDisplayText\(effectName\);/);
+  assert.match(statsCollectorText, /GetTimedEffectSourceName\(effect, effectName\)/);
+  assert.doesNotMatch(gameStatsHookText, /sanitizeEffectText/);
+});
+
+test('stats pipeline reuses persistent buffers and hands a view to interop', () => {
+  const statsCollectorHeaderText = readFileSync(new URL('../src/StatsCollector.h', import.meta.url), 'utf8');
+  const widgetRuntimeText = readFileSync(new URL('../src/WidgetRuntime.cpp', import.meta.url), 'utf8');
+  assert.match(statsCollectorHeaderText, /static bool CaptureStats\(WidgetRuntime::UpdateRateSample& rateSample\);/);
+  assert.match(statsCollectorHeaderText, /static bool BuildStatsJson\(std::string_view& json\);/);
+  assert.match(statsWriterHeaderText, /std::string_view Build\(const StatsPayload& payload, StatsNameUpdate names = \{\}\);/);
+  assert.match(statsDispatcherHeaderText, /std::array<Slot, 2> slots_\{\};/);
+  assert.match(statsDispatcherText, /captureIndex_ \^= 1;/);
+  assert.doesNotMatch(statsCollectorText, /StatsJsonWriter writer;/);
+  assert.doesNotMatch(statsPayloadText, /std::string (sourceName|effectName|monthName|rightHand|leftHand)/);
+  assert.match(widgetRuntimeText, /if \(!g_callbacks\.buildStatsJson\(stats\)\) \{/);
+  assert.match(widgetRuntimeText, /kUpdateStats, stats\.data\(\)\);/);
+});
+
+test('effect and equipped names are interned for positional payloads', () => {
+  const nameTableHeaderText = readFileSync(new URL('../src/StatsNameTable.h', import.meta.url), 'utf8');
+  assert.match(nameTableHeaderText, /class StatsNameTable \{/);
+  assert.match(nameTableHeaderText, /std::equal_to<>/);
+  for (const key of ['rightHand', 'leftHand', 'sourceName', 'effectName']) {
+    assert.match(statsSchemaText, new RegExp(`StatsSchema::NameRef<"${key}">\\(`));
+  }
+  assert.match(timedEffectTableText, /names\.Intern\(sourceName\);\s*entry->effectNameId = names\.Intern\(effectName\);/);
+  assert.match(statsWriterText, /,\\"nameBase\\":/);
 });
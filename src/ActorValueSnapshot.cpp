@@ -0,0 +1,123 @@
+#include "ActorValueSnapshot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+namespace {
+
+ResistanceEvaluation EvaluateElemental(const ActorValueSnapshot& values, PlayerValue value, const StatLimits& limits)
+{
+    return ResistanceEvaluator::Evaluate(
+        values[value], (std::numeric_limits<float>::lowest)(), limits.elementalResistCap);
+}
+
+float Current(float max, float damage)
+{
+    return (std::max)(max + damage, 0.0f);
+}
+
+}  // namespace
+
+ResistanceSnapshot DeriveResistances(const ActorValueSnapshot& values, const StatLimits& limits)
+{
+    ResistanceSnapshot snapshot{};
+    snapshot.magic = EvaluateElemental(values, PlayerValue::kResistMagic, limits);
+    snapshot.fire = EvaluateElemental(values, PlayerValue::kResistFire, limits);
+    snapshot.frost = EvaluateElemental(values, PlayerValue::kResistFrost, limits);
+    snapshot.shock = EvaluateElemental(values, PlayerValue::kResistShock, limits);
+    snapshot.poison = EvaluateElemental(values, PlayerValue::kPoisonResist, limits);
+    snapshot.disease = ResistanceEvaluator::Evaluate(
+        values[PlayerValue::kResistDisease], kDiseaseResistMin, kDiseaseResistCap);
+    snapshot.anyClamped =
+        snapshot.magic.clamped || snapshot.fire.clamped || snapshot.frost.clamped ||
+        snapshot.shock.clamped || snapshot.poison.clamped || snapshot.disease.clamped;
+    return snapshot;
+}
+
+DefenseSnapshot DeriveDefense(const ActorValueSnapshot& values, const StatLimits& limits)
+{
+    const float armorRating = values[PlayerValue::kDamageResist];
+    const float rawDamageReduction = armorRating * limits.armorScalingFactor;
+    return DefenseSnapshot{
+        armorRating,
+        rawDamageReduction,
+        (std::min)(rawDamageReduction, limits.damageReductionCap),
+        rawDamageReduction > limits.damageReductionCap + 0.001f
+    };
+}
+
+MovementSnapshot DeriveMovement(const ActorValueSnapshot& values)
+{
+    return MovementSnapshot{ values[PlayerValue::kSpeedMult] };
+}
+
+VitalsSnapshot DeriveVitals(const ActorValueSnapshot& values)
+{
+    const float maxHP = values[PlayerValue::kHealth];
+    const float maxMP = values[PlayerValue::kMagicka];
+    const float maxSP = values[PlayerValue::kStamina];
+    const float carryCur = values[PlayerValue::kInventoryWeight];
+    const float carryMax = values[PlayerValue::kCarryWeight];
+
+    VitalsSnapshot vitals{};
+    vitals.health = Current(maxHP, values[PlayerValue::kHealthDamage]);
+    vitals.magicka = Current(maxMP, values[PlayerValue::kMagickaDamage]);
+    vitals.stamina = Current(maxSP, values[PlayerValue::kStaminaDamage]);
+    vitals.carryWeight = carryCur;
+    vitals.maxCarryWeight = carryMax;
+    vitals.alertData = AlertDataSnapshot{
+        maxHP > 0 ? (vitals.health / maxHP) * 100.0f : 100.0f,
+        maxMP > 0 ? (vitals.magicka / maxMP) * 100.0f : 100.0f,
+        maxSP > 0 ? (vitals.stamina / maxSP) * 100.0f : 100.0f,
+        carryMax > 0 ? (carryCur / carryMax) * 100.0f : 0.0f
+    };
+    return vitals;
+}
+
+StatCapsSnapshot DeriveStatCaps(const StatLimits& limits)
+{
+    return StatCapsSnapshot{
+        limits.elementalResistCap,
+        limits.damageReductionCap,
+        limits.damageReductionCap / limits.armorScalingFactor
+    };
+}
+
+CritChanceEvaluation DeriveCritChance(float chance)
+{
+    if (!std::isfinite(chance)) chance = 0.0f;
+    const float effective = std::clamp(chance, 0.0f, kCritChanceCap);
+    return CritChanceEvaluation{
+        chance,
+        effective,
+        kCritChanceCap,
+        std::abs(effective - chance) > 0.001f
+    };
+}
+
+void DeriveStatsSections(const RawStatsCapture& raw, StatsPayload& payload)
+{
+    if (raw.sections & kStatsSectionResistances) {
+        payload.resistances = DeriveResistances(raw.values, raw.limits);
+    }
+    if (raw.sections & kStatsSectionDefense) {
+        payload.defense = DeriveDefense(raw.values, raw.limits);
+    }
+    if (raw.sections & kStatsSectionCalcMeta) {
+        payload.caps = DeriveStatCaps(raw.limits);
+    }
+    payload.movement = DeriveMovement(raw.values);
+
+    const auto vitals = DeriveVitals(raw.values);
+    payload.playerInfo.health = vitals.health;
+    payload.playerInfo.magicka = vitals.magicka;
+    payload.playerInfo.stamina = vitals.stamina;
+    payload.playerInfo.carryWeight = vitals.carryWeight;
+    payload.playerInfo.maxCarryWeight = vitals.maxCarryWeight;
+    payload.alertData = vitals.alertData;
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
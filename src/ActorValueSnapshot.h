@@ -0,0 +1,90 @@
+#pragma once
+
+#include "StatsPayload.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Player actor values the collector reads. The collector fills them in a
+// single table-driven pass (see kPlayerValueReads in StatsCollector.cpp);
+// everything shown from them is derived below without touching the engine.
+// The *Damage entries are damage modifiers, zero or negative.
+enum class PlayerValue : std::uint8_t {
+    kHealth,
+    kMagicka,
+    kStamina,
+    kHealthDamage,
+    kMagickaDamage,
+    kStaminaDamage,
+    kInventoryWeight,
+    kCarryWeight,
+    kSpeedMult,
+    kDamageResist,
+    kResistMagic,
+    kResistFire,
+    kResistFrost,
+    kResistShock,
+    kPoisonResist,
+    kResistDisease,
+    kCriticalChance,
+    // Weapon damage inputs; they key the memoized per-hand stats.
+    kOneHanded,
+    kTwoHanded,
+    kArchery,
+    kAttackDamageMult,
+};
+
+inline constexpr std::size_t kPlayerValueCount = 21;
+
+struct ActorValueSnapshot {
+    std::array<float, kPlayerValueCount> values{};
+
+    float operator[](PlayerValue value) const noexcept { return values[static_cast<std::size_t>(value)]; }
+    float& operator[](PlayerValue value) noexcept { return values[static_cast<std::size_t>(value)]; }
+};
+
+// Game settings the derivations depend on, resolved by the caller.
+struct StatLimits {
+    float elementalResistCap{GameSettings::kDefaultPlayerMaxResistance};
+    float armorScalingFactor{GameSettings::kDefaultArmorScalingFactor};
+    float damageReductionCap{GameSettings::kDefaultMaxArmorRating};
+};
+
+struct VitalsSnapshot {
+    float health{0.0f};
+    float magicka{0.0f};
+    float stamina{0.0f};
+    float carryWeight{0.0f};
+    float maxCarryWeight{0.0f};
+    AlertDataSnapshot alertData{};
+};
+
+// Everything CaptureStatsPayload read for the sections derived off the game
+// thread.
+struct RawStatsCapture {
+    std::uint32_t sections{kStatsSectionAll};
+    ActorValueSnapshot values{};
+    StatLimits limits{};
+    // The frame's timed effect rows were read and should be emitted.
+    bool timedEffectsRefreshed{false};
+    // Timed effects the refresh saw; feeds the update rate.
+    std::uint32_t timedEffectCount{0};
+};
+
+ResistanceSnapshot DeriveResistances(const ActorValueSnapshot& values, const StatLimits& limits);
+DefenseSnapshot DeriveDefense(const ActorValueSnapshot& values, const StatLimits& limits);
+MovementSnapshot DeriveMovement(const ActorValueSnapshot& values);
+VitalsSnapshot DeriveVitals(const ActorValueSnapshot& values);
+StatCapsSnapshot DeriveStatCaps(const StatLimits& limits);
+// `chance` is the critical chance after perk entry points; non-finite
+// values count as 0.
+CritChanceEvaluation DeriveCritChance(float chance);
+
+// Fills resistances, defense and caps for the sections in `raw`, and
+// movement, vitals and alert data always. Leaves the rest of `payload` as
+// the capture wrote it.
+void DeriveStatsSections(const RawStatsCapture& raw, StatsPayload& payload);
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -1,14 +1,25 @@
 #include "CriticalChanceEvaluator.h"
+#include "ActorValueSnapshot.h"
+#include "EvaluationMemo.h"
 
-#include <algorithm>
 #include <cmath>
 #include <windows.h>
 
 namespace TulliusWidgets {
 namespace {
-static constexpr float kCritChanceMin = 0.0f;
-static constexpr float kCritChanceCap = 100.0f;
 
+// Everything the perk entry point result depends on that can be compared
+// cheaply; perk and effect changes are covered by the epoch.
+struct CritChanceKey {
+    RE::FormID weapon{ 0 };
+    std::uint32_t target{ 0 };
+    float baseCritChance{ 0.0f };
+    std::uint32_t inputsEpoch{ 0 };
+
+    bool operator==(const CritChanceKey&) const = default;
+};
+
+StatsCollectorInternal::EvaluationMemo<CritChanceKey, float> gCritChanceMemo;
 // SEH and C++ EH cannot coexist in the same function (MSVC restriction).
 // Isolate the potentially crashing HandleEntryPoint call in its own function.
 static bool TryHandleEntryPoint_SEH(
@@ -69,43 +80,40 @@ RE::Actor* SelectCurrentTarget(RE::PlayerCharacter* player) {
 
 }  // namespace
 
-CritChanceEvaluation CriticalChanceEvaluator::Evaluate(RE::PlayerCharacter* player) {
+CritChanceEvaluation CriticalChanceEvaluator::Evaluate(
+    RE::PlayerCharacter* player,
+    float baseCritChance,
+    std::uint32_t inputsEpoch) {
     if (!player) {
-        return CritChanceEvaluation{ 0.0f, 0.0f, kCritChanceCap, false };
+        return StatsCollectorInternal::DeriveCritChance(0.0f);
     }
 
-    float critChance = player->AsActorValueOwner()->GetActorValue(RE::ActorValue::kCriticalChance);
-    if (!std::isfinite(critChance)) critChance = 0.0f;
-    const float baseCritChance = critChance;
+    if (!std::isfinite(baseCritChance)) baseCritChance = 0.0f;
 
     auto* weapon = SelectActiveWeapon(player);
-    if (!weapon) {
-        const float effective = std::clamp(critChance, kCritChanceMin, kCritChanceCap);
-        return CritChanceEvaluation{
-            critChance,
-            effective,
-            kCritChanceCap,
-            std::abs(effective - critChance) > 0.001f
-        };
+    auto* target = weapon ? SelectCurrentTarget(player) : nullptr;
+    if (!target) {
+        return StatsCollectorInternal::DeriveCritChance(baseCritChance);
     }
 
-    auto* target = SelectCurrentTarget(player);
-    if (target && !TryHandleEntryPoint_SEH(player, weapon, target, std::addressof(critChance))) {
-        critChance = baseCritChance;
-    }
-
-    if (!std::isfinite(critChance)) critChance = 0.0f;
-    const float effective = std::clamp(critChance, kCritChanceMin, kCritChanceCap);
-    return CritChanceEvaluation{
-        critChance,
-        effective,
-        kCritChanceCap,
-        std::abs(effective - critChance) > 0.001f
+    const CritChanceKey key{
+        weapon->GetFormID(),
+        player->GetActorRuntimeData().currentCombatTarget.native_handle(),
+        baseCritChance,
+        inputsEpoch
     };
+    const float critChance = gCritChanceMemo.Get(key, [&]() {
+        float chance = baseCritChance;
+        if (!TryHandleEntryPoint_SEH(player, weapon, target, std::addressof(chance))) {
+            chance = baseCritChance;
+        }
+        return chance;
+    });
+    return StatsCollectorInternal::DeriveCritChance(critChance);
 }
 
-float CriticalChanceEvaluator::GetEffectiveCritChance(RE::PlayerCharacter* player) {
-    return Evaluate(player).effective;
+StatsCollectorInternal::MemoStats CriticalChanceEvaluator::GetMemoStats() {
+    return gCritChanceMemo.Counters().Snapshot();
 }
 
 }  // namespace TulliusWidgets
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "StatsDiagnostics.h"
+#include <cstdint>
+
 namespace TulliusWidgets {
 
 struct CritChanceEvaluation {
@@ -11,8 +14,16 @@ struct CritChanceEvaluation {
 
 class CriticalChanceEvaluator {
 public:
-    static CritChanceEvaluation Evaluate(RE::PlayerCharacter* player);
-    static float GetEffectiveCritChance(RE::PlayerCharacter* player);
+    // `baseCritChance` is the player's kCriticalChance actor value, read with
+    // the rest of the actor-value snapshot. The perk entry point result is
+    // memoized per weapon, combat target, base value and `inputsEpoch`,
+    // which the caller advances when perks or effects may have changed.
+    // Collecting thread only.
+    static CritChanceEvaluation Evaluate(
+        RE::PlayerCharacter* player,
+        float baseCritChance,
+        std::uint32_t inputsEpoch);
+    static StatsCollectorInternal::MemoStats GetMemoStats();
 };
 
 }  // namespace TulliusWidgets
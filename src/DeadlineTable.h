@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace TulliusWidgets::WidgetRuntime {
+
+// Deadlines of a small fixed set of timers, indexed by an enum whose last
+// enumerator is kCount. With a handful of timers a linear scan beats a
+// heap. Not thread-safe.
+template <class Timer>
+class DeadlineTable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kTimerCount = static_cast<std::size_t>(Timer::kCount);
+    static_assert(kTimerCount <= 32, "TakeDue() reports timers as bits of a uint32");
+
+    void Arm(Timer timer, Clock::time_point due) noexcept { deadlines_[Index(timer)] = due; }
+    void Disarm(Timer timer) noexcept { deadlines_[Index(timer)] = kDisarmed; }
+    void DisarmAll() noexcept { deadlines_.fill(kDisarmed); }
+    bool IsArmed(Timer timer) const noexcept { return deadlines_[Index(timer)] != kDisarmed; }
+
+    // Earliest armed deadline; Clock::time_point::max() when none is armed.
+    Clock::time_point Next() const noexcept
+    {
+        auto next = kDisarmed;
+        for (const auto due : deadlines_) {
+            if (due < next) next = due;
+        }
+        return next;
+    }
+
+    // Disarms the timers due at `now` and returns them as bits (1 << timer).
+    std::uint32_t TakeDue(Clock::time_point now) noexcept
+    {
+        std::uint32_t due = 0;
+        for (std::size_t i = 0; i < kTimerCount; ++i) {
+            if (deadlines_[i] != kDisarmed && deadlines_[i] <= now) {
+                deadlines_[i] = kDisarmed;
+                due |= 1u << i;
+            }
+        }
+        return due;
+    }
+
+    static constexpr std::uint32_t Bit(Timer timer) noexcept { return 1u << Index(timer); }
+
+private:
+    static constexpr auto kDisarmed = Clock::time_point::max();
+
+    static constexpr std::size_t Index(Timer timer) noexcept { return static_cast<std::size_t>(timer); }
+
+    std::array<Clock::time_point, kTimerCount> deadlines_ = MakeDisarmed();
+
+    static constexpr std::array<Clock::time_point, kTimerCount> MakeDisarmed() noexcept
+    {
+        std::array<Clock::time_point, kTimerCount> deadlines{};
+        deadlines.fill(kDisarmed);
+        return deadlines;
+    }
+};
+
+}  // namespace TulliusWidgets::WidgetRuntime
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "StatsDiagnostics.h"
+#include <chrono>
+#include <utility>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Remembers the result of an expensive evaluation for the last key it ran
+// with. `Key` must be equality-comparable and capture every input the
+// evaluation depends on, including an invalidation epoch for inputs that
+// cannot be compared cheaply. Not thread-safe apart from Counters().
+template <class Key, class Value>
+class EvaluationMemo {
+public:
+    template <class Evaluate>
+    const Value& Get(const Key& key, Evaluate&& evaluate)
+    {
+        if (valid_ && key == key_) {
+            counters_.RecordHit();
+            return value_;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        value_ = std::forward<Evaluate>(evaluate)();
+        counters_.RecordMiss(std::chrono::steady_clock::now() - start);
+        key_ = key;
+        valid_ = true;
+        return value_;
+    }
+
+    void Invalidate() noexcept { valid_ = false; }
+    const MemoCounters& Counters() const noexcept { return counters_; }
+
+private:
+    Key key_{};
+    Value value_{};
+    bool valid_{ false };
+    MemoCounters counters_{};
+};
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
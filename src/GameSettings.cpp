@@ -0,0 +1,90 @@
+#include "GameSettings.h"
+
+#include <cmath>
+
+namespace TulliusWidgets::GameSettings {
+namespace {
+
+struct CachedSettings {
+    RE::Setting* xpLevelUpBase{ nullptr };
+    RE::Setting* xpLevelUpMult{ nullptr };
+    RE::Setting* hudColorDefault{ nullptr };
+    RE::Setting* armorScalingFactor{ nullptr };
+    RE::Setting* maxArmorRating{ nullptr };
+    RE::Setting* playerMaxResistance{ nullptr };
+};
+
+CachedSettings g_settings{};
+
+RE::Setting* FindGameSetting(RE::GameSettingCollection* collection, const char* name)
+{
+    auto* setting = collection ? collection->GetSetting(name) : nullptr;
+    if (!setting) {
+        logger::warn("Game setting {} not found; using the vanilla value", name);
+    }
+    return setting;
+}
+
+float ReadFloat(const RE::Setting* setting, float fallback)
+{
+    if (!setting || setting->GetType() != RE::Setting::Type::kFloat) return fallback;
+    const float value = setting->GetFloat();
+    return std::isfinite(value) ? value : fallback;
+}
+
+}  // namespace
+
+void Resolve()
+{
+    auto* gameSettings = RE::GameSettingCollection::GetSingleton();
+    g_settings.xpLevelUpBase = FindGameSetting(gameSettings, "fXPLevelUpBase");
+    g_settings.xpLevelUpMult = FindGameSetting(gameSettings, "fXPLevelUpMult");
+    g_settings.armorScalingFactor = FindGameSetting(gameSettings, "fArmorScalingFactor");
+    g_settings.maxArmorRating = FindGameSetting(gameSettings, "fMaxArmorRating");
+    g_settings.playerMaxResistance = FindGameSetting(gameSettings, "fPlayerMaxResistance");
+
+    auto* ini = RE::INISettingCollection::GetSingleton();
+    g_settings.hudColorDefault = ini ? ini->GetSetting("iHUDColorDefault:Interface") : nullptr;
+
+    logger::info(
+        "Game settings resolved: armorScaling={:.4f}, maxArmorRating={:.1f}, maxResistance={:.1f}",
+        ArmorScalingFactor(),
+        MaxArmorRating(),
+        PlayerMaxResistance());
+}
+
+float XPLevelUpBase()
+{
+    return ReadFloat(g_settings.xpLevelUpBase, kDefaultXPLevelUpBase);
+}
+
+float XPLevelUpMult()
+{
+    return ReadFloat(g_settings.xpLevelUpMult, kDefaultXPLevelUpMult);
+}
+
+std::uint32_t HUDColorDefault()
+{
+    const auto* setting = g_settings.hudColorDefault;
+    if (!setting) return kDefaultHUDColor;
+    return static_cast<std::uint32_t>(setting->GetSInt()) & 0xFFFFFF;
+}
+
+float ArmorScalingFactor()
+{
+    const float value = ReadFloat(g_settings.armorScalingFactor, kDefaultArmorScalingFactor);
+    return value > 0.0f ? value : kDefaultArmorScalingFactor;
+}
+
+float MaxArmorRating()
+{
+    const float value = ReadFloat(g_settings.maxArmorRating, kDefaultMaxArmorRating);
+    return value > 0.0f ? value : kDefaultMaxArmorRating;
+}
+
+float PlayerMaxResistance()
+{
+    return ReadFloat(g_settings.playerMaxResistance, kDefaultPlayerMaxResistance);
+}
+
+}  // namespace TulliusWidgets::GameSettings
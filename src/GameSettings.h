@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace TulliusWidgets::GameSettings {
+
+// Vanilla values, used until the settings resolve or when one is missing.
+inline constexpr float kDefaultXPLevelUpBase = 75.0f;
+inline constexpr float kDefaultXPLevelUpMult = 25.0f;
+inline constexpr std::uint32_t kDefaultHUDColor = 0xFFFFFF;
+inline constexpr float kDefaultArmorScalingFactor = 0.12f;
+inline constexpr float kDefaultMaxArmorRating = 80.0f;
+inline constexpr float kDefaultPlayerMaxResistance = 85.0f;
+
+// Looks the cached game and INI settings up by name. Call after kDataLoaded
+// and again on every game load; the accessors below only dereference the
+// cached pointers, so they read current values without hashing a name.
+// Game thread only.
+void Resolve();
+
+float XPLevelUpBase();
+float XPLevelUpMult();
+// iHUDColorDefault:Interface as 0xRRGGBB.
+std::uint32_t HUDColorDefault();
+// Damage reduction percent per point of armor rating (fArmorScalingFactor).
+float ArmorScalingFactor();
+// Damage reduction cap in percent (fMaxArmorRating).
+float MaxArmorRating();
+// Elemental, magic and poison resistance cap in percent (fPlayerMaxResistance).
+float PlayerMaxResistance();
+
+}  // namespace TulliusWidgets::GameSettings
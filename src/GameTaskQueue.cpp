@@ -0,0 +1,211 @@
+#include "GameTaskQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace TulliusWidgets {
+namespace {
+
+// Requests whose second run adds nothing to the first. Every other kind
+// sets or flips state, so dropping a repeat could leave the wrong value
+// behind (open, close, open) or undo a toggle.
+bool IsCoalescable(GameTaskKind kind) noexcept
+{
+    switch (kind) {
+    case GameTaskKind::kStatsDispatch:
+    case GameTaskKind::kRequestStatsKeyframe:
+    case GameTaskKind::kHeartbeatTimers:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool IsSameTask(const GameTask& queued, const GameTask& task) noexcept
+{
+    return queued.kind == task.kind && queued.a == task.a && queued.b == task.b;
+}
+
+}  // namespace
+
+GameTaskQueue::GameTaskQueue()
+    : ring_(kInitialCapacity)
+{
+}
+
+GameTaskQueue& GameTaskQueue::GetSingleton()
+{
+    static GameTaskQueue singleton;
+    return singleton;
+}
+
+void GameTaskQueue::SetHandler(GameTaskKind kind, Handler handler) noexcept
+{
+    handlers_[static_cast<std::size_t>(kind)].store(handler, std::memory_order_release);
+}
+
+void GameTaskQueue::SetDrainedPerFrame(bool drained) noexcept
+{
+    std::scoped_lock lock(mutex_);
+    drainedPerFrame_ = drained;
+}
+
+void GameTaskQueue::SetFrameBudget(std::chrono::microseconds budget) noexcept
+{
+    std::scoped_lock lock(mutex_);
+    budget_ = std::clamp(budget, kMinGameTaskBudget, kMaxGameTaskBudget);
+}
+
+std::chrono::microseconds GameTaskQueue::FrameBudget() const noexcept
+{
+    std::scoped_lock lock(mutex_);
+    return budget_;
+}
+
+void GameTaskQueue::Post(GameTaskKind kind, std::uint64_t a, std::uint64_t b)
+{
+    Push(GameTask{ kind, a, b, {} });
+}
+
+void GameTaskQueue::PostCallback(std::function<void()> callback)
+{
+    if (!callback) {
+        return;
+    }
+    Push(GameTask{ GameTaskKind::kCallback, 0, 0, std::move(callback) });
+}
+
+void GameTaskQueue::Push(GameTask&& task)
+{
+    bool scheduleDrain = false;
+    {
+        std::scoped_lock lock(mutex_);
+        ++counters_.posted;
+        if (IsCoalescable(task.kind)) {
+            const auto mask = ring_.size() - 1;
+            for (std::size_t i = 0; i < size_; ++i) {
+                if (IsSameTask(ring_[(head_ + i) & mask], task)) {
+                    ++counters_.coalesced;
+                    return;
+                }
+            }
+        }
+        if (size_ == ring_.size()) {
+            // Unwrap into a ring twice the size.
+            std::vector<GameTask> grown(ring_.size() * 2);
+            for (std::size_t i = 0; i < size_; ++i) {
+                grown[i] = std::move(ring_[(head_ + i) & (ring_.size() - 1)]);
+            }
+            ring_ = std::move(grown);
+            head_ = 0;
+        }
+        ring_[(head_ + size_) & (ring_.size() - 1)] = std::move(task);
+        ++size_;
+        scheduleDrain = !drainedPerFrame_ && !taskInterfaceDrainScheduled_;
+        taskInterfaceDrainScheduled_ = taskInterfaceDrainScheduled_ || scheduleDrain;
+    }
+    if (scheduleDrain) {
+        ScheduleTaskInterfaceDrain();
+    }
+}
+
+void GameTaskQueue::ScheduleTaskInterfaceDrain()
+{
+    // The posting thread may be a worker, so the drain goes through SKSE's
+    // task interface, which runs it on the game thread.
+    if (const auto taskInterface = SKSE::GetTaskInterface()) {
+        taskInterface->AddTask([this]() { DrainFromTaskInterface(); });
+        return;
+    }
+    // Before SKSE::Init(); the tasks stay queued for the next post.
+    std::scoped_lock lock(mutex_);
+    taskInterfaceDrainScheduled_ = false;
+}
+
+void GameTaskQueue::DrainFromTaskInterface()
+{
+    {
+        std::scoped_lock lock(mutex_);
+        taskInterfaceDrainScheduled_ = false;
+    }
+    (void)Drain();
+
+    bool scheduleDrain = false;
+    {
+        // Tasks the budget left behind, unless the frame hook took over.
+        std::scoped_lock lock(mutex_);
+        scheduleDrain = size_ > 0 && !drainedPerFrame_ && !taskInterfaceDrainScheduled_;
+        taskInterfaceDrainScheduled_ = taskInterfaceDrainScheduled_ || scheduleDrain;
+    }
+    if (scheduleDrain) {
+        ScheduleTaskInterfaceDrain();
+    }
+}
+
+bool GameTaskQueue::TryPop(GameTask& task)
+{
+    std::scoped_lock lock(mutex_);
+    if (size_ == 0) {
+        return false;
+    }
+    auto& slot = ring_[head_];
+    task = std::move(slot);
+    slot.callback = nullptr;
+    head_ = (head_ + 1) & (ring_.size() - 1);
+    --size_;
+    ++counters_.run;
+    return true;
+}
+
+void GameTaskQueue::Run(const GameTask& task) const
+{
+    if (task.kind == GameTaskKind::kCallback) {
+        if (task.callback) {
+            task.callback();
+        }
+        return;
+    }
+    if (const auto handler = handlers_[static_cast<std::size_t>(task.kind)].load(std::memory_order_acquire)) {
+        handler(task);
+    }
+}
+
+std::size_t GameTaskQueue::Drain()
+{
+    std::size_t pending = 0;
+    std::chrono::microseconds budget{};
+    {
+        std::scoped_lock lock(mutex_);
+        pending = size_;
+        budget = budget_;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + budget;
+    GameTask task;
+    std::size_t ran = 0;
+    while (ran < pending && TryPop(task)) {
+        Run(task);
+        ++ran;
+        if (ran < pending && Clock::now() >= deadline) {
+            std::scoped_lock lock(mutex_);
+            ++counters_.deferred;
+            break;
+        }
+    }
+    return ran;
+}
+
+std::size_t GameTaskQueue::Pending() const
+{
+    std::scoped_lock lock(mutex_);
+    return size_;
+}
+
+GameTaskQueue::Counters GameTaskQueue::GetCounters() const
+{
+    std::scoped_lock lock(mutex_);
+    return counters_;
+}
+
+}  // namespace TulliusWidgets
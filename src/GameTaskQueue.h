@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace TulliusWidgets {
+
+// Work the plugin hands to the game thread. Each kind has one handler,
+// registered by the module that owns it; arguments travel in the task.
+enum class GameTaskKind : std::uint8_t {
+    // Runs GameTask::callback. For rare tasks that carry a payload (settings
+    // documents, presets); the std::function may allocate.
+    kCallback,
+    // WidgetRuntime. a: force.
+    kStatsDispatch,
+    // WidgetRuntime. a: pointer, b: size of the JSON to send.
+    kDeliverStats,
+    // WidgetRuntime. a: heartbeat timers that came due, as bits.
+    kHeartbeatTimers,
+    // WidgetBootstrap. a: view.
+    kViewDomReady,
+    // WidgetHotkeys.
+    kToggleSettingsPanel,
+    kFocusSettingsPanel,
+    kCloseSettingsPanel,
+    kToggleWidgetsVisibility,
+    // WidgetJsListeners. kSetSettingsOpen a: open;
+    // kSetStatsViewSchemaVersion a: version; kSettingsSyncResult a: saved,
+    // b: revision + 1, or 0 without one.
+    kUnfocusView,
+    kSetSettingsOpen,
+    kRequestStatsKeyframe,
+    kSetStatsViewSchemaVersion,
+    kSettingsSyncResult,
+    kImportPreset,
+    kCount
+};
+
+struct GameTask {
+    GameTaskKind kind{ GameTaskKind::kCallback };
+    std::uint64_t a{ 0 };
+    std::uint64_t b{ 0 };
+    std::function<void()> callback{};
+};
+
+inline constexpr auto kDefaultGameTaskBudget = std::chrono::microseconds(1000);
+// Accepted range of the budget from the settings file.
+inline constexpr auto kMinGameTaskBudget = std::chrono::microseconds(100);
+inline constexpr auto kMaxGameTaskBudget = std::chrono::microseconds(8000);
+
+// The plugin's one queue of game-thread work, drained once per frame by the
+// frame hook, or through SKSE's task interface when there is none. A
+// waiting request (stats dispatch, keyframe, heartbeat timers) absorbs an
+// identical one posted after it, so repeated requests run once; tasks that
+// set or toggle state all run, in order. Typed tasks are stored inline in a
+// ring that only grows past kInitialCapacity pending tasks. Posting is safe
+// from any thread; Drain() belongs to the game thread.
+class GameTaskQueue {
+public:
+    using Handler = void (*)(const GameTask& task);
+
+    struct Counters {
+        std::uint64_t posted{ 0 };
+        std::uint64_t coalesced{ 0 };
+        std::uint64_t run{ 0 };
+        // Drains that ran out of budget and left tasks for the next frame.
+        std::uint64_t deferred{ 0 };
+    };
+
+    static constexpr std::size_t kInitialCapacity = 64;
+
+    GameTaskQueue();
+
+    static GameTaskQueue& GetSingleton();
+
+    void SetHandler(GameTaskKind kind, Handler handler) noexcept;
+    // Until this is switched on no frame hook drains the queue, so a post
+    // schedules a Drain() through SKSE's task interface instead.
+    void SetDrainedPerFrame(bool drained) noexcept;
+    // Clamped to [kMinGameTaskBudget, kMaxGameTaskBudget].
+    void SetFrameBudget(std::chrono::microseconds budget) noexcept;
+    std::chrono::microseconds FrameBudget() const noexcept;
+
+    void Post(GameTaskKind kind, std::uint64_t a = 0, std::uint64_t b = 0);
+    void PostCallback(std::function<void()> callback);
+
+    // Runs the tasks pending when called, oldest first, until the frame
+    // budget is spent; at least one task runs per call. Tasks posted while
+    // it runs wait for the next call. Returns how many ran.
+    std::size_t Drain();
+
+    std::size_t Pending() const;
+    Counters GetCounters() const;
+
+private:
+    void Push(GameTask&& task);
+    bool TryPop(GameTask& task);
+    void Run(const GameTask& task) const;
+    void ScheduleTaskInterfaceDrain();
+    void DrainFromTaskInterface();
+
+    std::array<std::atomic<Handler>, static_cast<std::size_t>(GameTaskKind::kCount)> handlers_{};
+    mutable std::mutex mutex_;
+    // Ring buffer; its size is always a power of two.
+    std::vector<GameTask> ring_;
+    std::size_t head_{ 0 };
+    std::size_t size_{ 0 };
+    bool drainedPerFrame_{ false };
+    // A task-interface drain is on its way; later posts ride along with it.
+    bool taskInterfaceDrainScheduled_{ false };
+    std::chrono::microseconds budget_{ kDefaultGameTaskBudget };
+    Counters counters_{};
+};
+
+}  // namespace TulliusWidgets
@@ -0,0 +1,38 @@
+#include "InventoryIndex.h"
+
+#include <algorithm>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+void InventoryIndex::Reset()
+{
+    entries_.clear();
+    totals_.fill(0);
+    seeded_ = false;
+}
+
+const InventoryCategory* InventoryIndex::FindCategory(std::uint32_t formId) const
+{
+    const auto it = entries_.find(formId);
+    return it != entries_.end() ? &it->second.category : nullptr;
+}
+
+void InventoryIndex::Add(std::uint32_t formId, InventoryCategory category, std::int32_t delta)
+{
+    auto& entry = entries_[formId];
+    entry.category = category;
+    if (category == InventoryCategory::kUntracked) return;
+
+    // A late or duplicated removal must not leave a negative count behind.
+    const auto next = (std::max)(entry.count + delta, 0);
+    totals_[static_cast<std::size_t>(category)] += next - entry.count;
+    entry.count = next;
+}
+
+std::int32_t InventoryIndex::Count(std::uint32_t formId) const
+{
+    const auto it = entries_.find(formId);
+    return it != entries_.end() ? it->second.count : 0;
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+inline constexpr std::uint32_t kGoldFormId = 0x0000000F;
+
+// Item groups the index keeps running totals for. Ammo is kept per form
+// only: the widget shows the count of whichever ammo is equipped.
+//
+// The set is fixed rather than configurable: each category feeds one
+// playerInfo field of the stats schema, so tracking another group means a
+// new value here, a branch in the collector's ClassifyInventoryItem() and
+// a schema field.
+enum class InventoryCategory : std::uint8_t {
+    kUntracked,
+    kGold,
+    kAmmo,
+    kHealthPotion,
+    kMagickaPotion,
+    kStaminaPotion,
+};
+
+inline constexpr std::size_t kInventoryCategoryCount = 6;
+
+// Player item counts for the tracked categories, seeded once from the
+// inventory and then kept current from container-change deltas, so reads
+// never walk the inventory change list. Forms are classified once; the
+// result (tracked or not) is remembered until Reset().
+class InventoryIndex {
+public:
+    // Forgets every count and classification; IsSeeded() is false until
+    // the next MarkSeeded().
+    void Reset();
+    bool IsSeeded() const noexcept { return seeded_; }
+    void MarkSeeded() noexcept { seeded_ = true; }
+
+    // Category remembered for `formId`, or nullptr when it has not been
+    // classified yet.
+    const InventoryCategory* FindCategory(std::uint32_t formId) const;
+    // Records `formId` as `category` and applies `delta` to its count.
+    // Counts never drop below zero; untracked forms keep no count.
+    void Add(std::uint32_t formId, InventoryCategory category, std::int32_t delta);
+
+    std::int32_t Count(std::uint32_t formId) const;
+    std::int32_t Total(InventoryCategory category) const noexcept
+    {
+        return totals_[static_cast<std::size_t>(category)];
+    }
+
+private:
+    struct Entry {
+        InventoryCategory category{ InventoryCategory::kUntracked };
+        std::int32_t count{ 0 };
+    };
+
+    std::unordered_map<std::uint32_t, Entry> entries_{};
+    std::array<std::int32_t, kInventoryCategoryCount> totals_{};
+    bool seeded_{ false };
+};
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
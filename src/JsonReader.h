@@ -0,0 +1,293 @@
+#pragma once
+
+#include "JsonUtils.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace TulliusWidgets::JsonUtils {
+
+enum class JsonValueKind {
+    kString,
+    kNumber,
+    kBoolean,
+    kNull,
+    kObject,
+    kArray,
+};
+
+// A top-level member of the scanned object. `key` and string values are the
+// raw text between the quotes, escapes left as-is (keyEscaped tells whether
+// there were any); other values span their full token, nested containers
+// included.
+struct JsonField {
+    std::string_view key;
+    bool keyEscaped;
+    JsonValueKind kind;
+    std::string_view raw;
+};
+
+// Containers nested deeper than this are rejected.
+inline constexpr std::size_t kMaxJsonDepth = 64;
+
+namespace Detail {
+
+// Single-pass RFC 8259 validator over a string_view. Never allocates: the
+// container stack is a bitset, so nesting is capped at kMaxJsonDepth.
+class JsonScanner {
+public:
+    explicit JsonScanner(std::string_view input) noexcept : input_(input) {}
+
+    template <class OnField>
+    bool ScanObject(OnField& onField) noexcept
+    {
+        SkipWhitespace();
+        if (!Consume('{')) return false;
+        SkipWhitespace();
+        if (Consume('}')) return AtEnd();
+
+        while (true) {
+            SkipWhitespace();
+            JsonField field{};
+            if (!ScanString(field.key, field.keyEscaped)) return false;
+            SkipWhitespace();
+            if (!Consume(':')) return false;
+            SkipWhitespace();
+            if (!ScanValue(field.kind, field.raw)) return false;
+            onField(static_cast<const JsonField&>(field));
+            SkipWhitespace();
+            if (Consume(',')) continue;
+            if (Consume('}')) return AtEnd();
+            return false;
+        }
+    }
+
+private:
+    bool AtEnd() noexcept
+    {
+        SkipWhitespace();
+        return pos_ == input_.size();
+    }
+
+    char Peek() const noexcept { return pos_ < input_.size() ? input_[pos_] : '\0'; }
+
+    bool Consume(char expected) noexcept
+    {
+        if (pos_ < input_.size() && input_[pos_] == expected) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void SkipWhitespace() noexcept
+    {
+        while (pos_ < input_.size()) {
+            const char c = input_[pos_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return;
+            ++pos_;
+        }
+    }
+
+    static bool IsDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+    static bool IsHexDigit(char c) noexcept
+    {
+        return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    bool ScanString(std::string_view& contents, bool& escaped) noexcept
+    {
+        if (!Consume('"')) return false;
+        const std::size_t begin = pos_;
+        escaped = false;
+        while (pos_ < input_.size()) {
+            // Plain ASCII runs are skipped a block at a time; non-ASCII bytes
+            // stop the scan but need no checks here.
+            pos_ += FindEscapeCandidate(input_.data() + pos_, input_.data() + input_.size());
+            if (pos_ >= input_.size()) break;
+            const auto c = static_cast<unsigned char>(input_[pos_]);
+            if (c == '"') {
+                contents = input_.substr(begin, pos_ - begin);
+                ++pos_;
+                return true;
+            }
+            if (c < 0x20) return false;
+            if (c != '\\') {
+                ++pos_;
+                continue;
+            }
+
+            escaped = true;
+            if (++pos_ >= input_.size()) return false;
+            switch (input_[pos_++]) {
+            case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                break;
+            case 'u':
+                for (int i = 0; i < 4; ++i, ++pos_) {
+                    if (!IsHexDigit(Peek())) return false;
+                }
+                break;
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+    bool ScanDigits() noexcept
+    {
+        const std::size_t begin = pos_;
+        while (IsDigit(Peek())) ++pos_;
+        return pos_ != begin;
+    }
+
+    bool ScanNumber() noexcept
+    {
+        (void)Consume('-');
+        if (Consume('0')) {
+            if (IsDigit(Peek())) return false;
+        } else if (!ScanDigits()) {
+            return false;
+        }
+        if (Consume('.') && !ScanDigits()) return false;
+        if (Consume('e') || Consume('E')) {
+            if (!Consume('+')) (void)Consume('-');
+            if (!ScanDigits()) return false;
+        }
+        return true;
+    }
+
+    bool ScanLiteral(std::string_view literal) noexcept
+    {
+        if (input_.substr(pos_, literal.size()) != literal) return false;
+        pos_ += literal.size();
+        return true;
+    }
+
+    bool ScanScalar(JsonValueKind& kind) noexcept
+    {
+        std::string_view contents;
+        bool escaped = false;
+        switch (Peek()) {
+        case '"': kind = JsonValueKind::kString; return ScanString(contents, escaped);
+        case 't': kind = JsonValueKind::kBoolean; return ScanLiteral("true");
+        case 'f': kind = JsonValueKind::kBoolean; return ScanLiteral("false");
+        case 'n': kind = JsonValueKind::kNull; return ScanLiteral("null");
+        default: kind = JsonValueKind::kNumber; return ScanNumber();
+        }
+    }
+
+    // Skips a whole object or array. The bit for each open container is set
+    // for objects, so the matching closer and the need for keys are known.
+    bool ScanContainer() noexcept
+    {
+        std::uint64_t objectBits = 0;
+        std::size_t depth = 0;
+        const auto open = [&](char c) {
+            if (depth == kMaxJsonDepth) return false;
+            objectBits = (objectBits << 1) | (c == '{' ? 1u : 0u);
+            ++depth;
+            ++pos_;
+            return true;
+        };
+
+        if (!open(Peek())) return false;
+        bool expectValue = true;
+        while (true) {
+            SkipWhitespace();
+            const bool inObject = (objectBits & 1u) != 0;
+            if (expectValue) {
+                // Empty container, or a value after '[' / '{' / ','.
+                if (Consume(inObject ? '}' : ']')) {
+                    objectBits >>= 1;
+                    if (--depth == 0) return true;
+                    expectValue = false;
+                    continue;
+                }
+                if (inObject) {
+                    std::string_view key;
+                    bool escaped = false;
+                    if (!ScanString(key, escaped)) return false;
+                    SkipWhitespace();
+                    if (!Consume(':')) return false;
+                    SkipWhitespace();
+                }
+                const char c = Peek();
+                if (c == '{' || c == '[') {
+                    if (!open(c)) return false;
+                    continue;
+                }
+                JsonValueKind kind{};
+                if (!ScanScalar(kind)) return false;
+                expectValue = false;
+                continue;
+            }
+
+            if (Consume(',')) {
+                // A trailing comma is caught by requiring a value next.
+                SkipWhitespace();
+                const char next = Peek();
+                if (next == '}' || next == ']') return false;
+                expectValue = true;
+                continue;
+            }
+            if (!Consume(inObject ? '}' : ']')) return false;
+            objectBits >>= 1;
+            if (--depth == 0) return true;
+        }
+    }
+
+    bool ScanValue(JsonValueKind& kind, std::string_view& raw) noexcept
+    {
+        const std::size_t begin = pos_;
+        const char c = Peek();
+        if (c == '{' || c == '[') {
+            kind = c == '{' ? JsonValueKind::kObject : JsonValueKind::kArray;
+            if (!ScanContainer()) return false;
+        } else if (!ScanScalar(kind)) {
+            return false;
+        }
+
+        raw = input_.substr(begin, pos_ - begin);
+        if (kind == JsonValueKind::kString) {
+            raw = raw.substr(1, raw.size() - 2);
+        }
+        return true;
+    }
+
+    std::string_view input_;
+    std::size_t pos_{ 0 };
+};
+
+}  // namespace Detail
+
+// Validates that `input` is exactly one well-formed JSON object and calls
+// `onField(const JsonField&)` for each top-level member, in order, in the
+// same pass. Nested members are validated but not reported, so a key inside
+// a string or a nested object is never mistaken for a top-level one. Returns
+// false on malformed input; fields seen before the error were still reported.
+template <class OnField>
+bool ScanTopLevelFields(std::string_view input, OnField&& onField) noexcept
+{
+    Detail::JsonScanner scanner(input);
+    return scanner.ScanObject(onField);
+}
+
+// A non-negative integer that fits in 32 bits; fractions, exponents and
+// signs are rejected rather than truncated.
+inline std::optional<std::uint32_t> ReadUInt32(const JsonField& field) noexcept
+{
+    if (field.kind != JsonValueKind::kNumber) return std::nullopt;
+    std::uint32_t value = 0;
+    const char* begin = field.raw.data();
+    const char* end = begin + field.raw.size();
+    const auto [ptr, ec] = std::from_chars(begin, end, value);
+    if (ec != std::errc{} || ptr != end) return std::nullopt;
+    return value;
+}
+
+}  // namespace TulliusWidgets::JsonUtils
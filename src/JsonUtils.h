@@ -1,87 +1,326 @@
 #pragma once
 
+#include <bit>
 #include <charconv>
-#include <cctype>
+#include <cmath>
+#include <concepts>
 #include <cstdint>
-#include <cstdio>
-#include <optional>
+#include <cstring>
 #include <string>
 #include <string_view>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TULLIUS_WIDGETS_JSON_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace TulliusWidgets::JsonUtils {
 
-inline std::string Escape(std::string_view input)
+namespace Detail {
+
+inline constexpr char kHexDigits[] = "0123456789ABCDEF";
+inline constexpr std::string_view kUtf8ReplacementCharacter = "\xEF\xBF\xBD";
+
+// Scalar reference for the scanners below: offset of the first byte in
+// [begin, end) that is '"', '\\', a control byte or non-ASCII.
+inline std::size_t FindEscapeCandidateScalar(const char* begin, const char* end)
 {
-    std::string out;
-    out.reserve(input.size() * 2 + 2);
-    for (unsigned char c : input) {
-        switch (c) {
-        case '\\':
-            out += "\\\\";
-            break;
-        case '"':
-            out += "\\\"";
-            break;
-        case '\b':
-            out += "\\b";
-            break;
-        case '\f':
-            out += "\\f";
-            break;
-        case '\n':
-            out += "\\n";
-            break;
-        case '\r':
-            out += "\\r";
+    const char* cursor = begin;
+    for (; cursor < end; ++cursor) {
+        const auto c = static_cast<unsigned char>(*cursor);
+        if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\') {
             break;
-        case '\t':
-            out += "\\t";
-            break;
-        default:
-            if (c < 0x20) {
-                char unicodeBuf[7];
-                std::snprintf(unicodeBuf, sizeof(unicodeBuf), "\\u%04X", static_cast<unsigned int>(c));
-                out += unicodeBuf;
-            } else {
-                out += static_cast<char>(c);
+        }
+    }
+    return static_cast<std::size_t>(cursor - begin);
+}
+
+// Eight bytes per step with the classic "has zero byte" bit tricks. Borrows
+// can only flag bytes after a genuine hit, so the lowest flagged byte is exact.
+inline std::size_t FindEscapeCandidateSwar(const char* begin, const char* end)
+{
+    constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+    constexpr std::uint64_t kHighBits = 0x8080808080808080ull;
+    const char* cursor = begin;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; end - cursor >= 8; cursor += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, cursor, sizeof(word));
+            const std::uint64_t quote = word ^ (kOnes * '"');
+            const std::uint64_t backslash = word ^ (kOnes * '\\');
+            const std::uint64_t hits = ((quote - kOnes) & ~quote)
+                | ((backslash - kOnes) & ~backslash)
+                | ((word - kOnes * 0x20) & ~word)
+                | word;
+            if (const std::uint64_t mask = hits & kHighBits; mask != 0) {
+                return static_cast<std::size_t>(cursor - begin) + static_cast<std::size_t>(std::countr_zero(mask) / 8);
             }
-            break;
         }
     }
-    return out;
+    return static_cast<std::size_t>(cursor - begin) + FindEscapeCandidateScalar(cursor, end);
 }
 
-inline std::optional<std::uint32_t> TryReadUIntField(std::string_view input, std::string_view key)
+#if defined(TULLIUS_WIDGETS_JSON_SSE2)
+// Sixteen bytes per step. A signed compare against 0x20 catches both control
+// bytes and bytes >= 0x80 (negative as int8).
+inline std::size_t FindEscapeCandidateSse2(const char* begin, const char* end)
 {
-    const std::string needle = "\"" + std::string(key) + "\"";
-    std::size_t searchOffset = 0;
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i space = _mm_set1_epi8(0x20);
+    const char* cursor = begin;
+    for (; end - cursor >= 16; cursor += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmplt_epi8(chunk, space));
+        if (const int mask = _mm_movemask_epi8(hits); mask != 0) {
+            return static_cast<std::size_t>(cursor - begin) + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+        }
+    }
+    return static_cast<std::size_t>(cursor - begin) + FindEscapeCandidateSwar(cursor, end);
+}
+#endif
+
+inline std::size_t FindEscapeCandidate(const char* begin, const char* end)
+{
+#if defined(TULLIUS_WIDGETS_JSON_SSE2)
+    return FindEscapeCandidateSse2(begin, end);
+#else
+    return FindEscapeCandidateSwar(begin, end);
+#endif
+}
+
+struct Utf8Sequence {
+    std::size_t length;
+    bool valid;
+};
+
+// Validates the multi-byte sequence starting at `data[0]` (>= 0x80) per
+// Unicode Table 3-7. Invalid input reports the maximal ill-formed subpart so
+// each one becomes a single U+FFFD, as browsers' TextDecoder does.
+inline Utf8Sequence ReadUtf8Sequence(const unsigned char* data, std::size_t available)
+{
+    const unsigned char lead = data[0];
+    std::size_t continuationBytes = 0;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        continuationBytes = 1;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        continuationBytes = 2;
+        if (lead == 0xE0) low = 0xA0;
+        if (lead == 0xED) high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        continuationBytes = 3;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;
+    } else {
+        return { 1, false };
+    }
 
-    while (true) {
-        const auto keyPos = input.find(needle, searchOffset);
-        if (keyPos == std::string_view::npos) {
-            return std::nullopt;
+    for (std::size_t i = 1; i <= continuationBytes; ++i) {
+        if (i >= available || data[i] < low || data[i] > high) {
+            return { i, false };
         }
+        low = 0x80;
+        high = 0xBF;
+    }
+    return { continuationBytes + 1, true };
+}
 
-        const auto colonPos = input.find(':', keyPos + needle.size());
-        if (colonPos == std::string_view::npos) {
-            return std::nullopt;
+inline void AppendEscapedAscii(std::string& out, unsigned char c)
+{
+    switch (c) {
+    case '\\':
+        out += "\\\\";
+        break;
+    case '"':
+        out += "\\\"";
+        break;
+    case '\b':
+        out += "\\b";
+        break;
+    case '\f':
+        out += "\\f";
+        break;
+    case '\n':
+        out += "\\n";
+        break;
+    case '\r':
+        out += "\\r";
+        break;
+    case '\t':
+        out += "\\t";
+        break;
+    default:
+        out += "\\u00";
+        out += kHexDigits[c >> 4];
+        out += kHexDigits[c & 0x0F];
+        break;
+    }
+}
+
+}  // namespace Detail
+
+// Appends the JSON string body of `input` (no surrounding quotes) to `out`.
+// Clean runs, including well-formed UTF-8, are copied in bulk; invalid UTF-8
+// is replaced with U+FFFD so the result always parses.
+inline void AppendEscaped(std::string& out, std::string_view input)
+{
+    const char* const end = input.data() + input.size();
+    const char* run = input.data();
+    const char* cursor = input.data();
+    while (cursor < end) {
+        cursor += Detail::FindEscapeCandidate(cursor, end);
+        if (cursor == end) {
+            break;
         }
 
-        auto valuePos = colonPos + 1;
-        while (valuePos < input.size() && std::isspace(static_cast<unsigned char>(input[valuePos]))) {
-            ++valuePos;
+        auto c = static_cast<unsigned char>(*cursor);
+        if (c < 0x80) {
+            out.append(run, cursor);
+            Detail::AppendEscapedAscii(out, c);
+            run = ++cursor;
+            continue;
         }
 
-        std::uint32_t value = 0;
-        const char* begin = input.data() + valuePos;
-        const char* end = input.data() + input.size();
-        const auto [ptr, ec] = std::from_chars(begin, end, value);
-        if (ec == std::errc{} && ptr != begin) {
-            return value;
+        // Localized names are mostly multi-byte; stay in the validator until
+        // the next ASCII byte instead of re-entering the vector scan per glyph.
+        do {
+            const auto sequence = Detail::ReadUtf8Sequence(
+                reinterpret_cast<const unsigned char*>(cursor), static_cast<std::size_t>(end - cursor));
+            if (!sequence.valid) {
+                out.append(run, cursor);
+                out += Detail::kUtf8ReplacementCharacter;
+                cursor += sequence.length;
+                run = cursor;
+            } else {
+                cursor += sequence.length;
+            }
+        } while (cursor < end && (c = static_cast<unsigned char>(*cursor)) >= 0x80);
+    }
+    out.append(run, end);
+}
+
+inline std::string Escape(std::string_view input)
+{
+    std::string out;
+    out.reserve(input.size() + 2);
+    AppendEscaped(out, input);
+    return out;
+}
+
+// Length of the UTF-8 encoded Unicode space starting at `data`, or 0: the
+// non-ASCII characters JavaScript's \s matches (U+00A0, U+1680,
+// U+2000-U+200A, U+2028, U+2029, U+202F, U+205F, U+3000 and U+FEFF).
+inline std::size_t UnicodeSpaceLength(const unsigned char* data, std::size_t size)
+{
+    if (size >= 2 && data[0] == 0xC2 && data[1] == 0xA0) return 2;
+    if (size < 3) return 0;
+    const unsigned char b0 = data[0];
+    const unsigned char b1 = data[1];
+    const unsigned char b2 = data[2];
+    if (b0 == 0xE2 && b1 == 0x80) {
+        const bool space = (b2 >= 0x80 && b2 <= 0x8A) || b2 == 0xA8 || b2 == 0xA9 || b2 == 0xAF;
+        return space ? 3 : 0;
+    }
+    if ((b0 == 0xE1 && b1 == 0x9A && b2 == 0x80)
+        || (b0 == 0xE2 && b1 == 0x81 && b2 == 0x9F)
+        || (b0 == 0xE3 && b1 == 0x80 && b2 == 0x80)
+        || (b0 == 0xEF && b1 == 0xBB && b2 == 0xBF)) {
+        return 3;
+    }
+    return 0;
+}
+
+// Replaces control bytes, DEL and Unicode spaces with spaces, collapses
+// whitespace runs and trims both ends, in place. Returns the new length.
+// Applied to engine-provided display names before they enter the payload.
+inline std::size_t NormalizeDisplayText(char* data, std::size_t size)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    std::size_t write = 0;
+    bool pendingSpace = false;
+    for (std::size_t read = 0; read < size; ++read) {
+        const auto c = bytes[read];
+        if (c <= 0x20 || c == 0x7F) {
+            pendingSpace = write != 0;
+            continue;
         }
+        if (c >= 0xC2) {
+            if (const auto spaceLength = UnicodeSpaceLength(bytes + read, size - read)) {
+                pendingSpace = write != 0;
+                read += spaceLength - 1;
+                continue;
+            }
+        }
+        if (pendingSpace) {
+            data[write++] = ' ';
+            pendingSpace = false;
+        }
+        data[write++] = static_cast<char>(c);
+    }
+    return write;
+}
+
+inline void NormalizeDisplayText(std::string& text)
+{
+    text.resize(NormalizeDisplayText(text.data(), text.size()));
+}
+
+// Appends `value` exactly as printf("%.2f") would in the C locale, without
+// going through the format parser. Non-finite values are written as 0 so the
+// output is always valid JSON.
+inline void AppendFixed2(std::string& out, float value)
+{
+    if (!std::isfinite(value)) {
+        out += '0';
+        return;
+    }
 
-        searchOffset = keyPos + needle.size();
+    // float has a 24-bit significand, so value * 100 needs at most 31 bits
+    // and is exact in double. Rounding that to an integer with ties-to-even
+    // therefore matches printf's correctly rounded %.2f digit for digit.
+    const bool negative = std::signbit(value);
+    const double scaled = std::fabs(static_cast<double>(value)) * 100.0;
+    constexpr double kMaxFastScaled = 9007199254740992.0;  // 2^53
+    if (scaled >= kMaxFastScaled) {
+        out.resize_and_overwrite(out.size() + 64, [base = out.size(), value](char* data, std::size_t size) {
+            const auto [ptr, ec] = std::to_chars(data + base, data + size, static_cast<double>(value), std::chars_format::fixed, 2);
+            return ec == std::errc{} ? static_cast<std::size_t>(ptr - data) : base;
+        });
+        return;
     }
+
+    double whole = std::floor(scaled);
+    const double fraction = scaled - whole;
+    if (fraction > 0.5 || (fraction == 0.5 && std::fmod(whole, 2.0) != 0.0)) {
+        whole += 1.0;
+    }
+    const auto hundredths = static_cast<std::uint64_t>(whole);
+    const auto integerPart = hundredths / 100;
+    const auto fractionPart = static_cast<unsigned>(hundredths % 100);
+
+    out.resize_and_overwrite(out.size() + 24, [base = out.size(), negative, integerPart, fractionPart](char* data, std::size_t size) {
+        char* cursor = data + base;
+        if (negative) {
+            *cursor++ = '-';
+        }
+        cursor = std::to_chars(cursor, data + size, integerPart).ptr;
+        *cursor++ = '.';
+        *cursor++ = static_cast<char>('0' + fractionPart / 10);
+        *cursor++ = static_cast<char>('0' + fractionPart % 10);
+        return static_cast<std::size_t>(cursor - data);
+    });
+}
+
+template <std::integral T>
+inline void AppendInteger(std::string& out, T value)
+{
+    out.resize_and_overwrite(out.size() + 24, [base = out.size(), value](char* data, std::size_t size) {
+        return static_cast<std::size_t>(std::to_chars(data + base, data + size, value).ptr - data);
+    });
 }
 
 }  // namespace TulliusWidgets::JsonUtils
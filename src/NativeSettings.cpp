@@ -0,0 +1,47 @@
+#include "NativeSettings.h"
+#include "JsonReader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+
+namespace TulliusWidgets::NativeSettings {
+
+bool ReadPerformanceSettings(std::string_view settingsJson, PerformanceSettings& settings) noexcept
+{
+    std::string_view performance;
+    const bool wellFormed = JsonUtils::ScanTopLevelFields(settingsJson, [&](const JsonUtils::JsonField& field) {
+        if (!field.keyEscaped && field.key == "performance" && field.kind == JsonUtils::JsonValueKind::kObject) {
+            performance = field.raw;
+        }
+    });
+    if (!wellFormed) return false;
+
+    std::optional<std::uint32_t> minIntervalMs;
+    std::optional<std::uint32_t> maxIntervalMs;
+    std::optional<std::uint32_t> taskBudgetUs;
+    if (!performance.empty()) {
+        (void)JsonUtils::ScanTopLevelFields(performance, [&](const JsonUtils::JsonField& field) {
+            if (field.keyEscaped) return;
+            if (field.key == "minUpdateIntervalMs") {
+                minIntervalMs = JsonUtils::ReadUInt32(field);
+            } else if (field.key == "maxUpdateIntervalMs") {
+                maxIntervalMs = JsonUtils::ReadUInt32(field);
+            } else if (field.key == "gameTaskBudgetUs") {
+                taskBudgetUs = JsonUtils::ReadUInt32(field);
+            }
+        });
+    }
+
+    using std::chrono::microseconds;
+    using std::chrono::milliseconds;
+    settings.updateRate = WidgetRuntime::ClampUpdateRateBounds(WidgetRuntime::UpdateRateBounds{
+        minIntervalMs ? milliseconds(*minIntervalMs) : WidgetRuntime::kDefaultMinUpdateInterval,
+        maxIntervalMs ? milliseconds(*maxIntervalMs) : WidgetRuntime::kDefaultMaxUpdateInterval });
+    settings.gameTaskBudget = taskBudgetUs
+        ? std::clamp(microseconds(*taskBudgetUs), kMinGameTaskBudget, kMaxGameTaskBudget)
+        : kDefaultGameTaskBudget;
+    return true;
+}
+
+}  // namespace TulliusWidgets::NativeSettings
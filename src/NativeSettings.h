@@ -0,0 +1,24 @@
+#pragma once
+
+#include "GameTaskQueue.h"
+#include "UpdateRateController.h"
+
+#include <chrono>
+#include <string_view>
+
+namespace TulliusWidgets::NativeSettings {
+
+// The part of the saved settings document the plugin itself acts on, from
+// its "performance" section; the view owns everything else.
+struct PerformanceSettings {
+    WidgetRuntime::UpdateRateBounds updateRate{};
+    std::chrono::microseconds gameTaskBudget{ kDefaultGameTaskBudget };
+};
+
+// Reads performance.minUpdateIntervalMs, performance.maxUpdateIntervalMs and
+// performance.gameTaskBudgetUs. Missing or invalid values fall back to the
+// defaults; present ones are clamped to their accepted range. Returns false
+// for malformed JSON and leaves `settings` as is.
+bool ReadPerformanceSettings(std::string_view settingsJson, PerformanceSettings& settings) noexcept;
+
+}  // namespace TulliusWidgets::NativeSettings
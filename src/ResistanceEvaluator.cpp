@@ -2,52 +2,13 @@
 
 #include <algorithm>
 #include <cmath>
-#include <limits>
 
 namespace TulliusWidgets {
-namespace {
 
-struct ResistanceLimits {
-    float min;
-    float max;
-    bool shouldClamp;
-};
-
-ResistanceLimits GetLimits(RE::ActorValue av) {
-    switch (av) {
-    case RE::ActorValue::kResistMagic:
-    case RE::ActorValue::kResistFire:
-    case RE::ActorValue::kResistFrost:
-    case RE::ActorValue::kResistShock:
-    case RE::ActorValue::kPoisonResist:
-        return { (std::numeric_limits<float>::lowest)(), 85.0f, true };
-    case RE::ActorValue::kResistDisease:
-        return { 0.0f, 100.0f, true };
-    default:
-        return { 0.0f, 0.0f, false };
-    }
-}
-
-}  // namespace
-
-ResistanceEvaluation ResistanceEvaluator::Evaluate(RE::PlayerCharacter* player, RE::ActorValue av) {
-    if (!player) {
-        return ResistanceEvaluation{ 0.0f, 0.0f, 0.0f, 0.0f, false };
-    }
-
-    float raw = player->AsActorValueOwner()->GetActorValue(av);
-    auto limits = GetLimits(av);
-    if (!limits.shouldClamp) {
-        return ResistanceEvaluation{ raw, raw, raw, raw, false };
-    }
-
-    float effective = std::clamp(raw, limits.min, limits.max);
+ResistanceEvaluation ResistanceEvaluator::Evaluate(float raw, float min, float cap) {
+    const float effective = std::clamp(raw, min, cap);
     const bool clamped = std::abs(effective - raw) > 0.001f;
-    return ResistanceEvaluation{ raw, effective, limits.min, limits.max, clamped };
-}
-
-float ResistanceEvaluator::GetEffectiveResistance(RE::PlayerCharacter* player, RE::ActorValue av) {
-    return Evaluate(player, av).effective;
+    return ResistanceEvaluation{ raw, effective, min, cap, clamped };
 }
 
 }  // namespace TulliusWidgets
@@ -12,8 +12,9 @@ struct ResistanceEvaluation {
 
 class ResistanceEvaluator {
 public:
-    static ResistanceEvaluation Evaluate(RE::PlayerCharacter* player, RE::ActorValue av);
-    static float GetEffectiveResistance(RE::PlayerCharacter* player, RE::ActorValue av);
+    // Clamps a resistance read from the player's actor values into the range
+    // the game applies; the limits come from ActorValueSnapshot.
+    static ResistanceEvaluation Evaluate(float raw, float min, float cap);
 };
 
 }  // namespace TulliusWidgets
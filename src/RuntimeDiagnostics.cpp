@@ -70,7 +70,7 @@ State Collect(const SKSE::LoadInterface* loadInterface)
     return state;
 }
 
-std::string BuildJson(const State& state)
+std::string BuildJson(const State& state, std::string_view performanceJson)
 {
     const bool hasRuntimeWarning = !state.runtimeSupported;
     const bool hasAddressWarning = !state.addressLibraryPresent;
@@ -90,7 +90,9 @@ std::string BuildJson(const State& state)
     json += "\"addressLibraryPresent\":" + std::string(state.addressLibraryPresent ? "true" : "false") + ",";
     json += "\"runtimeSupported\":" + std::string(state.runtimeSupported ? "true" : "false") + ",";
     json += "\"usesAddressLibrary\":true,";
-    json += "\"warningCode\":\"" + warningCode + "\"";
+    json += "\"warningCode\":\"" + warningCode + "\",";
+    json += "\"performance\":";
+    json += performanceJson;
     json += "}";
     return json;
 }
@@ -6,6 +6,7 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 namespace TulliusWidgets::RuntimeDiagnostics {
 
@@ -22,6 +23,8 @@ bool IsLikelySupportedRuntime(REL::Version runtimeVersion);
 std::filesystem::path ResolveGameRootPath();
 std::filesystem::path GetAddressLibraryPath(const std::filesystem::path& gameRootPath, REL::Version runtimeVersion);
 State Collect(const SKSE::LoadInterface* loadInterface);
-std::string BuildJson(const State& state);
+// `performanceJson` is a JSON object of collection counters, emitted as
+// "performance".
+std::string BuildJson(const State& state, std::string_view performanceJson);
 
 }  // namespace TulliusWidgets::RuntimeDiagnostics
@@ -0,0 +1,28 @@
+#include "StatsCaptureFrame.h"
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+void MergeCapturedSections(
+    const StatsCaptureFrame& frame,
+    StatsPayload& payload,
+    StatsScratch& strings,
+    StatsNameTable& names)
+{
+    const auto& captured = frame.payload;
+    payload.sequence = captured.sequence;
+    if (frame.raw.sections & kStatsSectionOffense) {
+        payload.offense = captured.offense;
+    }
+    if (frame.raw.sections & kStatsSectionEquipped) {
+        payload.equipped.rightHand = strings.Store(captured.equipped.rightHand);
+        payload.equipped.leftHand = strings.Store(captured.equipped.leftHand);
+        payload.equipped.rightHandNameId = names.Intern(payload.equipped.rightHand);
+        payload.equipped.leftHandNameId = names.Intern(payload.equipped.leftHand);
+    }
+    payload.time = captured.time;
+    payload.time.monthName = strings.Store(captured.time.monthName);
+    payload.playerInfo = captured.playerInfo;
+    payload.inCombat = captured.inCombat;
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
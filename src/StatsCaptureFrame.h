@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ActorValueSnapshot.h"
+#include "StatsNameTable.h"
+#include "StatsPayload.h"
+#include "StatsScratch.h"
+#include "TimedEffectTable.h"
+#include <chrono>
+#include <vector>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// One game-thread capture, handed to the stats worker through a
+// TripleBuffer. `payload` holds the engine-read fields: offense and
+// equipped when in raw.sections, and sequence, time, the non-vital
+// playerInfo fields and inCombat always. Names are text in `strings`; ids
+// are assigned on the worker, which owns the name table.
+struct StatsCaptureFrame {
+    std::chrono::steady_clock::time_point time{};
+    RawStatsCapture raw{};
+    StatsPayload payload{};
+    // Visible timed effects as of `time`, when raw.timedEffectsRefreshed.
+    // Every row carries its names: the worker may skip the frame that first
+    // showed an instance.
+    std::vector<TimedEffectRow> timedEffects{};
+    StatsScratch strings{};
+};
+
+// Copies the engine-read fields of `frame` into the dispatcher's capture
+// slot, storing names in `strings` and interning them in `names`.
+void MergeCapturedSections(
+    const StatsCaptureFrame& frame,
+    StatsPayload& payload,
+    StatsScratch& strings,
+    StatsNameTable& names);
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
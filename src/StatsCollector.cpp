@@ -1,27 +1,88 @@
 #include "StatsCollector.h"
-#include "StatsJsonWriter.h"
+#include "ActorValueSnapshot.h"
+#include "EvaluationMemo.h"
+#include "GameSettings.h"
+#include "InventoryIndex.h"
+#include "StatsDiagnostics.h"
+#include "StatsCaptureFrame.h"
+#include "StatsDispatcher.h"
+#include "StatsNameTable.h"
 #include "StatsPayload.h"
+#include "StatsPayloadSchema.h"
+#include "StatsScratch.h"
+#include "TimedEffectTable.h"
+#include "TripleBuffer.h"
 #include "RE/C/Calendar.h"
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cmath>
+#include <mutex>
+#include <string>
 #include <string_view>
-#include <utility>
+#include <vector>
 
 namespace TulliusWidgets::StatsCollectorInternal {
 
 std::atomic<std::uint32_t> gStatsPayloadSequence{0};
+// Advanced whenever offense inputs that memoized evaluations cannot compare
+// (perks, active effects) may have changed.
+std::atomic<std::uint32_t> gOffenseInputsEpoch{0};
+
+// Captures run on the game thread and build on the stats worker; the frame
+// buffer is the only thing they share besides the dispatcher's thread-safe
+// members. The dispatcher otherwise belongs to the thread that builds.
+struct StatsDispatchState {
+    StatsDispatcher dispatcher;
+    TripleBuffer<StatsCaptureFrame> frames;
+    // Ordered from the frames' rows; belongs to the thread that builds.
+    TimedEffectTable timedEffects;
+};
+
+StatsDispatchState gStatsDispatchState;
+
+struct InventoryIndexState {
+    std::mutex mutex;
+    InventoryIndex index;
+};
+
+InventoryIndexState gInventoryIndexState;
+
+// Captures read it; effect-removed events and game loads edit it.
+struct TimedEffectSourceState {
+    std::mutex mutex;
+    TimedEffectSources sources;
+};
+
+TimedEffectSourceState gTimedEffectSourceState;
+
+// Inputs of PlayerCharacter::GetDamage (and the rest of the weapon formula)
+// that can be compared cheaply; perks and effects are covered by the epoch.
+// The entry pointer changes on equip; the form id guards against reuse.
+struct HandStatsKey {
+    const RE::InventoryEntryData* entry{ nullptr };
+    RE::FormID weapon{ 0 };
+    float temperLevel{ 1.0f };
+    float weaponSkill{ 0.0f };
+    float attackDamageMult{ 0.0f };
+    std::uint32_t inputsEpoch{ 0 };
+
+    bool operator==(const HandStatsKey&) const = default;
+};
+
+// Per-hand values derived from the equipped weapon. Further weapon stats
+// (reach, speed, stagger) belong here so they share the key.
+struct HandStats {
+    float damage{ 0.0f };
+};
+
+// Right hand, then left; only touched by captures, on the game thread.
+std::array<EvaluationMemo<HandStatsKey, HandStats>, 2> gHandStatsMemos;
 
 static float ComputeLevelThreshold(std::int32_t level)
 {
-    float base = 75.0f;
-    float mult = 25.0f;
-    auto* gs = RE::GameSettingCollection::GetSingleton();
-    if (gs) {
-        if (auto* s = gs->GetSetting("fXPLevelUpBase")) base = s->data.f;
-        if (auto* s = gs->GetSetting("fXPLevelUpMult")) mult = s->data.f;
-    }
-    return base + mult * static_cast<float>(level);
+    return GameSettings::XPLevelUpBase() + GameSettings::XPLevelUpMult() * static_cast<float>(level);
 }
 
 static RE::TESForm* GetEquippedForm(RE::PlayerCharacter* player, bool leftHand)
@@ -47,9 +108,9 @@ static RE::TESForm* GetEquippedForm(RE::PlayerCharacter* player, bool leftHand)
     return nullptr;
 }
 
-static std::string GetEquippedName(RE::PlayerCharacter* player, bool leftHand)
+static std::string_view GetEquippedName(RE::PlayerCharacter* player, bool leftHand)
 {
-    if (!player) return "";
+    if (!player) return {};
     if (auto* entry = player->GetEquippedEntryData(leftHand)) {
         if (const char* displayName = entry->GetDisplayName(); displayName && displayName[0] != '\0') {
             return displayName;
@@ -62,27 +123,27 @@ static std::string GetEquippedName(RE::PlayerCharacter* player, bool leftHand)
     }
 
     auto* equipped = GetEquippedForm(player, leftHand);
-    if (!equipped) return "";
+    if (!equipped) return {};
 
     if (const auto* weapon = equipped->As<RE::TESObjectWEAP>()) {
         const char* name = weapon->GetName();
-        return name ? name : "";
+        return name ? name : std::string_view{};
     }
     if (const auto* spell = equipped->As<RE::SpellItem>()) {
         const char* name = spell->GetName();
-        return name ? name : "";
+        return name ? name : std::string_view{};
     }
     if (const auto* scroll = equipped->As<RE::ScrollItem>()) {
         const char* name = scroll->GetName();
-        return name ? name : "";
+        return name ? name : std::string_view{};
     }
     if (const auto* armor = equipped->As<RE::TESObjectARMO>()) {
         const char* name = armor->GetName();
-        return name ? name : "";
+        return name ? name : std::string_view{};
     }
 
     const char* name = equipped->GetName();
-    return name ? name : "";
+    return name ? name : std::string_view{};
 }
 
 static bool ShouldDisplayActiveEffect(const RE::ActiveEffect* effect)
@@ -101,14 +162,14 @@ static bool ShouldDisplayActiveEffect(const RE::ActiveEffect* effect)
     return true;
 }
 
-static std::string GetFormName(const RE::TESForm* form)
+static std::string_view GetFormName(const RE::TESForm* form)
 {
-    if (!form) return "";
+    if (!form) return {};
     const char* name = form->GetName();
     if (name && name[0] != '\0') {
         return name;
     }
-    return "";
+    return {};
 }
 
 static std::uint32_t GetFormId(const RE::TESForm* form)
@@ -116,9 +177,9 @@ static std::uint32_t GetFormId(const RE::TESForm* form)
     return form ? static_cast<std::uint32_t>(form->GetFormID()) : 0u;
 }
 
-static std::string GetTimedEffectName(const RE::ActiveEffect* effect)
+static std::string_view GetTimedEffectName(const RE::ActiveEffect* effect)
 {
-    if (!effect) return "";
+    if (!effect) return {};
 
     if (const auto* baseEffect = effect->GetBaseObject()) {
         if (const char* fullName = baseEffect->GetFullName(); fullName && fullName[0] != '\0') {
@@ -136,12 +197,12 @@ static std::string GetTimedEffectName(const RE::ActiveEffect* effect)
         }
     }
 
-    return "";
+    return {};
 }
 
-static std::string GetTimedEffectSourceName(const RE::ActiveEffect* effect, std::string_view effectName)
+static std::string_view GetTimedEffectSourceName(const RE::ActiveEffect* effect, std::string_view effectName)
 {
-    if (!effect) return "";
+    if (!effect) return {};
 
     if (effect->spell) {
         auto spellName = GetFormName(effect->spell);
@@ -157,23 +218,34 @@ static std::string GetTimedEffectSourceName(const RE::ActiveEffect* effect, std:
         }
     }
 
-    return "";
+    return {};
 }
 
-static std::vector<TimedEffectEntry> CollectTimedEffects(RE::PlayerCharacter* player)
+// Copies the countdown of every shown effect into `rows`, with names stored
+// in `strings`; false when there was nothing to read (the list is then sent
+// empty). EmitTimedEffects orders and copies the result out on the stats
+// worker.
+static bool RefreshTimedEffects(
+    RE::PlayerCharacter* player,
+    std::vector<TimedEffectRow>& rows,
+    StatsScratch& strings)
 {
-    std::vector<TimedEffectEntry> out;
-    if (!player) return out;
+    rows.clear();
+    if (!player) return false;
 
     auto* magicTarget = player->AsMagicTarget();
-    if (!magicTarget) return out;
+    if (!magicTarget) return false;
 
     auto* ui = RE::UI::GetSingleton();
-    if (!ui || ui->GameIsPaused()) return out;
+    if (!ui || ui->GameIsPaused()) return false;
 
     auto* activeEffects = magicTarget->GetActiveEffectList();
-    if (!activeEffects) return out;
+    if (!activeEffects) return false;
 
+    auto& state = gTimedEffectSourceState;
+    std::scoped_lock lock(state.mutex);
+    auto& sources = state.sources;
+    sources.BeginPass();
     for (auto* effect : *activeEffects) {
         if (!ShouldDisplayActiveEffect(effect)) {
             continue;
@@ -184,44 +256,49 @@ static std::vector<TimedEffectEntry> CollectTimedEffects(RE::PlayerCharacter* pl
             continue;
         }
 
-        auto effectName = GetTimedEffectName(effect);
-        auto sourceName = GetTimedEffectSourceName(effect, effectName);
-        if (sourceName.empty() && effectName.empty()) {
-            continue;
+        const auto instanceId = static_cast<std::int32_t>(effect->usUniqueID);
+        const auto* info = sources.Find(instanceId);
+        if (!info) {
+            // First sighting of this instance: resolve names and form ids once.
+            const auto* baseEffect = effect->GetBaseObject();
+            const auto effectName = GetTimedEffectName(effect);
+            info = &sources.Insert(TimedEffectInfo{
+                instanceId,
+                GetTimedEffectSourceName(effect, effectName),
+                effectName,
+                baseEffect && (baseEffect->IsDetrimental() || baseEffect->IsHostile()),
+                GetFormId(effect->source),
+                GetFormId(baseEffect),
+                GetFormId(effect->spell)
+            });
         }
-        if (sourceName.empty()) sourceName = effectName;
-        if (effectName.empty()) effectName = sourceName;
-
-        const auto* baseEffect = effect->GetBaseObject();
-        const bool isDebuff = baseEffect && (baseEffect->IsDetrimental() || baseEffect->IsHostile());
-        out.push_back(TimedEffectEntry{
-            static_cast<std::int32_t>(effect->usUniqueID),
-            std::move(sourceName),
-            std::move(effectName),
-            static_cast<std::int32_t>(std::ceil((std::max)(remaining, 0.0f))),
-            static_cast<std::int32_t>(std::ceil((std::max)(effect->duration, 0.0f))),
-            isDebuff,
-            GetFormId(effect->source),
-            GetFormId(baseEffect),
-            GetFormId(effect->spell)
-        });
+
+        auto& row = rows.emplace_back();
+        row.info = *info;
+        row.info.sourceName = strings.Store(info->sourceName);
+        row.info.effectName = strings.Store(info->effectName);
+        row.remainingSec = static_cast<std::int32_t>(std::ceil((std::max)(remaining, 0.0f)));
+        row.totalSec = static_cast<std::int32_t>(std::ceil((std::max)(effect->duration, 0.0f)));
     }
+    sources.EndPass();
+    return true;
+}
 
-    std::sort(out.begin(), out.end(), [](const TimedEffectEntry& a, const TimedEffectEntry& b) {
-        if (a.remainingSec != b.remainingSec) return a.remainingSec < b.remainingSec;
-        if (a.isDebuff != b.isDebuff) return a.isDebuff && !b.isDebuff;
-        if (a.sourceName != b.sourceName) return a.sourceName < b.sourceName;
-        if (a.effectName != b.effectName) return a.effectName < b.effectName;
-        if (a.effectFormId != b.effectFormId) return a.effectFormId < b.effectFormId;
-        if (a.sourceFormId != b.sourceFormId) return a.sourceFormId < b.sourceFormId;
-        if (a.spellFormId != b.spellFormId) return a.spellFormId < b.spellFormId;
-        return a.instanceId < b.instanceId;
-    });
+static void EmitTimedEffects(
+    const StatsCaptureFrame& frame,
+    std::vector<TimedEffectEntry>& out,
+    StatsScratch& strings,
+    StatsNameTable& names)
+{
+    out.clear();
+    if (!frame.raw.timedEffectsRefreshed) return;
 
-    return out;
+    auto& table = gStatsDispatchState.timedEffects;
+    table.Apply(frame.timedEffects);
+    table.Emit(out, strings, names);
 }
 
-static GameTimeEntry CollectGameTime()
+static GameTimeEntry CollectGameTime(StatsScratch& strings)
 {
     GameTimeEntry out{
         201,
@@ -238,7 +315,9 @@ static GameTimeEntry CollectGameTime()
 
     out.year = (std::max)(calendar->GetYear(), 1u);
     out.month = (std::min)(calendar->GetMonth(), static_cast<std::uint32_t>(RE::Calendar::Month::kEveningStar));
-    out.monthName = calendar->GetMonthName();
+    // Month names are short enough for the small-string buffer, so the
+    // temporary does not allocate.
+    out.monthName = strings.Store(calendar->GetMonthName());
     if (out.monthName.empty()) {
         out.monthName = "Unknown";
     }
@@ -266,111 +345,205 @@ static GameTimeEntry CollectGameTime()
     return out;
 }
 
-static float GetArmorRating(RE::PlayerCharacter* player)
+struct PlayerValueRead {
+    PlayerValue slot;
+    RE::ActorValue av;
+    bool damageModifier;
+    // Sections derived from the value; it is only read when one of them is
+    // being collected.
+    std::uint32_t sections;
+};
+
+static constexpr std::uint32_t kVitalsSections = kStatsSectionPlayerInfo | kStatsSectionAlertData;
+
+static constexpr std::array kPlayerValueReads{
+    PlayerValueRead{ PlayerValue::kHealth, RE::ActorValue::kHealth, false, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kMagicka, RE::ActorValue::kMagicka, false, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kStamina, RE::ActorValue::kStamina, false, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kHealthDamage, RE::ActorValue::kHealth, true, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kMagickaDamage, RE::ActorValue::kMagicka, true, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kStaminaDamage, RE::ActorValue::kStamina, true, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kInventoryWeight, RE::ActorValue::kInventoryWeight, false, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kCarryWeight, RE::ActorValue::kCarryWeight, false, kVitalsSections },
+    PlayerValueRead{ PlayerValue::kSpeedMult, RE::ActorValue::kSpeedMult, false, kStatsSectionMovement },
+    PlayerValueRead{ PlayerValue::kDamageResist, RE::ActorValue::kDamageResist, false, kStatsSectionDefense },
+    PlayerValueRead{ PlayerValue::kResistMagic, RE::ActorValue::kResistMagic, false, kStatsSectionResistances },
+    PlayerValueRead{ PlayerValue::kResistFire, RE::ActorValue::kResistFire, false, kStatsSectionResistances },
+    PlayerValueRead{ PlayerValue::kResistFrost, RE::ActorValue::kResistFrost, false, kStatsSectionResistances },
+    PlayerValueRead{ PlayerValue::kResistShock, RE::ActorValue::kResistShock, false, kStatsSectionResistances },
+    PlayerValueRead{ PlayerValue::kPoisonResist, RE::ActorValue::kPoisonResist, false, kStatsSectionResistances },
+    PlayerValueRead{ PlayerValue::kResistDisease, RE::ActorValue::kResistDisease, false, kStatsSectionResistances },
+    PlayerValueRead{ PlayerValue::kCriticalChance, RE::ActorValue::kCriticalChance, false, kStatsSectionOffense },
+    PlayerValueRead{ PlayerValue::kOneHanded, RE::ActorValue::kOneHanded, false, kStatsSectionOffense },
+    PlayerValueRead{ PlayerValue::kTwoHanded, RE::ActorValue::kTwoHanded, false, kStatsSectionOffense },
+    PlayerValueRead{ PlayerValue::kArchery, RE::ActorValue::kArchery, false, kStatsSectionOffense },
+    PlayerValueRead{ PlayerValue::kAttackDamageMult, RE::ActorValue::kAttackDamageMult, false, kStatsSectionOffense },
+};
+static_assert(kPlayerValueReads.size() == kPlayerValueCount);
+
+// The only place the collector reads actor values; values for sections not
+// being collected stay 0.
+static ActorValueSnapshot ReadActorValueSnapshot(RE::PlayerCharacter* player, std::uint32_t sections)
+{
+    ActorValueSnapshot snapshot{};
+    if (!player) return snapshot;
+
+    auto* owner = player->AsActorValueOwner();
+    for (const auto& read : kPlayerValueReads) {
+        if (!(read.sections & sections)) continue;
+        snapshot[read.slot] = read.damageModifier
+            ? player->GetActorValueModifier(RE::ACTOR_VALUE_MODIFIER::kDamage, read.av)
+            : owner->GetActorValue(read.av);
+    }
+    return snapshot;
+}
+
+static StatLimits ResolveStatLimits()
 {
-    if (!player) return 0.0f;
-    return player->AsActorValueOwner()->GetActorValue(RE::ActorValue::kDamageResist);
+    return StatLimits{
+        GameSettings::PlayerMaxResistance(),
+        GameSettings::ArmorScalingFactor(),
+        GameSettings::MaxArmorRating()
+    };
 }
 
-static float CalculateRawDamageReduction(float armorRating)
+// Restore potions only: fortify and regenerate effects use other archetypes.
+static InventoryCategory ClassifyPotion(const RE::AlchemyItem* potion)
 {
-    return armorRating * kArmorRatingMultiplier;
+    if (!potion || potion->IsFood() || potion->IsPoison()) return InventoryCategory::kUntracked;
+
+    const auto* effect = potion->GetCostliestEffectItem();
+    const auto* baseEffect = effect ? effect->baseEffect : nullptr;
+    if (!baseEffect || baseEffect->IsDetrimental()) return InventoryCategory::kUntracked;
+    if (baseEffect->GetArchetype() != RE::EffectSetting::Archetype::kValueModifier) return InventoryCategory::kUntracked;
+
+    switch (baseEffect->data.primaryAV) {
+    case RE::ActorValue::kHealth:
+        return InventoryCategory::kHealthPotion;
+    case RE::ActorValue::kMagicka:
+        return InventoryCategory::kMagickaPotion;
+    case RE::ActorValue::kStamina:
+        return InventoryCategory::kStaminaPotion;
+    default:
+        return InventoryCategory::kUntracked;
+    }
 }
 
-static float CalculateDamageReduction(float armorRating)
+static InventoryCategory ClassifyInventoryItem(const RE::TESBoundObject* object)
 {
-    return (std::min)(CalculateRawDamageReduction(armorRating), kDamageReductionCap);
+    if (!object) return InventoryCategory::kUntracked;
+    if (object->GetFormID() == kGoldFormId) return InventoryCategory::kGold;
+    if (object->IsAmmo()) return InventoryCategory::kAmmo;
+    return ClassifyPotion(object->As<RE::AlchemyItem>());
 }
 
-static std::int32_t GetGoldCount(RE::PlayerCharacter* player)
+// Walks the whole inventory once per load (or reset); container-change
+// events keep the counts current afterwards.
+static void SeedInventoryIndex(RE::PlayerCharacter* player, InventoryIndex& index)
 {
-    if (!player) return 0;
-    auto gold = RE::TESForm::LookupByID<RE::TESBoundObject>(0x0000000F);
-    if (!gold) return 0;
-    return player->GetItemCount(gold);
+    index.Reset();
+    for (const auto& [object, count] : player->GetInventoryCounts()) {
+        if (object) {
+            index.Add(static_cast<std::uint32_t>(object->GetFormID()), ClassifyInventoryItem(object), count);
+        }
+    }
+    index.MarkSeeded();
 }
 
-static float CollectHandDamage(RE::PlayerCharacter* player, bool leftHand)
+static InventoryCountsSnapshot CollectInventoryCounts(RE::PlayerCharacter* player)
 {
-    if (!player) return 0.0f;
+    InventoryCountsSnapshot counts{};
+    if (!player) return counts;
 
-    float damage = 0.0f;
-    if (auto* entry = player->GetEquippedEntryData(leftHand)) {
-        if (entry->object && entry->object->As<RE::TESObjectWEAP>()) {
-            damage = player->GetDamage(entry);
-        }
+    auto& state = gInventoryIndexState;
+    std::scoped_lock lock(state.mutex);
+    if (!state.index.IsSeeded()) {
+        SeedInventoryIndex(player, state.index);
     }
 
-    return std::clamp(damage, kDisplayedDamageMin, kDisplayedDamageMax);
+    counts.gold = state.index.Total(InventoryCategory::kGold);
+    if (const auto* ammo = player->GetCurrentAmmo()) {
+        counts.ammo = state.index.Count(static_cast<std::uint32_t>(ammo->GetFormID()));
+    }
+    counts.healthPotions = state.index.Total(InventoryCategory::kHealthPotion);
+    counts.magickaPotions = state.index.Total(InventoryCategory::kMagickaPotion);
+    counts.staminaPotions = state.index.Total(InventoryCategory::kStaminaPotion);
+    return counts;
 }
 
-static ResistanceSnapshot CollectResistanceSnapshot(RE::PlayerCharacter* player)
+static PlayerValue WeaponSkillValue(const RE::TESObjectWEAP* weapon)
 {
-    ResistanceSnapshot snapshot{};
-    snapshot.magic = ResistanceEvaluator::Evaluate(player, RE::ActorValue::kResistMagic);
-    snapshot.fire = ResistanceEvaluator::Evaluate(player, RE::ActorValue::kResistFire);
-    snapshot.frost = ResistanceEvaluator::Evaluate(player, RE::ActorValue::kResistFrost);
-    snapshot.shock = ResistanceEvaluator::Evaluate(player, RE::ActorValue::kResistShock);
-    snapshot.poison = ResistanceEvaluator::Evaluate(player, RE::ActorValue::kPoisonResist);
-    snapshot.disease = ResistanceEvaluator::Evaluate(player, RE::ActorValue::kResistDisease);
-    snapshot.anyClamped =
-        snapshot.magic.clamped || snapshot.fire.clamped || snapshot.frost.clamped ||
-        snapshot.shock.clamped || snapshot.poison.clamped || snapshot.disease.clamped;
-    return snapshot;
+    switch (weapon->weaponData.skill.get()) {
+    case RE::ActorValue::kOneHanded:
+        return PlayerValue::kOneHanded;
+    case RE::ActorValue::kTwoHanded:
+        return PlayerValue::kTwoHanded;
+    default:
+        // Bows and crossbows; staves deal no weapon damage.
+        return PlayerValue::kArchery;
+    }
+}
+
+// Smithing improvement of the entry, 1.0 when untempered.
+static float GetTemperLevel(const RE::InventoryEntryData* entry)
+{
+    if (!entry->extraLists) return 1.0f;
+    for (auto* extraList : *entry->extraLists) {
+        if (const auto* health = extraList ? extraList->GetByType<RE::ExtraHealth>() : nullptr) {
+            return health->health;
+        }
+    }
+    return 1.0f;
 }
 
-static DefenseSnapshot CollectDefenseSnapshot(RE::PlayerCharacter* player)
+static HandStats CollectHandStats(RE::PlayerCharacter* player, bool leftHand, const ActorValueSnapshot& values)
 {
-    const float armorRating = GetArmorRating(player);
-    const float rawDamageReduction = CalculateRawDamageReduction(armorRating);
-    return DefenseSnapshot{
-        armorRating,
-        rawDamageReduction,
-        CalculateDamageReduction(armorRating),
-        rawDamageReduction > kDamageReductionCap + 0.001f
+    if (!player) return {};
+
+    auto* entry = player->GetEquippedEntryData(leftHand);
+    const auto* weapon = entry && entry->object ? entry->object->As<RE::TESObjectWEAP>() : nullptr;
+    if (!weapon) return {};
+
+    const HandStatsKey key{
+        entry,
+        weapon->GetFormID(),
+        GetTemperLevel(entry),
+        values[WeaponSkillValue(weapon)],
+        values[PlayerValue::kAttackDamageMult],
+        gOffenseInputsEpoch.load(std::memory_order_acquire)
     };
+    return gHandStatsMemos[leftHand ? 1 : 0].Get(key, [player, entry]() {
+        return HandStats{ std::clamp(player->GetDamage(entry), kDisplayedDamageMin, kDisplayedDamageMax) };
+    });
 }
 
-static OffenseSnapshot CollectOffenseSnapshot(RE::PlayerCharacter* player)
+static OffenseSnapshot CollectOffenseSnapshot(RE::PlayerCharacter* player, const ActorValueSnapshot& values)
 {
     OffenseSnapshot snapshot{};
-    snapshot.rightHandDamage = CollectHandDamage(player, false);
-    snapshot.leftHandDamage = CollectHandDamage(player, true);
-    snapshot.critChance = CriticalChanceEvaluator::Evaluate(player);
+    snapshot.rightHandDamage = CollectHandStats(player, false, values).damage;
+    snapshot.leftHandDamage = CollectHandStats(player, true, values).damage;
+    snapshot.critChance = CriticalChanceEvaluator::Evaluate(
+        player,
+        values[PlayerValue::kCriticalChance],
+        gOffenseInputsEpoch.load(std::memory_order_acquire));
     return snapshot;
 }
 
-static EquippedSnapshot CollectEquippedSnapshot(RE::PlayerCharacter* player)
+// Name ids are assigned when the worker merges the capture.
+static EquippedSnapshot CollectEquippedSnapshot(RE::PlayerCharacter* player, StatsScratch& strings)
 {
     return EquippedSnapshot{
-        GetEquippedName(player, false),
-        GetEquippedName(player, true)
+        strings.Store(GetEquippedName(player, false)),
+        strings.Store(GetEquippedName(player, true))
     };
 }
 
-static MovementSnapshot CollectMovementSnapshot(RE::PlayerCharacter* player)
+// Vitals and carry weight are left at 0; DeriveStatsSections fills them
+// from the actor-value snapshot.
+static PlayerInfoSnapshot CollectPlayerInfo(RE::PlayerCharacter* player)
 {
     if (!player) return {};
-    return MovementSnapshot{
-        player->AsActorValueOwner()->GetActorValue(RE::ActorValue::kSpeedMult)
-    };
-}
-
-static PlayerStateSnapshot CollectPlayerStateSnapshot(RE::PlayerCharacter* player)
-{
-    PlayerStateSnapshot snapshot{};
-    if (!player) return snapshot;
 
-    auto* av = player->AsActorValueOwner();
-    const float maxHP = av->GetActorValue(RE::ActorValue::kHealth);
-    const float maxMP = av->GetActorValue(RE::ActorValue::kMagicka);
-    const float maxSP = av->GetActorValue(RE::ActorValue::kStamina);
-    const float dmgHP = player->GetActorValueModifier(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kHealth);
-    const float dmgMP = player->GetActorValueModifier(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kMagicka);
-    const float dmgSP = player->GetActorValueModifier(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kStamina);
-    const float curHP = (std::max)(maxHP + dmgHP, 0.0f);
-    const float curMP = (std::max)(maxMP + dmgMP, 0.0f);
-    const float curSP = (std::max)(maxSP + dmgSP, 0.0f);
     const std::int32_t currentLevel = static_cast<std::int32_t>(player->GetLevel());
     float experience = 0.0f;
     float expToNextLevel = 0.0f;
@@ -411,71 +584,225 @@ static PlayerStateSnapshot CollectPlayerStateSnapshot(RE::PlayerCharacter* playe
     }
 
     const float expectedLevelThreshold = ComputeLevelThreshold(currentLevel);
-    const float carryCur = av->GetActorValue(RE::ActorValue::kInventoryWeight);
-    const float carryMax = av->GetActorValue(RE::ActorValue::kCarryWeight);
+    const auto inventory = CollectInventoryCounts(player);
 
-    snapshot.playerInfo = PlayerInfoSnapshot{
+    return PlayerInfoSnapshot{
         currentLevel,
         experience,
         expToNextLevel,
         nextLevelTotalXp,
         expectedLevelThreshold,
-        GetGoldCount(player),
-        carryCur,
-        carryMax,
-        curHP,
-        curMP,
-        curSP
-    };
-    snapshot.alertData = AlertDataSnapshot{
-        maxHP > 0 ? (curHP / maxHP) * 100.0f : 100.0f,
-        maxMP > 0 ? (curMP / maxMP) * 100.0f : 100.0f,
-        maxSP > 0 ? (curSP / maxSP) * 100.0f : 100.0f,
-        carryMax > 0 ? (carryCur / carryMax) * 100.0f : 0.0f
+        inventory.gold,
+        0.0f,
+        0.0f,
+        0.0f,
+        0.0f,
+        0.0f,
+        inventory.ammo,
+        inventory.healthPotions,
+        inventory.magickaPotions,
+        inventory.staminaPotions
     };
-    return snapshot;
 }
 
-StatsPayload CollectStatsPayload(RE::PlayerCharacter* player)
+template <class Collect>
+static void TimedStage(CollectionStage stage, Collect&& collect)
+{
+    ScopedStageTimer timer(stage);
+    collect();
+}
+
+void CaptureStatsPayload(RE::PlayerCharacter* player, StatsCaptureFrame& frame, std::uint32_t sections)
 {
-    StatsPayload payload{};
+    auto& payload = frame.payload;
+    auto& strings = frame.strings;
+    auto& raw = frame.raw;
+    strings.Reset();
     payload.sequence = gStatsPayloadSequence.fetch_add(1, std::memory_order_relaxed) + 1;
-    payload.resistances = CollectResistanceSnapshot(player);
-    payload.defense = CollectDefenseSnapshot(player);
-    payload.offense = CollectOffenseSnapshot(player);
-    payload.equipped = CollectEquippedSnapshot(player);
-    payload.movement = CollectMovementSnapshot(player);
-    payload.time = CollectGameTime();
-    const auto playerState = CollectPlayerStateSnapshot(player);
-    payload.playerInfo = playerState.playerInfo;
-    payload.alertData = playerState.alertData;
-    payload.timedEffects = CollectTimedEffects(player);
-    payload.inCombat = player && player->IsInCombat();
-    return payload;
+    raw.sections = sections;
+    TimedStage(CollectionStage::kActorValues, [&] {
+        raw.values = ReadActorValueSnapshot(player, sections | kVitalsSections | kStatsSectionMovement);
+        raw.limits = ResolveStatLimits();
+    });
+    if (sections & kStatsSectionOffense) {
+        TimedStage(CollectionStage::kOffense, [&] { payload.offense = CollectOffenseSnapshot(player, raw.values); });
+    }
+    if (sections & kStatsSectionEquipped) {
+        TimedStage(CollectionStage::kEquipped, [&] { payload.equipped = CollectEquippedSnapshot(player, strings); });
+    }
+    TimedStage(CollectionStage::kTime, [&] { payload.time = CollectGameTime(strings); });
+    TimedStage(CollectionStage::kPlayerInfo, [&] { payload.playerInfo = CollectPlayerInfo(player); });
+    TimedStage(CollectionStage::kTimedEffects, [&] {
+        raw.timedEffectsRefreshed = RefreshTimedEffects(player, frame.timedEffects, strings);
+        raw.timedEffectCount = static_cast<std::uint32_t>(frame.timedEffects.size());
+    });
+    TimedStage(CollectionStage::kCombat, [&] { payload.inCombat = player && player->IsInCombat(); });
+}
+
+void FinishStatsPayload(const StatsCaptureFrame& frame, StatsPayload& payload, StatsScratch& strings, StatsNameTable& names)
+{
+    ScopedStageTimer timer(CollectionStage::kDerive);
+    MergeCapturedSections(frame, payload, strings, names);
+    DeriveStatsSections(frame.raw, payload);
+    EmitTimedEffects(frame, payload.timedEffects, strings, names);
 }
 
 }  // namespace TulliusWidgets::StatsCollectorInternal
 
 namespace TulliusWidgets {
 
-std::string StatsCollector::CollectStats()
+bool StatsCollector::CaptureStats(WidgetRuntime::UpdateRateSample& rateSample)
 {
     try {
         auto* player = RE::PlayerCharacter::GetSingleton();
         if (!player) {
-            return "{}";
+            return false;
+        }
+
+        auto& state = StatsCollectorInternal::gStatsDispatchState;
+        auto& frame = state.frames.WriteSlot();
+        frame.time = std::chrono::steady_clock::now();
+        const auto sections = state.dispatcher.SectionsDue(frame.time);
+        // Full captures are the periodic sweep for changes no event reported;
+        // memoized evaluations are redone with them.
+        if (sections == StatsCollectorInternal::kStatsSectionAll) {
+            StatsCollectorInternal::gOffenseInputsEpoch.fetch_add(1, std::memory_order_acq_rel);
         }
+        StatsCollectorInternal::CaptureStatsPayload(player, frame, sections);
+        const auto percents = StatsCollectorInternal::DeriveVitals(frame.raw.values).alertData;
+        rateSample = WidgetRuntime::UpdateRateSample{
+            percents.healthPct,
+            percents.magickaPct,
+            percents.staminaPct,
+            percents.carryPct,
+            frame.raw.timedEffectCount,
+            frame.payload.inCombat
+        };
+        state.frames.Publish();
+        return true;
+    } catch (const std::exception& e) {
+        logger::error("CaptureStats exception: {}", e.what());
+        return false;
+    } catch (...) {
+        logger::error("CaptureStats unknown exception");
+        return false;
+    }
+}
 
-        const auto payload = StatsCollectorInternal::CollectStatsPayload(player);
-        StatsCollectorInternal::StatsJsonWriter writer;
-        return writer.Build(payload);
+bool StatsCollector::BuildStatsJson(std::string_view& json)
+{
+    try {
+        auto& state = StatsCollectorInternal::gStatsDispatchState;
+        if (!state.frames.Acquire()) {
+            return false;
+        }
+        const auto& frame = state.frames.ReadSlot();
+        const auto capture = state.dispatcher.BeginCapture(frame.time, frame.raw.sections);
+        StatsCollectorInternal::FinishStatsPayload(frame, capture.payload, capture.strings, capture.names);
+        StatsCollectorInternal::ScopedStageTimer timer(StatsCollectorInternal::CollectionStage::kBuild);
+        json = state.dispatcher.Commit(frame.time);
+        return true;
     } catch (const std::exception& e) {
-        logger::error("CollectStats exception: {}", e.what());
-        return "{}";
+        logger::error("BuildStatsJson exception: {}", e.what());
+        json = "{}";
+        return true;
     } catch (...) {
-        logger::error("CollectStats unknown exception");
-        return "{}";
+        logger::error("BuildStatsJson unknown exception");
+        json = "{}";
+        return true;
+    }
+}
+
+void StatsCollector::RequestKeyframe()
+{
+    StatsCollectorInternal::gStatsDispatchState.dispatcher.RequestKeyframe();
+}
+
+void StatsCollector::MarkSectionsDirty(std::uint32_t sections)
+{
+    if (sections & StatsCollectorInternal::kStatsSectionOffense) {
+        StatsCollectorInternal::gOffenseInputsEpoch.fetch_add(1, std::memory_order_acq_rel);
+    }
+    StatsCollectorInternal::gStatsDispatchState.dispatcher.MarkSectionsDirty(sections, std::chrono::steady_clock::now());
+}
+
+void StatsCollector::ResetNameTable()
+{
+    StatsCollectorInternal::gStatsDispatchState.dispatcher.RequestNameTableReset();
+}
+
+void StatsCollector::ResetInventoryIndex()
+{
+    auto& state = StatsCollectorInternal::gInventoryIndexState;
+    std::scoped_lock lock(state.mutex);
+    state.index.Reset();
+}
+
+void StatsCollector::NoteInventoryChange(std::uint32_t baseFormId, std::int32_t delta)
+{
+    if (baseFormId == 0 || delta == 0) return;
+
+    using namespace StatsCollectorInternal;
+    auto& state = gInventoryIndexState;
+    std::scoped_lock lock(state.mutex);
+    // Until the index is seeded, the seeding walk picks the change up.
+    if (!state.index.IsSeeded()) return;
+
+    if (const auto* category = state.index.FindCategory(baseFormId)) {
+        state.index.Add(baseFormId, *category, delta);
+        return;
     }
+    const auto* object = RE::TESForm::LookupByID<RE::TESBoundObject>(baseFormId);
+    state.index.Add(baseFormId, ClassifyInventoryItem(object), delta);
+}
+
+void StatsCollector::NoteTimedEffectRemoved(std::uint32_t instanceId)
+{
+    // The next sighting of the id resolves anew under a new serial, which
+    // replaces the worker's entry.
+    auto& state = StatsCollectorInternal::gTimedEffectSourceState;
+    std::scoped_lock lock(state.mutex);
+    state.sources.Remove(static_cast<std::int32_t>(instanceId));
+}
+
+void StatsCollector::ResetTimedEffects()
+{
+    auto& state = StatsCollectorInternal::gTimedEffectSourceState;
+    std::scoped_lock lock(state.mutex);
+    state.sources.Clear();
+}
+
+void StatsCollector::SetViewSchemaVersion(std::uint32_t maxSchemaVersion)
+{
+    const auto version = maxSchemaVersion >= StatsCollectorInternal::kStatsSchemaVersionPositional
+        ? StatsCollectorInternal::kStatsSchemaVersionPositional
+        : StatsCollectorInternal::kStatsSchemaVersion;
+    StatsCollectorInternal::gStatsDispatchState.dispatcher.SetWireSchemaVersion(version);
+}
+
+void StatsCollector::ResetViewSchemaVersion()
+{
+    StatsCollectorInternal::gStatsDispatchState.dispatcher.SetWireSchemaVersion(StatsCollectorInternal::kStatsSchemaVersion);
+}
+
+std::string StatsCollector::PerformanceDiagnosticsJson()
+{
+    std::string json = "{";
+    StatsCollectorInternal::AppendMemoStatsJson(json, "critChanceMemo", CriticalChanceEvaluator::GetMemoStats());
+    json += ',';
+    auto handStats = StatsCollectorInternal::gHandStatsMemos[0].Counters().Snapshot();
+    handStats += StatsCollectorInternal::gHandStatsMemos[1].Counters().Snapshot();
+    StatsCollectorInternal::AppendMemoStatsJson(json, "handStatsMemo", handStats);
+    json += ',';
+    StatsCollectorInternal::AppendCollectionTimingsJson(json);
+    json += '}';
+    return json;
+}
+
+std::string_view StatsCollector::StatsKeyTableJson()
+{
+    static const std::string json = StatsCollectorInternal::BuildStatsKeyTableJson();
+    return json;
 }
 
 }  // namespace TulliusWidgets
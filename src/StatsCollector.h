@@ -1,12 +1,59 @@
 #pragma once
 
+#include "UpdateRateController.h"
+
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace TulliusWidgets {
 
 class StatsCollector {
 public:
-    static std::string CollectStats();
+    // Game-thread half of a collection: reads everything that needs the
+    // engine and publishes it for BuildStatsJson() without waiting for it.
+    // Fills `rateSample` with the values that drive the update rate. False
+    // when there is nothing to send. Game thread only.
+    static bool CaptureStats(WidgetRuntime::UpdateRateSample& rateSample);
+    // Derives the rest of the newest published capture and encodes it into
+    // `json`; captures published in between are dropped. Needs no engine
+    // access, so it runs on the stats worker; one thread at a time. False
+    // when there is no new capture. `json` is empty when nothing the view
+    // displays changed since the last payload, so the caller can skip the
+    // interop call. The JSON lives in a buffer reused across calls: it is
+    // NUL-terminated and valid until the next BuildStatsJson().
+    static bool BuildStatsJson(std::string_view& json);
+    // Forces the next payload to be a full keyframe instead of a delta.
+    static void RequestKeyframe();
+    // Re-reads the given kStatsSection* bits on captures over the next
+    // second; other event-driven sections reuse their last values until the
+    // periodic full collection. Safe from any thread, e.g. event sinks.
+    static void MarkSectionsDirty(std::uint32_t sections);
+    // Reassigns name ids from scratch; the next payload is a keyframe
+    // carrying the new table. Call when cached names may be stale.
+    static void ResetNameTable();
+    // Drops the inventory counters; the next capture re-walks the
+    // player's inventory. Call on game load and when events may have been missed.
+    static void ResetInventoryIndex();
+    // Applies a container-change delta for an item moved into (positive) or
+    // out of (negative) the player's inventory. Game thread only.
+    static void NoteInventoryChange(std::uint32_t baseFormId, std::int32_t delta);
+    // Drops a timed effect the game just removed from the player, so it
+    // leaves the list without waiting for the next collection pass.
+    static void NoteTimedEffectRemoved(std::uint32_t instanceId);
+    // Forgets every cached timed effect; instance ids restart per save.
+    static void ResetTimedEffects();
+    // Switches updateStats to the highest encoding both sides support, given
+    // the schemaVersion the view reported after receiving StatsKeyTableJson().
+    static void SetViewSchemaVersion(std::uint32_t maxSchemaVersion);
+    // Back to the keyed v1 encoding until the (reloaded) view reports again.
+    static void ResetViewSchemaVersion();
+    // Counters of the collector's memoized evaluations and the per-stage
+    // collection timing histograms, as a JSON object for the runtime
+    // diagnostics payload. Safe from any thread.
+    static std::string PerformanceDiagnosticsJson();
+    // Key table for decoding positional payloads; built once, NUL-terminated.
+    static std::string_view StatsKeyTableJson();
 };
 
 }  // namespace TulliusWidgets
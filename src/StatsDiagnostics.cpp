@@ -0,0 +1,160 @@
+#include "StatsDiagnostics.h"
+#include "JsonUtils.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+namespace {
+
+constexpr std::array<std::string_view, kCollectionStageCount> kCollectionStageNames{
+    "actorValues",
+    "offense",
+    "equipped",
+    "time",
+    "playerInfo",
+    "timedEffects",
+    "combat",
+    "derive",
+    "build",
+    "interop",
+};
+
+std::array<LatencyHistogram, kCollectionStageCount> gCollectionStageHistograms;
+
+void AppendLatencySummaryJson(std::string& out, std::string_view name, const LatencySummary& summary)
+{
+    out += '"';
+    out += name;
+    out += "\":{\"count\":";
+    JsonUtils::AppendInteger(out, summary.count);
+    out += ",\"p50Ns\":";
+    JsonUtils::AppendInteger(out, summary.p50Nanoseconds);
+    out += ",\"p95Ns\":";
+    JsonUtils::AppendInteger(out, summary.p95Nanoseconds);
+    out += ",\"p99Ns\":";
+    JsonUtils::AppendInteger(out, summary.p99Nanoseconds);
+    out += ",\"maxNs\":";
+    JsonUtils::AppendInteger(out, summary.maxNanoseconds);
+    out += '}';
+}
+
+}  // namespace
+
+std::uint64_t MemoStats::SavedNanoseconds() const noexcept
+{
+    return misses > 0 ? hits * (missNanoseconds / misses) : 0;
+}
+
+MemoStats& MemoStats::operator+=(const MemoStats& other) noexcept
+{
+    hits += other.hits;
+    misses += other.misses;
+    missNanoseconds += other.missNanoseconds;
+    return *this;
+}
+
+void MemoCounters::RecordMiss(std::chrono::nanoseconds cost) noexcept
+{
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    missNanoseconds_.fetch_add(static_cast<std::uint64_t>(cost.count()), std::memory_order_relaxed);
+}
+
+MemoStats MemoCounters::Snapshot() const noexcept
+{
+    return MemoStats{
+        hits_.load(std::memory_order_relaxed),
+        misses_.load(std::memory_order_relaxed),
+        missNanoseconds_.load(std::memory_order_relaxed)
+    };
+}
+
+void AppendMemoStatsJson(std::string& out, std::string_view name, const MemoStats& stats)
+{
+    out += '"';
+    out += name;
+    out += "\":{\"hits\":";
+    JsonUtils::AppendInteger(out, stats.hits);
+    out += ",\"misses\":";
+    JsonUtils::AppendInteger(out, stats.misses);
+    out += ",\"missUs\":";
+    JsonUtils::AppendInteger(out, stats.missNanoseconds / 1000);
+    out += ",\"savedUs\":";
+    JsonUtils::AppendInteger(out, stats.SavedNanoseconds() / 1000);
+    out += '}';
+}
+
+
+// Values below 4 ns get a bucket each; above that, octave k (durations in
+// [2^k, 2^(k+1))) is split into four equal buckets starting at index 4(k-1).
+std::size_t LatencyHistogram::BucketIndex(std::uint64_t nanoseconds) noexcept
+{
+    if (nanoseconds < 4) return static_cast<std::size_t>(nanoseconds);
+    const auto octave = static_cast<std::size_t>(std::bit_width(nanoseconds) - 1);
+    const auto sub = static_cast<std::size_t>((nanoseconds >> (octave - 2)) & 3);
+    return (std::min)((octave - 1) * 4 + sub, kBucketCount - 1);
+}
+
+std::uint64_t LatencyHistogram::BucketUpperBound(std::size_t index) noexcept
+{
+    if (index < 4) return index;
+    if (index >= kBucketCount - 1) return UINT64_MAX;
+    const auto octave = index / 4 + 1;
+    const auto sub = index % 4;
+    return ((std::uint64_t{ 5 } + sub) << (octave - 2)) - 1;
+}
+
+void LatencyHistogram::Record(std::chrono::nanoseconds duration) noexcept
+{
+    const auto nanoseconds = static_cast<std::uint64_t>((std::max)(duration.count(), std::int64_t{ 0 }));
+    buckets_[BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    auto seenMax = maxNanoseconds_.load(std::memory_order_relaxed);
+    while (nanoseconds > seenMax
+           && !maxNanoseconds_.compare_exchange_weak(seenMax, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+LatencySummary LatencyHistogram::Summarize() const noexcept
+{
+    std::array<std::uint64_t, kBucketCount> counts{};
+    LatencySummary summary{};
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        summary.count += counts[i];
+    }
+    summary.maxNanoseconds = maxNanoseconds_.load(std::memory_order_relaxed);
+    if (summary.count == 0) return summary;
+
+    const auto percentile = [&](std::uint64_t perMille) {
+        // Rank of the sample at this percentile, 1-based and rounded up.
+        const auto rank = (summary.count * perMille + 999) / 1000;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return (std::min)(BucketUpperBound(i), summary.maxNanoseconds);
+        }
+        return summary.maxNanoseconds;
+    };
+    summary.p50Nanoseconds = percentile(500);
+    summary.p95Nanoseconds = percentile(950);
+    summary.p99Nanoseconds = percentile(990);
+    return summary;
+}
+
+LatencyHistogram& CollectionStageHistogram(CollectionStage stage) noexcept
+{
+    return gCollectionStageHistograms[static_cast<std::size_t>(stage)];
+}
+
+void AppendCollectionTimingsJson(std::string& out)
+{
+    out += "\"collectionTimings\":{";
+    for (std::size_t i = 0; i < kCollectionStageCount; ++i) {
+        if (i > 0) out += ',';
+        AppendLatencySummaryJson(out, kCollectionStageNames[i], gCollectionStageHistograms[i].Summarize());
+    }
+    out += '}';
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
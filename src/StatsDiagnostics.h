@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+struct MemoStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t missNanoseconds{0};
+
+    // Time the hits saved, estimated at the mean cost of a miss.
+    std::uint64_t SavedNanoseconds() const noexcept;
+    MemoStats& operator+=(const MemoStats& other) noexcept;
+};
+
+// Hit and miss counters of a memoized evaluation. Written by the collecting
+// thread; Snapshot() may be called from any thread.
+class MemoCounters {
+public:
+    void RecordHit() noexcept { hits_.fetch_add(1, std::memory_order_relaxed); }
+    void RecordMiss(std::chrono::nanoseconds cost) noexcept;
+    MemoStats Snapshot() const noexcept;
+
+private:
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> missNanoseconds_{0};
+};
+
+// Appends `"name":{...}` with the counters and the miss and saved time in
+// microseconds, for the runtime diagnostics payload.
+void AppendMemoStatsJson(std::string& out, std::string_view name, const MemoStats& stats);
+
+struct LatencySummary {
+    std::uint64_t count{0};
+    std::uint64_t p50Nanoseconds{0};
+    std::uint64_t p95Nanoseconds{0};
+    std::uint64_t p99Nanoseconds{0};
+    std::uint64_t maxNanoseconds{0};
+};
+
+// Fixed log-scale latency histogram: four buckets per power of two, so a
+// percentile is reported as the upper edge of its bucket (at most 25% high,
+// and never above the maximum seen). Recording is a few relaxed atomic
+// adds and never allocates; any thread may record or summarize.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t kBucketCount = 140;
+
+    void Record(std::chrono::nanoseconds duration) noexcept;
+    LatencySummary Summarize() const noexcept;
+
+    static std::size_t BucketIndex(std::uint64_t nanoseconds) noexcept;
+    // Largest duration that lands in `index`.
+    static std::uint64_t BucketUpperBound(std::size_t index) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+    std::atomic<std::uint64_t> maxNanoseconds_{0};
+};
+
+// Timed steps of one stats dispatch: the game-thread capture (actor-value
+// read and each engine-backed section), the worker's derivation and JSON
+// build (fingerprint, diff and writer), and the interop call that hands it
+// to the view.
+enum class CollectionStage : std::uint8_t {
+    kActorValues,
+    kOffense,
+    kEquipped,
+    kTime,
+    kPlayerInfo,
+    kTimedEffects,
+    kCombat,
+    kDerive,
+    kBuild,
+    kInterop,
+};
+
+inline constexpr std::size_t kCollectionStageCount = 10;
+
+// Process-wide histogram per stage.
+LatencyHistogram& CollectionStageHistogram(CollectionStage stage) noexcept;
+
+// Records the lifetime of the scope into the stage's histogram.
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(CollectionStage stage) noexcept
+        : histogram_(CollectionStageHistogram(stage)), start_(std::chrono::steady_clock::now())
+    {}
+    ~ScopedStageTimer() { histogram_.Record(std::chrono::steady_clock::now() - start_); }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Appends `"collectionTimings":{"<stage>":{"count":..,"p50Ns":..,...},...}`.
+void AppendCollectionTimingsJson(std::string& out);
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,198 @@
+#include "StatsDispatcher.h"
+#include "StatsPayloadDiff.h"
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+namespace {
+
+std::int64_t ToTicks(std::chrono::steady_clock::time_point time) noexcept
+{
+    return time.time_since_epoch().count();
+}
+
+}  // namespace
+
+std::uint32_t StatsDispatcher::SectionsDue(std::chrono::steady_clock::time_point now) const noexcept
+{
+    const auto nowTicks = ToTicks(now);
+    if (nowTicks >= fullCollectionDueTicks_.load(std::memory_order_acquire)
+        || nameTableResetRequested_.load(std::memory_order_acquire)) {
+        return kStatsSectionAll;
+    }
+
+    std::uint32_t sections = kStatsSectionAll & ~kStatsSectionsEventDriven;
+    for (std::size_t i = 0; i < kStatsSectionCount; ++i) {
+        if (dirtyUntil_[i].load(std::memory_order_acquire) >= nowTicks) {
+            sections |= 1u << i;
+        }
+    }
+    return sections;
+}
+
+StatsDispatcher::Capture StatsDispatcher::BeginCapture(std::chrono::steady_clock::time_point now) noexcept
+{
+    return BeginCapture(now, SectionsDue(now));
+}
+
+StatsDispatcher::Capture StatsDispatcher::BeginCapture(std::chrono::steady_clock::time_point now, std::uint32_t sections) noexcept
+{
+    // Resetting between captures keeps every id in the new capture in the
+    // new epoch; the keyframe then replaces the view's table wholesale.
+    // Carried-over names are interned again below.
+    if (nameTableResetRequested_.exchange(false, std::memory_order_acq_rel) || names_.Size() >= kMaxInternedNames) {
+        names_.Reset();
+        keyframeRequested_.store(true, std::memory_order_release);
+    }
+    if (sections == kStatsSectionAll) {
+        fullCollectionDueTicks_.store(ToTicks(now + kFullCollectionMaxAge), std::memory_order_release);
+    }
+
+    auto& slot = slots_[captureIndex_];
+    const auto& lastSent = slots_[captureIndex_ ^ 1];
+    slot.strings.Reset();
+    slot.payload.timedEffects.clear();
+    slot.payload.schemaVersion = wireSchemaVersion_.load(std::memory_order_acquire);
+
+    if (!(sections & kStatsSectionResistances)) slot.payload.resistances = lastSent.payload.resistances;
+    if (!(sections & kStatsSectionDefense)) slot.payload.defense = lastSent.payload.defense;
+    if (!(sections & kStatsSectionOffense)) slot.payload.offense = lastSent.payload.offense;
+    if (!(sections & kStatsSectionEquipped)) {
+        // Names live in the last sent slot's scratch, which the next capture
+        // rewinds, so they are copied. Interning again is a lookup unless
+        // the table was just reset.
+        slot.payload.equipped = lastSent.payload.equipped;
+        slot.payload.equipped.rightHand = slot.strings.Store(lastSent.payload.equipped.rightHand);
+        slot.payload.equipped.leftHand = slot.strings.Store(lastSent.payload.equipped.leftHand);
+        slot.payload.equipped.rightHandNameId = names_.Intern(slot.payload.equipped.rightHand);
+        slot.payload.equipped.leftHandNameId = names_.Intern(slot.payload.equipped.leftHand);
+    }
+    return Capture{ slot.payload, slot.strings, names_, sections };
+}
+
+std::string_view StatsDispatcher::Commit(std::chrono::steady_clock::time_point now)
+{
+    auto& slot = slots_[captureIndex_];
+    const auto& payload = slot.payload;
+    const auto& lastSent = slots_[captureIndex_ ^ 1].payload;
+    slot.timeAnchor = now;
+    slot.timedEffectsAnchor = now;
+
+    // The fingerprint covers schemaVersion, so an encoding switch is never
+    // skipped; it must not be a delta either, the view may not have the
+    // previous encoding's state.
+    const bool keyframeRequested = keyframeRequested_.exchange(false, std::memory_order_acq_rel);
+    const bool keyframeForced = keyframeRequested || !hasBaseline_ || payload.schemaVersion != lastSent.schemaVersion;
+    const auto held = keyframeForced ? 0u : HoldExtrapolatedSections(now);
+    auto fingerprint = FingerprintStatsPayload(payload);
+    if (!keyframeRequested && hasBaseline_ && fingerprint == lastSentFingerprint_) {
+        return {};
+    }
+
+    const bool keyframe = keyframeForced || now - lastKeyframeTime_ >= kKeyframeMaxAge;
+    if (keyframe && held != 0) {
+        ReleaseHeldSections(held, now);
+        fingerprint = FingerprintStatsPayload(payload);
+    }
+
+    std::string_view json;
+    if (keyframe) {
+        json = writer_.Build(payload, StatsNameUpdate{ 0, names_.Entries() });
+        lastKeyframeTime_ = now;
+    } else {
+        json = writer_.BuildDelta(
+            payload,
+            DiffStatsSections(lastSent, payload),
+            lastSent.sequence,
+            StatsNameUpdate{ names_.SentCount(), names_.Unsent() });
+    }
+    // Keyed payloads never reference ids, so their names stay unsent until
+    // the view switches to the positional encoding (with a keyframe).
+    if (payload.schemaVersion == kStatsSchemaVersionPositional) {
+        names_.MarkSent();
+    }
+
+    // The captured slot becomes the diff base; the old base is recycled for
+    // the next capture.
+    captureIndex_ ^= 1;
+    lastSentFingerprint_ = fingerprint;
+    hasBaseline_ = true;
+    return json;
+}
+
+std::uint32_t StatsDispatcher::HoldExtrapolatedSections(std::chrono::steady_clock::time_point now)
+{
+    auto& slot = slots_[captureIndex_];
+    const auto& lastSent = slots_[captureIndex_ ^ 1];
+    const auto secondsSince = [now](std::chrono::steady_clock::time_point anchor) {
+        return std::chrono::duration<double>(now - anchor).count();
+    };
+
+    std::uint32_t held = 0;
+    if (GameTimeFollowsAnchor(lastSent.payload.time, slot.payload.time, secondsSince(lastSent.timeAnchor))) {
+        // The month name view stays in this slot's scratch.
+        heldTime_ = slot.payload.time;
+        slot.payload.time.minute = lastSent.payload.time.minute;
+        slot.payload.time.hour = lastSent.payload.time.hour;
+        slot.payload.time.day = lastSent.payload.time.day;
+        slot.timeAnchor = lastSent.timeAnchor;
+        held |= kStatsSectionTime;
+    }
+
+    auto& effects = slot.payload.timedEffects;
+    if (!effects.empty()
+        && TimedEffectsFollowAnchor(lastSent.payload.timedEffects, effects, secondsSince(lastSent.timedEffectsAnchor))) {
+        heldRemainingSec_.clear();
+        for (std::size_t i = 0; i < effects.size(); ++i) {
+            heldRemainingSec_.push_back(effects[i].remainingSec);
+            effects[i].remainingSec = lastSent.payload.timedEffects[i].remainingSec;
+        }
+        slot.timedEffectsAnchor = lastSent.timedEffectsAnchor;
+        held |= kStatsSectionTimedEffects;
+    }
+    return held;
+}
+
+void StatsDispatcher::ReleaseHeldSections(std::uint32_t held, std::chrono::steady_clock::time_point now) noexcept
+{
+    auto& slot = slots_[captureIndex_];
+    if (held & kStatsSectionTime) {
+        slot.payload.time = heldTime_;
+        slot.timeAnchor = now;
+    }
+    if (held & kStatsSectionTimedEffects) {
+        auto& effects = slot.payload.timedEffects;
+        for (std::size_t i = 0; i < effects.size(); ++i) {
+            effects[i].remainingSec = heldRemainingSec_[i];
+        }
+        slot.timedEffectsAnchor = now;
+    }
+}
+
+void StatsDispatcher::RequestKeyframe() noexcept
+{
+    keyframeRequested_.store(true, std::memory_order_release);
+}
+
+void StatsDispatcher::RequestNameTableReset() noexcept
+{
+    nameTableResetRequested_.store(true, std::memory_order_release);
+}
+
+void StatsDispatcher::MarkSectionsDirty(std::uint32_t sections, std::chrono::steady_clock::time_point now) noexcept
+{
+    // Marks from different threads land within microseconds of each other,
+    // so a plain store (instead of a max) loses at most that much hold time.
+    const auto until = ToTicks(now + kDirtySectionHold);
+    for (std::size_t i = 0; i < kStatsSectionCount; ++i) {
+        if (sections & (1u << i)) {
+            dirtyUntil_[i].store(until, std::memory_order_release);
+        }
+    }
+}
+
+void StatsDispatcher::SetWireSchemaVersion(std::uint32_t version) noexcept
+{
+    wireSchemaVersion_.store(version, std::memory_order_release);
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "StatsJsonWriter.h"
+#include "StatsNameTable.h"
+#include "StatsPayload.h"
+#include "StatsScratch.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Upper bound between keyframes so a view that silently missed a delta
+// converges even if it never asks for a resync.
+inline constexpr auto kKeyframeMaxAge = std::chrono::seconds(5);
+// Event-driven sections are all re-read at least this often, in case an
+// event was missed or the game changed them without one (skill increases).
+inline constexpr auto kFullCollectionMaxAge = std::chrono::seconds(5);
+// Sections the view extrapolates between updates: countdowns and the game
+// clock. While the captured values follow the last sent anchor they are held
+// at it, so steady ticking alone never causes a dispatch.
+inline constexpr std::uint32_t kStatsSectionsExtrapolated = kStatsSectionTime | kStatsSectionTimedEffects;
+// Events often fire before the game state settles (equipment slots lag an
+// equip event by a few frames), so a dirty mark holds for this long.
+inline constexpr auto kDirtySectionHold = std::chrono::seconds(1);
+
+// Everything the stats pipeline keeps between ticks: two payload slots
+// (capture and last sent) with their string scratch, the name table and the
+// JSON writer.
+// Slots swap roles instead of being copied, and every buffer keeps its
+// capacity, so the steady state does not allocate. Not thread-safe except
+// for the members marked so; callers serialize BeginCapture()/Commit().
+class StatsDispatcher {
+public:
+    struct Capture {
+        StatsPayload& payload;
+        StatsScratch& strings;
+        StatsNameTable& names;
+        // Sections to collect. The others already hold the last sent values.
+        std::uint32_t sections;
+    };
+
+    // Sections a capture taken at `now` has to read: the always-collected
+    // ones, those marked dirty, or all of them when the periodic full
+    // collection is due. Safe from any thread, so the capture can run on
+    // another thread than BeginCapture().
+    std::uint32_t SectionsDue(std::chrono::steady_clock::time_point now) const noexcept;
+    // Rewinds and returns the capture slot for the SectionsDue(now); the
+    // last sent slot is untouched apart from clean sections being copied
+    // out of it.
+    Capture BeginCapture(std::chrono::steady_clock::time_point now) noexcept;
+    // Same for a capture that read `sections`; the others are carried over.
+    Capture BeginCapture(std::chrono::steady_clock::time_point now, std::uint32_t sections) noexcept;
+    // Emits a keyframe or a delta against the last sent payload, or an empty
+    // view when the captured content matches it. The returned view is
+    // NUL-terminated and valid until the next Commit().
+    std::string_view Commit(std::chrono::steady_clock::time_point now);
+    // Makes the next Commit() emit a keyframe. Safe from any thread.
+    void RequestKeyframe() noexcept;
+    // Wire encoding for captures started after this call; a change is sent
+    // as a keyframe. Safe from any thread.
+    void SetWireSchemaVersion(std::uint32_t version) noexcept;
+    // Drops the name table (new ids, sent with a keyframe) before the next
+    // capture, e.g. after a game load or when the view reloaded. Safe from
+    // any thread.
+    void RequestNameTableReset() noexcept;
+    // Makes captures up to `now` + kDirtySectionHold collect `sections`.
+    // Safe from any thread.
+    void MarkSectionsDirty(std::uint32_t sections, std::chrono::steady_clock::time_point now) noexcept;
+
+private:
+    struct Slot {
+        StatsPayload payload{};
+        StatsScratch strings{};
+        // When the view took the current time and timed-effect values as
+        // its extrapolation anchors.
+        std::chrono::steady_clock::time_point timeAnchor{};
+        std::chrono::steady_clock::time_point timedEffectsAnchor{};
+    };
+
+    // Replaces extrapolated sections of the capture that follow the last
+    // sent anchors with the anchor values; returns the held sections.
+    std::uint32_t HoldExtrapolatedSections(std::chrono::steady_clock::time_point now);
+    // Puts the captured values of `held` back, e.g. before a keyframe, which
+    // re-anchors the view at the time it arrives.
+    void ReleaseHeldSections(std::uint32_t held, std::chrono::steady_clock::time_point now) noexcept;
+
+    std::array<Slot, 2> slots_{};
+    std::size_t captureIndex_{ 0 };
+    std::atomic<bool> keyframeRequested_{ true };
+    std::atomic<std::uint32_t> wireSchemaVersion_{ kStatsSchemaVersion };
+    std::atomic<bool> nameTableResetRequested_{ false };
+    // Per section, steady_clock ticks until which it stays dirty.
+    std::array<std::atomic<std::int64_t>, kStatsSectionCount> dirtyUntil_{};
+    // steady_clock ticks from which the next capture collects everything.
+    std::atomic<std::int64_t> fullCollectionDueTicks_{ 0 };
+    bool hasBaseline_{ false };
+    std::uint64_t lastSentFingerprint_{ 0 };
+    std::chrono::steady_clock::time_point lastKeyframeTime_{};
+    GameTimeEntry heldTime_{};
+    std::vector<std::int32_t> heldRemainingSec_{};
+    StatsNameTable names_{};
+    StatsJsonWriter writer_{};
+};
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
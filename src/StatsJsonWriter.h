@@ -1,32 +1,48 @@
 #pragma once
 
 #include "StatsPayload.h"
+#include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 
 namespace TulliusWidgets::StatsCollectorInternal {
 
+// Name table entries a positional payload adds, as `"nameBase":base,
+// "names":[...]`; `base` is the id of the first added name. Keyframes send
+// base 0 with the whole table so the view can replace its copy.
+struct StatsNameUpdate {
+    std::uint32_t base{ 0 };
+    std::span<const std::string_view> added{};
+};
+
 class StatsJsonWriter {
 public:
-    std::string Build(const StatsPayload& payload);
+    // The returned view points into the writer's reusable buffer; it is
+    // NUL-terminated and valid until the next Build*() call.
+
+    // payload.schemaVersion picks the section encoding: keyed objects for
+    // kStatsSchemaVersion, positional arrays for kStatsSchemaVersionPositional.
+
+    // Full keyframe: every section, so the view can resync from scratch.
+    std::string_view Build(const StatsPayload& payload, StatsNameUpdate names = {});
+    // Delta: only the kStatsSection* bits in `sections`, applied by the view
+    // on top of the payload whose seq is `baseSequence`.
+    std::string_view BuildDelta(
+        const StatsPayload& payload,
+        std::uint32_t sections,
+        std::uint32_t baseSequence,
+        StatsNameUpdate names = {});
 
 private:
-    void AppendFloat(float value);
-    void AppendInt(std::int32_t value);
-    void AppendUInt(std::uint32_t value);
-    void AppendBool(bool value);
-    void AppendEscapedString(std::string_view value);
-    void AppendMeta(const StatsPayload& payload);
-    void AppendResistances(const StatsPayload& payload);
-    void AppendDefense(const StatsPayload& payload);
-    void AppendOffense(const StatsPayload& payload);
-    void AppendCalcMeta(const StatsPayload& payload);
-    void AppendEquipped(const StatsPayload& payload);
-    void AppendMovement(const StatsPayload& payload);
-    void AppendTime(const GameTimeEntry& time);
-    void AppendPlayerInfo(const PlayerInfoSnapshot& playerInfo);
-    void AppendAlertData(const AlertDataSnapshot& alertData);
-    void AppendTimedEffects(const std::vector<TimedEffectEntry>& timedEffects);
+    std::string_view BuildSections(
+        const StatsPayload& payload,
+        std::uint32_t sections,
+        bool keyframe,
+        std::uint32_t baseSequence,
+        StatsNameUpdate names);
+    void AppendMeta(const StatsPayload& payload, bool keyframe, std::uint32_t baseSequence);
+    void AppendNames(StatsNameUpdate names);
 
     std::string json_{};
 };
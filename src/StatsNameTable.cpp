@@ -0,0 +1,41 @@
+#include "StatsNameTable.h"
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+StatsNameTable::StatsNameTable()
+{
+    Reset();
+}
+
+std::uint32_t StatsNameTable::Intern(std::string_view text)
+{
+    if (const auto it = ids_.find(text); it != ids_.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<std::uint32_t>(texts_.size());
+    const auto it = ids_.emplace(std::string(text), id).first;
+    texts_.push_back(it->first);
+    return id;
+}
+
+std::span<const std::string_view> StatsNameTable::Unsent() const noexcept
+{
+    return std::span<const std::string_view>(texts_).subspan(sentCount_);
+}
+
+void StatsNameTable::MarkSent() noexcept
+{
+    sentCount_ = static_cast<std::uint32_t>(texts_.size());
+}
+
+void StatsNameTable::Reset()
+{
+    ids_.clear();
+    texts_.clear();
+    sentCount_ = 0;
+    ++epoch_;
+    (void)Intern({});
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Upper bound before the table is dropped and rebuilt from the names still
+// in use; each rebuild costs the view one keyframe.
+inline constexpr std::size_t kMaxInternedNames = 4096;
+
+// Effect and equipped-item names interned to dense ids, so positional
+// payloads carry an integer per name and each distinct name crosses the
+// bridge once per table epoch. Id 0 is always the empty name. Looking up a
+// known name does not allocate.
+class StatsNameTable {
+public:
+    StatsNameTable();
+
+    std::uint32_t Intern(std::string_view text);
+    std::size_t Size() const noexcept { return texts_.size(); }
+
+    // Every entry, in id order; keyframes resend the whole table.
+    std::span<const std::string_view> Entries() const noexcept { return texts_; }
+    // Entries the view has not been sent yet, starting at id SentCount().
+    std::span<const std::string_view> Unsent() const noexcept;
+    std::uint32_t SentCount() const noexcept { return sentCount_; }
+    void MarkSent() noexcept;
+
+    // Starts a new epoch: ids are reassigned from scratch.
+    void Reset();
+    // Changes on every Reset(), so callers caching ids can tell they are stale.
+    std::uint32_t Epoch() const noexcept { return epoch_; }
+
+private:
+    struct TextHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view text) const noexcept { return std::hash<std::string_view>{}(text); }
+    };
+
+    // Node-based, so texts_ can view the keys directly.
+    std::unordered_map<std::string, std::uint32_t, TextHash, std::equal_to<>> ids_{};
+    std::vector<std::string_view> texts_{};
+    std::uint32_t sentCount_{ 0 };
+    std::uint32_t epoch_{ 0 };
+};
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
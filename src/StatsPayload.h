@@ -1,9 +1,13 @@
 #pragma once
 
 #include "CriticalChanceEvaluator.h"
+#include "GameSettings.h"
 #include "ResistanceEvaluator.h"
+#include "StatsNameTable.h"
+#include "StatsScratch.h"
+#include <cstddef>
 #include <cstdint>
-#include <string>
+#include <string_view>
 #include <vector>
 
 namespace RE {
@@ -14,26 +18,54 @@ namespace TulliusWidgets::StatsCollectorInternal {
 
 inline constexpr float kDisplayedDamageMin = 0.0f;
 inline constexpr float kDisplayedDamageMax = 9999.0f;
-inline constexpr float kElementalResistCap = 85.0f;
 inline constexpr float kElementalResistMin = -100.0f;
 inline constexpr float kDiseaseResistCap = 100.0f;
 inline constexpr float kDiseaseResistMin = 0.0f;
 inline constexpr float kCritChanceCap = 100.0f;
-inline constexpr float kDamageReductionCap = 80.0f;
-inline constexpr float kArmorRatingMultiplier = 0.12f;
-inline constexpr float kArmorRatingForMaxReduction = 666.67f;
 inline constexpr std::uint32_t kStatsSchemaVersion = 1;
-
+// Opt-in positional encoding, used once the view reports support for it.
+inline constexpr std::uint32_t kStatsSchemaVersionPositional = 2;
+
+// Top-level payload sections. Delta payloads carry only the sections whose
+// displayed (two-decimal) values changed since the previous dispatch.
+inline constexpr std::uint32_t kStatsSectionResistances = 1u << 0;
+inline constexpr std::uint32_t kStatsSectionDefense = 1u << 1;
+inline constexpr std::uint32_t kStatsSectionOffense = 1u << 2;
+inline constexpr std::uint32_t kStatsSectionCalcMeta = 1u << 3;
+inline constexpr std::uint32_t kStatsSectionEquipped = 1u << 4;
+inline constexpr std::uint32_t kStatsSectionMovement = 1u << 5;
+inline constexpr std::uint32_t kStatsSectionTime = 1u << 6;
+inline constexpr std::uint32_t kStatsSectionPlayerInfo = 1u << 7;
+inline constexpr std::uint32_t kStatsSectionAlertData = 1u << 8;
+inline constexpr std::uint32_t kStatsSectionTimedEffects = 1u << 9;
+inline constexpr std::uint32_t kStatsSectionCombat = 1u << 10;
+inline constexpr std::uint32_t kStatsSectionAll = (1u << 11) - 1;
+inline constexpr std::size_t kStatsSectionCount = 11;
+
+// Sections whose inputs only move on equipment, effect, perk or menu
+// changes. They are re-read when an event marks them dirty (or a periodic
+// sweep is due) and carried over from the last sent payload otherwise.
+// calcMeta is derived from the same snapshots and follows them. Everything
+// else tracks game time, regeneration or countdowns and is read every time.
+inline constexpr std::uint32_t kStatsSectionsEventDriven =
+    kStatsSectionResistances | kStatsSectionDefense | kStatsSectionOffense | kStatsSectionCalcMeta | kStatsSectionEquipped;
+
+// Name fields are views into the StatsScratch the payload was captured with
+// (or into static storage), so payloads are filled in place without
+// allocating and are never copied. The matching *NameId fields index the
+// dispatcher's StatsNameTable and replace the text in positional payloads.
 struct TimedEffectEntry {
     std::int32_t instanceId;
-    std::string sourceName;
-    std::string effectName;
+    std::string_view sourceName;
+    std::string_view effectName;
     std::int32_t remainingSec;
     std::int32_t totalSec;
     bool isDebuff;
     std::uint32_t sourceFormId;
     std::uint32_t effectFormId;
     std::uint32_t spellFormId;
+    std::uint32_t sourceNameId{0};
+    std::uint32_t effectNameId{0};
 };
 
 struct GameTimeEntry {
@@ -43,7 +75,7 @@ struct GameTimeEntry {
     std::uint32_t hour{0};
     std::uint32_t minute{0};
     float timeScale{0.0f};
-    std::string monthName{};
+    std::string_view monthName{};
 };
 
 struct ResistanceSnapshot {
@@ -63,6 +95,14 @@ struct DefenseSnapshot {
     bool damageReductionClamped{false};
 };
 
+// Caps read from game settings (see GameSettings.h), so they follow mods
+// that change them. Reported in calcMeta and carried with it.
+struct StatCapsSnapshot {
+    float elementalResist{GameSettings::kDefaultPlayerMaxResistance};
+    float damageReduction{GameSettings::kDefaultMaxArmorRating};
+    float armorRatingForMaxReduction{GameSettings::kDefaultMaxArmorRating / GameSettings::kDefaultArmorScalingFactor};
+};
+
 struct OffenseSnapshot {
     float rightHandDamage{0.0f};
     float leftHandDamage{0.0f};
@@ -70,8 +110,10 @@ struct OffenseSnapshot {
 };
 
 struct EquippedSnapshot {
-    std::string rightHand{};
-    std::string leftHand{};
+    std::string_view rightHand{};
+    std::string_view leftHand{};
+    std::uint32_t rightHandNameId{0};
+    std::uint32_t leftHandNameId{0};
 };
 
 struct MovementSnapshot {
@@ -90,6 +132,19 @@ struct PlayerInfoSnapshot {
     float health{0.0f};
     float magicka{0.0f};
     float stamina{0.0f};
+    // Count of the equipped ammo; 0 when none is equipped.
+    std::int32_t ammoCount{0};
+    std::int32_t healthPotionCount{0};
+    std::int32_t magickaPotionCount{0};
+    std::int32_t staminaPotionCount{0};
+};
+
+struct InventoryCountsSnapshot {
+    std::int32_t gold{0};
+    std::int32_t ammo{0};
+    std::int32_t healthPotions{0};
+    std::int32_t magickaPotions{0};
+    std::int32_t staminaPotions{0};
 };
 
 struct AlertDataSnapshot {
@@ -99,17 +154,13 @@ struct AlertDataSnapshot {
     float carryPct{0.0f};
 };
 
-struct PlayerStateSnapshot {
-    PlayerInfoSnapshot playerInfo{};
-    AlertDataSnapshot alertData{};
-};
-
 struct StatsPayload {
     std::uint32_t schemaVersion{kStatsSchemaVersion};
     std::uint32_t sequence{0};
     ResistanceSnapshot resistances{};
     DefenseSnapshot defense{};
     OffenseSnapshot offense{};
+    StatCapsSnapshot caps{};
     EquippedSnapshot equipped{};
     MovementSnapshot movement{};
     GameTimeEntry time{};
@@ -119,6 +170,15 @@ struct StatsPayload {
     bool inCombat{false};
 };
 
-StatsPayload CollectStatsPayload(RE::PlayerCharacter* player);
+struct StatsCaptureFrame;
+
+// Game-thread half of a collection: fills `frame` with everything of
+// `sections` that needs the engine (see StatsCaptureFrame). Sections
+// outside kStatsSectionsEventDriven are always collected.
+void CaptureStatsPayload(RE::PlayerCharacter* player, StatsCaptureFrame& frame, std::uint32_t sections = kStatsSectionAll);
+
+// Worker half: merges `frame` into the dispatcher's capture slot and
+// derives the remaining fields without touching the engine.
+void FinishStatsPayload(const StatsCaptureFrame& frame, StatsPayload& payload, StatsScratch& strings, StatsNameTable& names);
 
 }  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,131 @@
+#include "StatsPayloadDiff.h"
+#include "StatsPayloadSchema.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <tuple>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+namespace {
+
+bool SameValue(float a, float b)
+{
+    return QuantizeHundredths(a) == QuantizeHundredths(b);
+}
+
+template <class T>
+bool SameValue(const T& a, const T& b)
+{
+    return a == b;
+}
+
+// Every value compares at the precision the view displays.
+constexpr auto kSameDisplayed = [](std::string_view, const auto& a, const auto& b) {
+    return SameValue(a, b);
+};
+
+// Everything but the countdown, which the view extrapolates.
+constexpr auto kSameTimedEffectIdentity = [](std::string_view key, const auto& a, const auto& b) {
+    return key == "remainingSec" || SameValue(a, b);
+};
+
+const auto& kTimedEffectsSection = StatsSchema::FindSection<kStatsSectionTimedEffects>(kStatsPayloadSchema);
+
+bool SameTimedEffectIdentity(const TimedEffectEntry& a, const TimedEffectEntry& b)
+{
+    return std::apply(
+        [&](const auto&... column) { return (StatsSchema::SameValues(a, b, column, kSameTimedEffectIdentity) && ...); },
+        kTimedEffectsSection.node.columns);
+}
+
+class FingerprintBuilder {
+public:
+    void Add(std::uint64_t value)
+    {
+        // splitmix64 finalizer so neighbouring small integers spread out
+        // before being folded into the running FNV-style state.
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        value ^= value >> 31;
+        hash_ = (hash_ ^ value) * kPrime;
+    }
+
+    void Add(float value) { Add(static_cast<std::uint64_t>(QuantizeHundredths(value))); }
+    void Add(std::int32_t value) { Add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value))); }
+    void Add(std::uint32_t value) { Add(static_cast<std::uint64_t>(value)); }
+    void Add(bool value) { Add(static_cast<std::uint64_t>(value ? 1 : 0)); }
+
+    void Add(std::string_view value)
+    {
+        std::uint64_t stringHash = kOffsetBasis;
+        for (const unsigned char c : value) {
+            stringHash = (stringHash ^ c) * kPrime;
+        }
+        Add(static_cast<std::uint64_t>(value.size()));
+        Add(stringHash);
+    }
+
+    std::uint64_t Value() const { return hash_; }
+
+private:
+    static constexpr std::uint64_t kOffsetBasis = 0xCBF29CE484222325ull;
+    static constexpr std::uint64_t kPrime = 0x00000100000001B3ull;
+
+    std::uint64_t hash_{kOffsetBasis};
+};
+
+}  // namespace
+
+std::int64_t QuantizeHundredths(float value)
+{
+    if (!std::isfinite(value)) return 0;
+    return std::llround(static_cast<double>(value) * 100.0);
+}
+
+std::uint32_t DiffStatsSections(const StatsPayload& previous, const StatsPayload& current)
+{
+    return StatsSchema::DiffSections(previous, current, kStatsPayloadSchema, kSameDisplayed);
+}
+
+bool TimedEffectsFollowAnchor(
+    const std::vector<TimedEffectEntry>& anchor,
+    const std::vector<TimedEffectEntry>& current,
+    double elapsedSec)
+{
+    if (anchor.size() != current.size()) return false;
+    for (std::size_t i = 0; i < anchor.size(); ++i) {
+        if (!SameTimedEffectIdentity(anchor[i], current[i])) return false;
+        // remainingSec is rounded up on both ends, hence a second of slack.
+        const double predicted = static_cast<double>(anchor[i].remainingSec) - elapsedSec;
+        if (std::abs(static_cast<double>(current[i].remainingSec) - predicted) > 1.0) return false;
+    }
+    return true;
+}
+
+bool GameTimeFollowsAnchor(const GameTimeEntry& anchor, const GameTimeEntry& current, double elapsedSec)
+{
+    if (anchor.year != current.year || anchor.month != current.month || anchor.monthName != current.monthName) {
+        return false;
+    }
+    if (!SameValue(anchor.timeScale, current.timeScale)) return false;
+
+    const auto minuteIndex = [](const GameTimeEntry& time) {
+        return static_cast<double>((time.day * 24 + time.hour) * 60 + time.minute);
+    };
+    const double gameMinutesPerSecond = (std::max)(static_cast<double>(anchor.timeScale), 0.0) / 60.0;
+    const double predicted = minuteIndex(anchor) + elapsedSec * gameMinutesPerSecond;
+    return std::abs(minuteIndex(current) - predicted) <= 1.0 + gameMinutesPerSecond;
+}
+
+std::uint64_t FingerprintStatsPayload(const StatsPayload& payload)
+{
+    FingerprintBuilder fp;
+    fp.Add(payload.schemaVersion);
+    auto add = [&fp](const auto& value) { fp.Add(value); };
+    StatsSchema::VisitSections(payload, kStatsPayloadSchema, add);
+    return fp.Value();
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
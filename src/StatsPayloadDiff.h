@@ -0,0 +1,35 @@
+#pragma once
+
+#include "StatsPayload.h"
+#include <cstdint>
+#include <vector>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Quantizes to the two-decimal precision the writer and the view display.
+// Non-finite values collapse to 0, matching what the writer emits for them.
+std::int64_t QuantizeHundredths(float value);
+
+// Returns the kStatsSection* bits whose displayed values differ, comparing
+// every kStatsPayloadSchema field.
+std::uint32_t DiffStatsSections(const StatsPayload& previous, const StatsPayload& current);
+
+// Whether the view, extrapolating `anchor` over `elapsedSec` of real time,
+// shows `current` to within a second: the same effects in the same order,
+// each countdown where the anchor predicts it.
+bool TimedEffectsFollowAnchor(
+    const std::vector<TimedEffectEntry>& anchor,
+    const std::vector<TimedEffectEntry>& current,
+    double elapsedSec);
+
+// Whether `current` is `anchor` advanced by `elapsedSec` at the anchor's
+// time scale, to within a game minute plus one real second of drift. Month
+// changes always count as a discontinuity.
+bool GameTimeFollowsAnchor(const GameTimeEntry& anchor, const GameTimeEntry& current, double elapsedSec);
+
+// 64-bit hash of schemaVersion and every kStatsPayloadSchema field, at the
+// same quantization as DiffStatsSections. `sequence` is excluded so
+// identical content collides.
+std::uint64_t FingerprintStatsPayload(const StatsPayload& payload);
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,651 @@
+#pragma once
+
+#include "JsonUtils.h"
+#include "StatsPayload.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace TulliusWidgets::StatsCollectorInternal::StatsSchema {
+
+// Compile-time field descriptors for the updateStats wire format. Each node
+// carries its key as a template argument, so the `,"key":` prefix (including
+// any opening brace/bracket) is a single precomputed literal and the write
+// loop below only emits values.
+
+template <std::size_t N>
+struct Name {
+    char text[N]{};
+
+    constexpr Name(const char (&value)[N]) { std::copy_n(value, N, text); }
+    constexpr std::string_view View() const { return { text, N - 1 }; }
+};
+
+template <Name Key, bool Leading, char Open = '\0'>
+struct KeyPrefix {
+    static constexpr std::size_t kSize = Key.View().size() + 3 + (Leading ? 1 : 0) + (Open != '\0' ? 1 : 0);
+    static constexpr std::array<char, kSize> kText = [] {
+        std::array<char, kSize> out{};
+        std::size_t i = 0;
+        if (Leading) out[i++] = ',';
+        out[i++] = '"';
+        for (const char c : Key.View()) out[i++] = c;
+        out[i++] = '"';
+        out[i++] = ':';
+        if (Open != '\0') out[i++] = Open;
+        return out;
+    }();
+    static constexpr std::string_view value{ kText.data(), kText.size() };
+};
+
+template <Name Key, class Getter>
+struct FieldNode {
+    Getter get;
+};
+
+// A name that keyed payloads send as text and positional payloads send as
+// its StatsNameTable id.
+template <Name Key, class TextGetter, class IdGetter>
+struct NameRefNode {
+    TextGetter text;
+    IdGetter id;
+};
+
+template <Name Key, class... Children>
+struct ObjectNode {
+    std::tuple<Children...> children;
+};
+
+template <Name Key, class Getter, class... Columns>
+struct ArrayNode {
+    Getter get;
+    std::tuple<Columns...> columns;
+};
+
+template <std::uint32_t Bit, class Node>
+struct SectionNode {
+    Node node;
+};
+
+template <Name Key, class Getter>
+constexpr auto Field(Getter getter)
+{
+    return FieldNode<Key, Getter>{ getter };
+}
+
+template <Name Key, class TextGetter, class IdGetter>
+constexpr auto NameRef(TextGetter text, IdGetter id)
+{
+    return NameRefNode<Key, TextGetter, IdGetter>{ text, id };
+}
+
+template <Name Key, class... Children>
+constexpr auto Object(Children... children)
+{
+    return ObjectNode<Key, Children...>{ std::tuple<Children...>{ children... } };
+}
+
+template <Name Key, class Getter, class... Columns>
+constexpr auto Array(Getter getter, Columns... columns)
+{
+    return ArrayNode<Key, Getter, Columns...>{ getter, std::tuple<Columns...>{ columns... } };
+}
+
+template <std::uint32_t Bit, class Node>
+constexpr auto Section(Node node)
+{
+    return SectionNode<Bit, Node>{ node };
+}
+
+inline void AppendValue(std::string& out, float value)
+{
+    JsonUtils::AppendFixed2(out, value);
+}
+
+inline void AppendValue(std::string& out, std::int32_t value)
+{
+    JsonUtils::AppendInteger(out, value);
+}
+
+inline void AppendValue(std::string& out, std::uint32_t value)
+{
+    JsonUtils::AppendInteger(out, value);
+}
+
+inline void AppendValue(std::string& out, bool value)
+{
+    out += value ? "true" : "false";
+}
+
+inline void AppendValue(std::string& out, std::string_view value)
+{
+    out += '"';
+    JsonUtils::AppendEscaped(out, value);
+    out += '"';
+}
+
+template <class T>
+constexpr std::string_view JsonTypeName()
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return "boolean";
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+        return "string";
+    } else {
+        static_assert(std::is_arithmetic_v<T>, "schema field getters must return a number, bool or string_view");
+        return "number";
+    }
+}
+
+template <bool Leading, class Source, Name Key, class Getter>
+void Write(std::string& out, const Source& source, const FieldNode<Key, Getter>& field)
+{
+    out += KeyPrefix<Key, Leading>::value;
+    AppendValue(out, field.get(source));
+}
+
+template <bool Leading, class Source, Name Key, class TextGetter, class IdGetter>
+void Write(std::string& out, const Source& source, const NameRefNode<Key, TextGetter, IdGetter>& name)
+{
+    out += KeyPrefix<Key, Leading>::value;
+    AppendValue(out, std::string_view(name.text(source)));
+}
+
+template <class Source, class Tuple, std::size_t... I>
+void WriteChildren(std::string& out, const Source& source, const Tuple& children, std::index_sequence<I...>);
+
+template <bool Leading, class Source, Name Key, class... Children>
+void Write(std::string& out, const Source& source, const ObjectNode<Key, Children...>& object)
+{
+    out += KeyPrefix<Key, Leading, '{'>::value;
+    WriteChildren(out, source, object.children, std::index_sequence_for<Children...>{});
+    out += '}';
+}
+
+template <bool Leading, class Source, Name Key, class Getter, class... Columns>
+void Write(std::string& out, const Source& source, const ArrayNode<Key, Getter, Columns...>& array)
+{
+    out += KeyPrefix<Key, Leading, '['>::value;
+    bool first = true;
+    for (const auto& row : array.get(source)) {
+        if (!first) out += ',';
+        first = false;
+        out += '{';
+        WriteChildren(out, row, array.columns, std::index_sequence_for<Columns...>{});
+        out += '}';
+    }
+    out += ']';
+}
+
+template <class Source, class Tuple, std::size_t... I>
+void WriteChildren(std::string& out, const Source& source, const Tuple& children, std::index_sequence<I...>)
+{
+    (Write<(I != 0)>(out, source, std::get<I>(children)), ...);
+}
+
+template <std::uint32_t Bit, class Node>
+constexpr std::uint32_t SectionBit(const SectionNode<Bit, Node>&)
+{
+    return Bit;
+}
+
+// Writes every section whose bit is set in `sections`. Sections always
+// follow the meta fields, so each one carries a leading comma.
+template <class Source, class... Sections>
+void WriteSections(std::string& out, const Source& source, std::uint32_t sections, const std::tuple<Sections...>& table)
+{
+    std::apply(
+        [&](const auto&... section) {
+            (
+                [&] {
+                    if (sections & SectionBit(section)) {
+                        Write<true>(out, source, section.node);
+                    }
+                }(),
+                ...);
+        },
+        table);
+}
+
+// Positional encoding (schemaVersion 2): the same table with object keys
+// replaced by declaration order. Objects become arrays, arrays of rows become
+// arrays of arrays, and only the section keys remain so deltas can still omit
+// sections. The view maps positions back to keys with the key table below.
+template <class Node>
+struct NodeKey;
+
+template <Name Key, class Getter>
+struct NodeKey<FieldNode<Key, Getter>> {
+    static constexpr auto value = Key;
+};
+
+template <Name Key, class TextGetter, class IdGetter>
+struct NodeKey<NameRefNode<Key, TextGetter, IdGetter>> {
+    static constexpr auto value = Key;
+};
+
+template <Name Key, class... Children>
+struct NodeKey<ObjectNode<Key, Children...>> {
+    static constexpr auto value = Key;
+};
+
+template <Name Key, class Getter, class... Columns>
+struct NodeKey<ArrayNode<Key, Getter, Columns...>> {
+    static constexpr auto value = Key;
+};
+
+template <class Source, Name Key, class Getter>
+void WritePositional(std::string& out, const Source& source, const FieldNode<Key, Getter>& field)
+{
+    AppendValue(out, field.get(source));
+}
+
+template <class Source, Name Key, class TextGetter, class IdGetter>
+void WritePositional(std::string& out, const Source& source, const NameRefNode<Key, TextGetter, IdGetter>& name)
+{
+    AppendValue(out, std::uint32_t(name.id(source)));
+}
+
+template <class Source, class Tuple, std::size_t... I>
+void WritePositionalChildren(std::string& out, const Source& source, const Tuple& children, std::index_sequence<I...>)
+{
+    out += '[';
+    ((I != 0 ? void(out += ',') : void(), WritePositional(out, source, std::get<I>(children))), ...);
+    out += ']';
+}
+
+template <class Source, Name Key, class... Children>
+void WritePositional(std::string& out, const Source& source, const ObjectNode<Key, Children...>& object)
+{
+    WritePositionalChildren(out, source, object.children, std::index_sequence_for<Children...>{});
+}
+
+template <class Source, Name Key, class Getter, class... Columns>
+void WritePositional(std::string& out, const Source& source, const ArrayNode<Key, Getter, Columns...>& array)
+{
+    out += '[';
+    bool first = true;
+    for (const auto& row : array.get(source)) {
+        if (!first) out += ',';
+        first = false;
+        WritePositionalChildren(out, row, array.columns, std::index_sequence_for<Columns...>{});
+    }
+    out += ']';
+}
+
+template <class Source, class... Sections>
+void WritePositionalSections(std::string& out, const Source& source, std::uint32_t sections, const std::tuple<Sections...>& table)
+{
+    std::apply(
+        [&](const auto&... section) {
+            (
+                [&] {
+                    if (sections & SectionBit(section)) {
+                        using Node = std::remove_cvref_t<decltype(section.node)>;
+                        out += KeyPrefix<NodeKey<Node>::value, true>::value;
+                        WritePositional(out, source, section.node);
+                    }
+                }(),
+                ...);
+        },
+        table);
+}
+
+// Key table entries: ["key","v"] for values, ["key","n"] for name ids,
+// ["key","o",[...]] for objects and ["key","a",[...]] for arrays of rows,
+// children in positional order.
+template <Name Key, class Getter>
+void AppendKeyTableEntry(std::string& out, const FieldNode<Key, Getter>&)
+{
+    out += "[\"";
+    out += Key.View();
+    out += "\",\"v\"]";
+}
+
+template <Name Key, class TextGetter, class IdGetter>
+void AppendKeyTableEntry(std::string& out, const NameRefNode<Key, TextGetter, IdGetter>&)
+{
+    out += "[\"";
+    out += Key.View();
+    out += "\",\"n\"]";
+}
+
+template <class Tuple>
+void AppendKeyTableChildren(std::string& out, const Tuple& children)
+{
+    out += '[';
+    std::apply(
+        [&](const auto&... child) {
+            bool first = true;
+            (
+                [&] {
+                    if (!first) out += ',';
+                    first = false;
+                    AppendKeyTableEntry(out, child);
+                }(),
+                ...);
+        },
+        children);
+    out += ']';
+}
+
+template <Name Key, class... Children>
+void AppendKeyTableEntry(std::string& out, const ObjectNode<Key, Children...>& object)
+{
+    out += "[\"";
+    out += Key.View();
+    out += "\",\"o\",";
+    AppendKeyTableChildren(out, object.children);
+    out += ']';
+}
+
+template <Name Key, class Getter, class... Columns>
+void AppendKeyTableEntry(std::string& out, const ArrayNode<Key, Getter, Columns...>& array)
+{
+    out += "[\"";
+    out += Key.View();
+    out += "\",\"a\",";
+    AppendKeyTableChildren(out, array.columns);
+    out += ']';
+}
+
+template <class Source, Name Key, class Getter>
+void Dump(std::string& out, std::string_view path, const FieldNode<Key, Getter>&)
+{
+    using Value = std::remove_cvref_t<std::invoke_result_t<const Getter&, const Source&>>;
+    out += path;
+    out += Key.View();
+    out += ':';
+    out += JsonTypeName<Value>();
+    out += '\n';
+}
+
+template <class Source, Name Key, class TextGetter, class IdGetter>
+void Dump(std::string& out, std::string_view path, const NameRefNode<Key, TextGetter, IdGetter>&)
+{
+    out += path;
+    out += Key.View();
+    out += ':';
+    out += JsonTypeName<std::string_view>();
+    out += '\n';
+}
+
+template <class Source, Name Key, class... Children>
+void Dump(std::string& out, std::string_view path, const ObjectNode<Key, Children...>& object)
+{
+    const std::string childPath = std::string(path) + std::string(Key.View()) + '.';
+    std::apply([&](const auto&... child) { (Dump<Source>(out, childPath, child), ...); }, object.children);
+}
+
+template <class Source, Name Key, class Getter, class... Columns>
+void Dump(std::string& out, std::string_view path, const ArrayNode<Key, Getter, Columns...>& array)
+{
+    using Rows = std::remove_cvref_t<std::invoke_result_t<const Getter&, const Source&>>;
+    using Row = typename Rows::value_type;
+    const std::string childPath = std::string(path) + std::string(Key.View()) + "[].";
+    std::apply([&](const auto&... column) { (Dump<Row>(out, childPath, column), ...); }, array.columns);
+}
+
+template <class Source, std::uint32_t Bit, class Node>
+void Dump(std::string& out, std::string_view path, const SectionNode<Bit, Node>& section)
+{
+    Dump<Source>(out, path, section.node);
+}
+
+// Compares every value `node` writes in `a` and `b` with
+// `same(key, valueA, valueB)`; names compare by text, arrays by row count
+// and then row by row.
+template <class Source, Name Key, class Getter, class Same>
+bool SameValues(const Source& a, const Source& b, const FieldNode<Key, Getter>& field, const Same& same)
+{
+    return same(Key.View(), field.get(a), field.get(b));
+}
+
+template <class Source, Name Key, class TextGetter, class IdGetter, class Same>
+bool SameValues(const Source& a, const Source& b, const NameRefNode<Key, TextGetter, IdGetter>& name, const Same& same)
+{
+    return same(Key.View(), std::string_view(name.text(a)), std::string_view(name.text(b)));
+}
+
+template <class Source, Name Key, class... Children, class Same>
+bool SameValues(const Source& a, const Source& b, const ObjectNode<Key, Children...>& object, const Same& same)
+{
+    return std::apply(
+        [&](const auto&... child) { return (SameValues(a, b, child, same) && ...); },
+        object.children);
+}
+
+template <class Source, Name Key, class Getter, class... Columns, class Same>
+bool SameValues(const Source& a, const Source& b, const ArrayNode<Key, Getter, Columns...>& array, const Same& same)
+{
+    const auto& rowsA = array.get(a);
+    const auto& rowsB = array.get(b);
+    if (rowsA.size() != rowsB.size()) return false;
+    for (std::size_t i = 0; i < rowsA.size(); ++i) {
+        const bool rowSame = std::apply(
+            [&](const auto&... column) { return (SameValues(rowsA[i], rowsB[i], column, same) && ...); },
+            array.columns);
+        if (!rowSame) return false;
+    }
+    return true;
+}
+
+// Calls `visit(value)` for every value `node` writes, in wire order. Names
+// are visited as text; an array visits its row count (std::uint64_t) before
+// its rows.
+template <class Source, Name Key, class Getter, class Visit>
+void VisitValues(const Source& source, const FieldNode<Key, Getter>& field, Visit& visit)
+{
+    visit(field.get(source));
+}
+
+template <class Source, Name Key, class TextGetter, class IdGetter, class Visit>
+void VisitValues(const Source& source, const NameRefNode<Key, TextGetter, IdGetter>& name, Visit& visit)
+{
+    visit(std::string_view(name.text(source)));
+}
+
+template <class Source, Name Key, class... Children, class Visit>
+void VisitValues(const Source& source, const ObjectNode<Key, Children...>& object, Visit& visit)
+{
+    std::apply([&](const auto&... child) { (VisitValues(source, child, visit), ...); }, object.children);
+}
+
+template <class Source, Name Key, class Getter, class... Columns, class Visit>
+void VisitValues(const Source& source, const ArrayNode<Key, Getter, Columns...>& array, Visit& visit)
+{
+    const auto& rows = array.get(source);
+    visit(static_cast<std::uint64_t>(rows.size()));
+    for (const auto& row : rows) {
+        std::apply([&](const auto&... column) { (VisitValues(row, column, visit), ...); }, array.columns);
+    }
+}
+
+// The section bits whose values differ between `previous` and `current`.
+template <class Source, class... Sections, class Same>
+std::uint32_t DiffSections(const Source& previous, const Source& current, const std::tuple<Sections...>& table, const Same& same)
+{
+    std::uint32_t changed = 0;
+    std::apply(
+        [&](const auto&... section) {
+            ((changed |= (SameValues(previous, current, section.node, same) ? 0u : SectionBit(section))), ...);
+        },
+        table);
+    return changed;
+}
+
+template <class Source, class... Sections, class Visit>
+void VisitSections(const Source& source, const std::tuple<Sections...>& table, Visit& visit)
+{
+    std::apply([&](const auto&... section) { (VisitValues(source, section.node, visit), ...); }, table);
+}
+
+template <class Section>
+struct SectionBitOf;
+
+template <std::uint32_t Bit, class Node>
+struct SectionBitOf<SectionNode<Bit, Node>> {
+    static constexpr std::uint32_t value = Bit;
+};
+
+// The section of `table` whose bit is `Bit`.
+template <std::uint32_t Bit, std::size_t I = 0, class... Sections>
+constexpr const auto& FindSection(const std::tuple<Sections...>& table)
+{
+    static_assert(I < sizeof...(Sections), "no section with this bit");
+    if constexpr (SectionBitOf<std::tuple_element_t<I, std::tuple<Sections...>>>::value == Bit) {
+        return std::get<I>(table);
+    } else {
+        return FindSection<Bit, I + 1>(table);
+    }
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal::StatsSchema
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Single source of truth for the updateStats section layout. Adding a field
+// is one line here; the writer, the section diff, the payload fingerprint
+// and the schema dump pick it up automatically.
+// Keep docs/stats-payload-schema.md and view/src/types/stats.ts in sync; the
+// contract tests diff them against this table.
+inline constexpr auto kStatsPayloadSchema = std::tuple{
+    StatsSchema::Section<kStatsSectionResistances>(StatsSchema::Object<"resistances">(
+        StatsSchema::Field<"magic">([](const StatsPayload& p) { return p.resistances.magic.effective; }),
+        StatsSchema::Field<"fire">([](const StatsPayload& p) { return p.resistances.fire.effective; }),
+        StatsSchema::Field<"frost">([](const StatsPayload& p) { return p.resistances.frost.effective; }),
+        StatsSchema::Field<"shock">([](const StatsPayload& p) { return p.resistances.shock.effective; }),
+        StatsSchema::Field<"poison">([](const StatsPayload& p) { return p.resistances.poison.effective; }),
+        StatsSchema::Field<"disease">([](const StatsPayload& p) { return p.resistances.disease.effective; }))),
+    StatsSchema::Section<kStatsSectionDefense>(StatsSchema::Object<"defense">(
+        StatsSchema::Field<"armorRating">([](const StatsPayload& p) { return p.defense.armorRating; }),
+        StatsSchema::Field<"damageReduction">([](const StatsPayload& p) { return p.defense.effectiveDamageReduction; }))),
+    StatsSchema::Section<kStatsSectionOffense>(StatsSchema::Object<"offense">(
+        StatsSchema::Field<"rightHandDamage">([](const StatsPayload& p) { return p.offense.rightHandDamage; }),
+        StatsSchema::Field<"leftHandDamage">([](const StatsPayload& p) { return p.offense.leftHandDamage; }),
+        StatsSchema::Field<"critChance">([](const StatsPayload& p) { return p.offense.critChance.effective; }))),
+    StatsSchema::Section<kStatsSectionCalcMeta>(StatsSchema::Object<"calcMeta">(
+        StatsSchema::Object<"rawResistances">(
+            StatsSchema::Field<"magic">([](const StatsPayload& p) { return p.resistances.magic.raw; }),
+            StatsSchema::Field<"fire">([](const StatsPayload& p) { return p.resistances.fire.raw; }),
+            StatsSchema::Field<"frost">([](const StatsPayload& p) { return p.resistances.frost.raw; }),
+            StatsSchema::Field<"shock">([](const StatsPayload& p) { return p.resistances.shock.raw; }),
+            StatsSchema::Field<"poison">([](const StatsPayload& p) { return p.resistances.poison.raw; }),
+            StatsSchema::Field<"disease">([](const StatsPayload& p) { return p.resistances.disease.raw; })),
+        StatsSchema::Field<"rawCritChance">([](const StatsPayload& p) { return p.offense.critChance.raw; }),
+        StatsSchema::Field<"rawDamageReduction">([](const StatsPayload& p) { return p.defense.rawDamageReduction; }),
+        StatsSchema::Field<"armorCapForMaxReduction">([](const StatsPayload& p) { return p.caps.armorRatingForMaxReduction; }),
+        StatsSchema::Object<"caps">(
+            StatsSchema::Field<"elementalResist">([](const StatsPayload& p) { return p.caps.elementalResist; }),
+            StatsSchema::Field<"elementalResistMin">([](const StatsPayload&) { return kElementalResistMin; }),
+            StatsSchema::Field<"diseaseResist">([](const StatsPayload&) { return kDiseaseResistCap; }),
+            StatsSchema::Field<"diseaseResistMin">([](const StatsPayload&) { return kDiseaseResistMin; }),
+            StatsSchema::Field<"critChance">([](const StatsPayload&) { return kCritChanceCap; }),
+            StatsSchema::Field<"damageReduction">([](const StatsPayload& p) { return p.caps.damageReduction; })),
+        StatsSchema::Object<"flags">(
+            StatsSchema::Field<"anyResistanceClamped">([](const StatsPayload& p) { return p.resistances.anyClamped; }),
+            StatsSchema::Field<"critChanceClamped">([](const StatsPayload& p) { return p.offense.critChance.clamped; }),
+            StatsSchema::Field<"damageReductionClamped">([](const StatsPayload& p) { return p.defense.damageReductionClamped; })))),
+    StatsSchema::Section<kStatsSectionEquipped>(StatsSchema::Object<"equipped">(
+        StatsSchema::NameRef<"rightHand">(
+            [](const StatsPayload& p) { return p.equipped.rightHand; },
+            [](const StatsPayload& p) { return p.equipped.rightHandNameId; }),
+        StatsSchema::NameRef<"leftHand">(
+            [](const StatsPayload& p) { return p.equipped.leftHand; },
+            [](const StatsPayload& p) { return p.equipped.leftHandNameId; }))),
+    StatsSchema::Section<kStatsSectionMovement>(StatsSchema::Object<"movement">(
+        StatsSchema::Field<"speedMult">([](const StatsPayload& p) { return p.movement.speedMult; }))),
+    StatsSchema::Section<kStatsSectionTime>(StatsSchema::Object<"time">(
+        StatsSchema::Field<"year">([](const StatsPayload& p) { return p.time.year; }),
+        StatsSchema::Field<"month">([](const StatsPayload& p) { return p.time.month; }),
+        StatsSchema::Field<"day">([](const StatsPayload& p) { return p.time.day; }),
+        StatsSchema::Field<"hour">([](const StatsPayload& p) { return p.time.hour; }),
+        StatsSchema::Field<"minute">([](const StatsPayload& p) { return p.time.minute; }),
+        StatsSchema::Field<"monthName">([](const StatsPayload& p) -> std::string_view { return p.time.monthName; }),
+        StatsSchema::Field<"timeScale">([](const StatsPayload& p) { return p.time.timeScale; }))),
+    StatsSchema::Section<kStatsSectionPlayerInfo>(StatsSchema::Object<"playerInfo">(
+        StatsSchema::Field<"level">([](const StatsPayload& p) { return p.playerInfo.level; }),
+        StatsSchema::Field<"experience">([](const StatsPayload& p) { return p.playerInfo.experience; }),
+        StatsSchema::Field<"expToNextLevel">([](const StatsPayload& p) { return p.playerInfo.expToNextLevel; }),
+        StatsSchema::Field<"nextLevelTotalXp">([](const StatsPayload& p) { return p.playerInfo.nextLevelTotalXp; }),
+        StatsSchema::Field<"expectedLevelThreshold">([](const StatsPayload& p) { return p.playerInfo.expectedLevelThreshold; }),
+        StatsSchema::Field<"gold">([](const StatsPayload& p) { return p.playerInfo.gold; }),
+        StatsSchema::Field<"carryWeight">([](const StatsPayload& p) { return p.playerInfo.carryWeight; }),
+        StatsSchema::Field<"maxCarryWeight">([](const StatsPayload& p) { return p.playerInfo.maxCarryWeight; }),
+        StatsSchema::Field<"health">([](const StatsPayload& p) { return p.playerInfo.health; }),
+        StatsSchema::Field<"magicka">([](const StatsPayload& p) { return p.playerInfo.magicka; }),
+        StatsSchema::Field<"stamina">([](const StatsPayload& p) { return p.playerInfo.stamina; }),
+        StatsSchema::Field<"ammoCount">([](const StatsPayload& p) { return p.playerInfo.ammoCount; }),
+        StatsSchema::Field<"healthPotionCount">([](const StatsPayload& p) { return p.playerInfo.healthPotionCount; }),
+        StatsSchema::Field<"magickaPotionCount">([](const StatsPayload& p) { return p.playerInfo.magickaPotionCount; }),
+        StatsSchema::Field<"staminaPotionCount">([](const StatsPayload& p) { return p.playerInfo.staminaPotionCount; }))),
+    StatsSchema::Section<kStatsSectionAlertData>(StatsSchema::Object<"alertData">(
+        StatsSchema::Field<"healthPct">([](const StatsPayload& p) { return p.alertData.healthPct; }),
+        StatsSchema::Field<"magickaPct">([](const StatsPayload& p) { return p.alertData.magickaPct; }),
+        StatsSchema::Field<"staminaPct">([](const StatsPayload& p) { return p.alertData.staminaPct; }),
+        StatsSchema::Field<"carryPct">([](const StatsPayload& p) { return p.alertData.carryPct; }))),
+    StatsSchema::Section<kStatsSectionTimedEffects>(StatsSchema::Array<"timedEffects">(
+        [](const StatsPayload& p) -> const std::vector<TimedEffectEntry>& { return p.timedEffects; },
+        StatsSchema::Field<"instanceId">([](const TimedEffectEntry& e) { return e.instanceId; }),
+        StatsSchema::NameRef<"sourceName">(
+            [](const TimedEffectEntry& e) { return e.sourceName; },
+            [](const TimedEffectEntry& e) { return e.sourceNameId; }),
+        StatsSchema::NameRef<"effectName">(
+            [](const TimedEffectEntry& e) { return e.effectName; },
+            [](const TimedEffectEntry& e) { return e.effectNameId; }),
+        StatsSchema::Field<"remainingSec">([](const TimedEffectEntry& e) { return e.remainingSec; }),
+        StatsSchema::Field<"totalSec">([](const TimedEffectEntry& e) { return e.totalSec; }),
+        StatsSchema::Field<"isDebuff">([](const TimedEffectEntry& e) { return e.isDebuff; }),
+        StatsSchema::Field<"sourceFormId">([](const TimedEffectEntry& e) { return e.sourceFormId; }),
+        StatsSchema::Field<"effectFormId">([](const TimedEffectEntry& e) { return e.effectFormId; }),
+        StatsSchema::Field<"spellFormId">([](const TimedEffectEntry& e) { return e.spellFormId; }))),
+    StatsSchema::Section<kStatsSectionCombat>(
+        StatsSchema::Field<"isInCombat">([](const StatsPayload& p) { return p.inCombat; })),
+};
+
+// Sent to the view once per DOM load so it can decode positional payloads:
+// {"schemaVersion":2,"sections":[<entry>,...]} in section order.
+inline std::string BuildStatsKeyTableJson()
+{
+    std::string out = "{\"schemaVersion\":";
+    JsonUtils::AppendInteger(out, kStatsSchemaVersionPositional);
+    out += ",\"sections\":[";
+    std::apply(
+        [&](const auto&... section) {
+            bool first = true;
+            (
+                [&] {
+                    if (!first) out += ',';
+                    first = false;
+                    StatsSchema::AppendKeyTableEntry(out, section.node);
+                }(),
+                ...);
+        },
+        kStatsPayloadSchema);
+    out += "]}";
+    return out;
+}
+
+// One `path:type` line per wire field, meta fields first, e.g.
+// `timedEffects[].sourceName:string`.
+inline std::string DumpStatsPayloadSchema()
+{
+    std::string out =
+        "schemaVersion:number\n"
+        "seq:number\n"
+        "keyframe:boolean\n"
+        "baseSeq:number\n";
+    std::apply(
+        [&](const auto&... section) { (StatsSchema::Dump<StatsPayload>(out, {}, section), ...); },
+        kStatsPayloadSchema);
+    return out;
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,53 @@
+#include "StatsScratch.h"
+#include "JsonUtils.h"
+#include <algorithm>
+#include <cstring>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+void StatsScratch::Reset() noexcept
+{
+    chunkIndex_ = 0;
+    used_ = 0;
+}
+
+std::string_view StatsScratch::Store(std::string_view text)
+{
+    if (text.empty()) {
+        return {};
+    }
+    char* data = Allocate(text.size());
+    std::memcpy(data, text.data(), text.size());
+    return { data, text.size() };
+}
+
+std::string_view StatsScratch::StoreDisplayText(std::string_view text)
+{
+    if (text.empty()) {
+        return {};
+    }
+    char* data = Allocate(text.size());
+    std::memcpy(data, text.data(), text.size());
+    return { data, JsonUtils::NormalizeDisplayText(data, text.size()) };
+}
+
+char* StatsScratch::Allocate(std::size_t size)
+{
+    while (chunkIndex_ < chunks_.size()) {
+        auto& chunk = chunks_[chunkIndex_];
+        if (chunk.size - used_ >= size) {
+            char* data = chunk.data.get() + used_;
+            used_ += size;
+            return data;
+        }
+        ++chunkIndex_;
+        used_ = 0;
+    }
+
+    const auto chunkSize = (std::max)(kChunkSize, size);
+    chunks_.push_back(Chunk{ std::make_unique_for_overwrite<char[]>(chunkSize), chunkSize });
+    used_ = size;
+    return chunks_.back().data.get();
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
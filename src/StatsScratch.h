@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Per-capture string storage for the name fields of StatsPayload. Reset()
+// rewinds without releasing chunks, so once the high-water mark is reached a
+// capture no longer allocates. Views returned by Store*() stay valid until
+// the next Reset(); growing never moves existing chunks.
+class StatsScratch {
+public:
+    void Reset() noexcept;
+    std::string_view Store(std::string_view text);
+    // Store() followed by JsonUtils::NormalizeDisplayText on the copy.
+    std::string_view StoreDisplayText(std::string_view text);
+
+private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    char* Allocate(std::size_t size);
+
+    static constexpr std::size_t kChunkSize = 4096;
+
+    std::vector<Chunk> chunks_{};
+    std::size_t chunkIndex_{ 0 };
+    std::size_t used_{ 0 };
+};
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
@@ -0,0 +1,182 @@
+#include "TimedEffectTable.h"
+#include "JsonUtils.h"
+
+#include <algorithm>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+void TimedEffectSources::BeginPass() noexcept
+{
+    ++pass_;
+}
+
+const TimedEffectInfo* TimedEffectSources::Find(std::int32_t instanceId) noexcept
+{
+    const auto it = sources_.find(instanceId);
+    if (it == sources_.end()) return nullptr;
+    it->second.seenPass = pass_;
+    return &it->second.info;
+}
+
+const TimedEffectInfo& TimedEffectSources::Insert(const TimedEffectInfo& info)
+{
+    auto& source = sources_[info.instanceId];
+    source.sourceName.assign(info.sourceName);
+    source.effectName.assign(info.effectName);
+    source.info = info;
+    source.info.sourceName = source.sourceName;
+    source.info.effectName = source.effectName;
+    source.info.serial = ++nextSerial_;
+    source.seenPass = pass_;
+    return source.info;
+}
+
+void TimedEffectSources::EndPass()
+{
+    const auto pass = pass_;
+    std::erase_if(sources_, [pass](const auto& item) { return item.second.seenPass != pass; });
+}
+
+void TimedEffectSources::Remove(std::int32_t instanceId)
+{
+    sources_.erase(instanceId);
+}
+
+void TimedEffectSources::Clear()
+{
+    sources_.clear();
+}
+
+void TimedEffectTable::Apply(const std::vector<TimedEffectRow>& rows)
+{
+    BeginPass();
+    for (const auto& row : rows) {
+        const auto it = entries_.find(row.info.instanceId);
+        if (it != entries_.end() && it->second.serial == row.info.serial) {
+            auto& entry = it->second;
+            entry.remainingSec = row.remainingSec;
+            entry.totalSec = row.totalSec;
+            entry.seenPass = pass_;
+            continue;
+        }
+        Insert(row.info, row.remainingSec, row.totalSec);
+    }
+    EndPass();
+}
+
+void TimedEffectTable::BeginPass() noexcept
+{
+    ++pass_;
+}
+
+bool TimedEffectTable::Update(std::int32_t instanceId, std::int32_t remainingSec, std::int32_t totalSec) noexcept
+{
+    const auto it = entries_.find(instanceId);
+    if (it == entries_.end()) return false;
+
+    auto& entry = it->second;
+    entry.remainingSec = remainingSec;
+    entry.totalSec = totalSec;
+    entry.seenPass = pass_;
+    return true;
+}
+
+void TimedEffectTable::Insert(const TimedEffectInfo& info, std::int32_t remainingSec, std::int32_t totalSec)
+{
+    std::string sourceName(info.sourceName);
+    std::string effectName(info.effectName);
+    JsonUtils::NormalizeDisplayText(sourceName);
+    JsonUtils::NormalizeDisplayText(effectName);
+    // Instances without any name are not listed; they are kept so the next
+    // pass does not resolve them again.
+    if (sourceName.empty()) sourceName = effectName;
+    if (effectName.empty()) effectName = sourceName;
+
+    auto [it, inserted] = entries_.try_emplace(info.instanceId);
+    auto& entry = it->second;
+    entry.instanceId = info.instanceId;
+    entry.sourceName = std::move(sourceName);
+    entry.effectName = std::move(effectName);
+    entry.remainingSec = remainingSec;
+    entry.totalSec = totalSec;
+    entry.isDebuff = info.isDebuff;
+    entry.sourceFormId = info.sourceFormId;
+    entry.effectFormId = info.effectFormId;
+    entry.spellFormId = info.spellFormId;
+    entry.serial = info.serial;
+    entry.nameEpoch = 0;
+    entry.seenPass = pass_;
+    if (inserted) {
+        order_.push_back(&entry);
+    }
+}
+
+void TimedEffectTable::EndPass()
+{
+    const auto pass = pass_;
+    std::erase_if(order_, [pass](const Entry* entry) { return entry->seenPass != pass; });
+    std::erase_if(entries_, [pass](const auto& item) { return item.second.seenPass != pass; });
+    RestoreOrder();
+}
+
+void TimedEffectTable::Clear()
+{
+    order_.clear();
+    entries_.clear();
+}
+
+void TimedEffectTable::Emit(std::vector<TimedEffectEntry>& out, StatsScratch& strings, StatsNameTable& names)
+{
+    for (auto* entry : order_) {
+        if (entry->sourceName.empty()) continue;
+
+        const auto sourceName = strings.Store(entry->sourceName);
+        const auto effectName = strings.Store(entry->effectName);
+        if (entry->nameEpoch != names.Epoch()) {
+            entry->sourceNameId = names.Intern(sourceName);
+            entry->effectNameId = names.Intern(effectName);
+            entry->nameEpoch = names.Epoch();
+        }
+        out.push_back(TimedEffectEntry{
+            entry->instanceId,
+            sourceName,
+            effectName,
+            entry->remainingSec,
+            entry->totalSec,
+            entry->isDebuff,
+            entry->sourceFormId,
+            entry->effectFormId,
+            entry->spellFormId,
+            entry->sourceNameId,
+            entry->effectNameId
+        });
+    }
+}
+
+bool TimedEffectTable::DisplaysBefore(const Entry* a, const Entry* b) noexcept
+{
+    if (a->remainingSec != b->remainingSec) return a->remainingSec < b->remainingSec;
+    if (a->isDebuff != b->isDebuff) return a->isDebuff && !b->isDebuff;
+    if (a->sourceName != b->sourceName) return a->sourceName < b->sourceName;
+    if (a->effectName != b->effectName) return a->effectName < b->effectName;
+    if (a->effectFormId != b->effectFormId) return a->effectFormId < b->effectFormId;
+    if (a->sourceFormId != b->sourceFormId) return a->sourceFormId < b->sourceFormId;
+    if (a->spellFormId != b->spellFormId) return a->spellFormId < b->spellFormId;
+    return a->instanceId < b->instanceId;
+}
+
+void TimedEffectTable::RestoreOrder() noexcept
+{
+    // Countdowns mostly tick down together, so each entry moves at most a
+    // few places and this stays close to a single linear scan.
+    for (std::size_t i = 1; i < order_.size(); ++i) {
+        auto* entry = order_[i];
+        std::size_t j = i;
+        for (; j > 0 && DisplaysBefore(entry, order_[j - 1]); --j) {
+            order_[j] = order_[j - 1];
+        }
+        order_[j] = entry;
+    }
+}
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
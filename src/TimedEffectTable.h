@@ -0,0 +1,124 @@
+#pragma once
+
+#include "StatsNameTable.h"
+#include "StatsPayload.h"
+#include "StatsScratch.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// What an active effect contributes when it first shows up. Names are raw
+// engine text; the table normalizes and stores its own copies.
+struct TimedEffectInfo {
+    std::int32_t instanceId{0};
+    std::string_view sourceName{};
+    std::string_view effectName{};
+    bool isDebuff{false};
+    std::uint32_t sourceFormId{0};
+    std::uint32_t effectFormId{0};
+    std::uint32_t spellFormId{0};
+    // Set by TimedEffectSources; changes whenever the instance is resolved
+    // again, e.g. because its id was handed to a new effect.
+    std::uint32_t serial{0};
+};
+
+// One visible instance as a capture saw it. Names point into the capture's
+// scratch; the table only reads them when `info.serial` is new to it.
+struct TimedEffectRow {
+    TimedEffectInfo info{};
+    std::int32_t remainingSec{0};
+    std::int32_t totalSec{0};
+};
+
+// Game-thread side of the timed effects: what each visible instance
+// resolved to, so names and form ids are read from the engine once per
+// instance. Passes work as in TimedEffectTable, without ordering.
+class TimedEffectSources {
+public:
+    void BeginPass() noexcept;
+    // Info of a known instance, marked seen; nullptr when it is unknown.
+    const TimedEffectInfo* Find(std::int32_t instanceId) noexcept;
+    // Stores copies of the names and assigns a new serial.
+    const TimedEffectInfo& Insert(const TimedEffectInfo& info);
+    void EndPass();
+
+    // Drops an instance right away, e.g. on an effect-removed event, since
+    // its id can be handed to a new effect before the next pass.
+    void Remove(std::int32_t instanceId);
+    void Clear();
+    std::size_t Size() const noexcept { return sources_.size(); }
+
+private:
+    struct Source {
+        std::string sourceName{};
+        std::string effectName{};
+        // Names view the strings above; nodes never move.
+        TimedEffectInfo info{};
+        std::uint32_t seenPass{0};
+    };
+
+    std::unordered_map<std::int32_t, Source> sources_{};
+    std::uint32_t pass_{0};
+    std::uint32_t nextSerial_{0};
+};
+
+// Timed effects on the player keyed by ActiveEffect::usUniqueID. Names and
+// form ids are resolved once per instance; later passes only move the
+// countdown, and the display order is repaired with an insertion sort since
+// it barely changes between ticks. Reads after warm-up do not allocate.
+//
+// A pass is BeginPass(), Update() for every visible instance (Insert() when
+// Update() reports it unknown), then EndPass(), which drops instances the
+// pass did not see. Apply() runs one for the rows of a capture.
+class TimedEffectTable {
+public:
+    // One pass over `rows`; an instance whose serial changed is inserted
+    // again with the row's names.
+    void Apply(const std::vector<TimedEffectRow>& rows);
+    void BeginPass() noexcept;
+    // Refreshes a known instance; false when it is not in the table.
+    bool Update(std::int32_t instanceId, std::int32_t remainingSec, std::int32_t totalSec) noexcept;
+    void Insert(const TimedEffectInfo& info, std::int32_t remainingSec, std::int32_t totalSec);
+    void EndPass();
+
+    void Clear();
+    std::size_t Size() const noexcept { return order_.size(); }
+
+    // Appends the entries in display order: shortest remaining first, then
+    // debuffs, then by names and form ids. Names are copied into `strings`;
+    // ids come from `names` and are cached per name table epoch.
+    void Emit(std::vector<TimedEffectEntry>& out, StatsScratch& strings, StatsNameTable& names);
+
+private:
+    struct Entry {
+        std::int32_t instanceId{0};
+        std::string sourceName{};
+        std::string effectName{};
+        std::int32_t remainingSec{0};
+        std::int32_t totalSec{0};
+        bool isDebuff{false};
+        std::uint32_t sourceFormId{0};
+        std::uint32_t effectFormId{0};
+        std::uint32_t spellFormId{0};
+        std::uint32_t serial{0};
+        std::uint32_t sourceNameId{0};
+        std::uint32_t effectNameId{0};
+        std::uint32_t nameEpoch{0};
+        std::uint32_t seenPass{0};
+    };
+
+    static bool DisplaysBefore(const Entry* a, const Entry* b) noexcept;
+    void RestoreOrder() noexcept;
+
+    // Node-based, so order_ can point at the entries.
+    std::unordered_map<std::int32_t, Entry> entries_{};
+    std::vector<Entry*> order_{};
+    std::uint32_t pass_{0};
+};
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
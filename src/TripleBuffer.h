@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace TulliusWidgets::StatsCollectorInternal {
+
+// Hands the newest complete snapshot from one producer thread to one
+// consumer thread. Each side owns one of three slots and trades it with the
+// shared middle slot in a single atomic exchange, so neither side waits,
+// locks or copies. A snapshot the consumer has not picked up yet is
+// replaced by the next Publish(); intermediate snapshots are dropped.
+// Slots keep their contents (and capacity) when they change hands, so the
+// producer must overwrite every field it cares about.
+template <class T>
+class TripleBuffer {
+public:
+    // Producer: the slot to fill. Stays the producer's until Publish().
+    T& WriteSlot() noexcept { return slots_[writeIndex_]; }
+
+    // Producer: makes the filled slot the newest snapshot and takes the
+    // previous middle slot (possibly an unread snapshot) for the next write.
+    void Publish() noexcept
+    {
+        const auto previous = middle_.exchange(
+            static_cast<std::uint8_t>(writeIndex_ | kFreshBit), std::memory_order_acq_rel);
+        writeIndex_ = previous & kIndexMask;
+    }
+
+    // Consumer: switches ReadSlot() to the newest published snapshot; false
+    // when nothing was published since the last switch.
+    bool Acquire() noexcept
+    {
+        if (!(middle_.load(std::memory_order_acquire) & kFreshBit)) {
+            return false;
+        }
+        const auto previous = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previous & kIndexMask;
+        return true;
+    }
+
+    // Consumer: the last acquired snapshot. Stays the consumer's until the
+    // next Acquire().
+    T& ReadSlot() noexcept { return slots_[readIndex_]; }
+
+private:
+    static constexpr std::uint8_t kIndexMask = 0x3;
+    static constexpr std::uint8_t kFreshBit = 0x4;
+
+    std::array<T, 3> slots_{};
+    // Index of the middle slot, plus kFreshBit while it holds a snapshot
+    // the consumer has not acquired.
+    alignas(64) std::atomic<std::uint8_t> middle_{ 1 };
+    alignas(64) std::uint8_t writeIndex_{ 0 };
+    alignas(64) std::uint8_t readIndex_{ 2 };
+};
+
+}  // namespace TulliusWidgets::StatsCollectorInternal
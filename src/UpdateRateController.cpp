@@ -0,0 +1,106 @@
+#include "UpdateRateController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace TulliusWidgets::WidgetRuntime {
+namespace {
+
+using Milliseconds = std::chrono::milliseconds;
+
+// How far a bar may move between two updates, in percentage points, before
+// the movement stops looking smooth.
+constexpr float kPercentPerUpdate = 1.0f;
+// A timed effect appearing or leaving, or combat starting or ending, counts
+// like a change of this many points.
+constexpr float kStepChangePct = 10.0f;
+// Time constant of the change rate's decay once values stop moving.
+constexpr float kVelocityDecaySeconds = 1.0f;
+// The interval only follows a target that is more than this factor away.
+constexpr float kIntervalHysteresis = 1.25f;
+
+Milliseconds ClampInterval(Milliseconds interval)
+{
+    return std::clamp(interval, kMinUpdateIntervalLimit, kMaxUpdateIntervalLimit);
+}
+
+float LargestChange(const UpdateRateSample& from, const UpdateRateSample& to)
+{
+    const float vitals = (std::max)({
+        std::fabs(to.healthPct - from.healthPct),
+        std::fabs(to.magickaPct - from.magickaPct),
+        std::fabs(to.staminaPct - from.staminaPct),
+        std::fabs(to.carryPct - from.carryPct),
+    });
+    const auto effects = to.timedEffectCount > from.timedEffectCount
+        ? to.timedEffectCount - from.timedEffectCount
+        : from.timedEffectCount - to.timedEffectCount;
+    const float steps = static_cast<float>(effects) + (to.inCombat != from.inCombat ? 1.0f : 0.0f);
+    const float change = vitals + steps * kStepChangePct;
+    return std::isfinite(change) ? change : 0.0f;
+}
+
+}  // namespace
+
+UpdateRateBounds ClampUpdateRateBounds(UpdateRateBounds bounds) noexcept
+{
+    bounds.minInterval = ClampInterval(bounds.minInterval);
+    bounds.maxInterval = (std::max)(ClampInterval(bounds.maxInterval), bounds.minInterval);
+    return bounds;
+}
+
+void UpdateRateController::SetBounds(UpdateRateBounds bounds) noexcept
+{
+    bounds_ = ClampUpdateRateBounds(bounds);
+    interval_ = std::clamp(interval_, bounds_.minInterval, bounds_.maxInterval);
+}
+
+void UpdateRateController::Observe(const UpdateRateSample& sample, Clock::time_point now) noexcept
+{
+    if (!hasSample_) {
+        last_ = sample;
+        lastTime_ = now;
+        hasSample_ = true;
+        return;
+    }
+
+    const float seconds = std::chrono::duration<float>(now - lastTime_).count();
+    if (seconds <= 0.0f) {
+        // Same instant (or a clock step back): fold the change into the
+        // next sample instead of dividing by zero.
+        return;
+    }
+
+    const float rate = LargestChange(last_, sample) / seconds;
+    if (rate >= velocity_) {
+        velocity_ = rate;
+    } else {
+        velocity_ = rate + (velocity_ - rate) * std::exp(-seconds / kVelocityDecaySeconds);
+    }
+    last_ = sample;
+    lastTime_ = now;
+
+    // Aim for kPercentPerUpdate of movement per update.
+    const float targetMs = velocity_ > 0.0f
+        ? 1000.0f * kPercentPerUpdate / velocity_
+        : static_cast<float>(bounds_.maxInterval.count());
+    const auto target = std::clamp(
+        Milliseconds(static_cast<Milliseconds::rep>((std::min)(targetMs, static_cast<float>(kMaxUpdateIntervalLimit.count())))),
+        bounds_.minInterval,
+        bounds_.maxInterval);
+    const auto current = static_cast<float>(interval_.count());
+    const auto next = static_cast<float>(target.count());
+    if (next * kIntervalHysteresis < current || next > current * kIntervalHysteresis
+        || target == bounds_.minInterval || target == bounds_.maxInterval) {
+        interval_ = target;
+    }
+}
+
+void UpdateRateController::Reset() noexcept
+{
+    hasSample_ = false;
+    velocity_ = 0.0f;
+    interval_ = bounds_.minInterval;
+}
+
+}  // namespace TulliusWidgets::WidgetRuntime
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace TulliusWidgets::WidgetRuntime {
+
+inline constexpr std::chrono::milliseconds kDefaultMinUpdateInterval{ 33 };
+inline constexpr std::chrono::milliseconds kDefaultMaxUpdateInterval{ 2000 };
+// Accepted range of each bound.
+inline constexpr std::chrono::milliseconds kMinUpdateIntervalLimit{ 16 };
+inline constexpr std::chrono::milliseconds kMaxUpdateIntervalLimit{ 10000 };
+
+struct UpdateRateBounds {
+    std::chrono::milliseconds minInterval{ kDefaultMinUpdateInterval };
+    std::chrono::milliseconds maxInterval{ kDefaultMaxUpdateInterval };
+};
+
+// The values whose movement sets the update rate, as read by one capture.
+// Vitals and carry weight are in percent of their maximum.
+struct UpdateRateSample {
+    float healthPct{ 100.0f };
+    float magickaPct{ 100.0f };
+    float staminaPct{ 100.0f };
+    float carryPct{ 0.0f };
+    std::uint32_t timedEffectCount{ 0 };
+    bool inCombat{ false };
+};
+
+// Clamps both bounds into the accepted range and keeps max >= min.
+UpdateRateBounds ClampUpdateRateBounds(UpdateRateBounds bounds) noexcept;
+
+// Picks the interval between throttled stats updates from how fast the key
+// values move. The change rate jumps up as soon as a capture sees it and
+// decays over about a second once values settle, and the interval only
+// moves when the new target leaves a band around the current one, so a
+// steady drain does not make the rate flap. Not thread-safe.
+class UpdateRateController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Clamps `bounds` and pulls the current interval into them.
+    void SetBounds(UpdateRateBounds bounds) noexcept;
+    const UpdateRateBounds& Bounds() const noexcept { return bounds_; }
+
+    // Feeds the values a capture read at `now`.
+    void Observe(const UpdateRateSample& sample, Clock::time_point now) noexcept;
+    // Forgets the last sample; the next one starts over at the fastest rate.
+    void Reset() noexcept;
+
+    std::chrono::milliseconds Interval() const noexcept { return interval_; }
+    // Smoothed change rate in percentage points per second.
+    float Velocity() const noexcept { return velocity_; }
+    // Whether the last sample was taken in combat; a flip warrants a capture
+    // regardless of the interval.
+    bool LastInCombat() const noexcept { return hasSample_ && last_.inCombat; }
+
+private:
+    UpdateRateBounds bounds_{};
+    UpdateRateSample last_{};
+    Clock::time_point lastTime_{};
+    bool hasSample_{ false };
+    float velocity_{ 0.0f };
+    std::chrono::milliseconds interval_{ kDefaultMinUpdateInterval };
+};
+
+}  // namespace TulliusWidgets::WidgetRuntime
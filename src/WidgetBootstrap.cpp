@@ -1,47 +1,43 @@
 #include "WidgetBootstrap.h"
-
-#include <utility>
+#include "GameTaskQueue.h"
 
 namespace TulliusWidgets::WidgetBootstrap {
 namespace {
 
 Callbacks g_callbacks{};
 
-template <class Fn>
-void DispatchToGameThread(Fn&& fn)
+void FinishViewDomReady(const GameTask& task)
 {
-    if (auto* taskInterface = SKSE::GetTaskInterface()) {
-        taskInterface->AddTask(std::forward<Fn>(fn));
-        return;
+    const auto view = static_cast<PrismaView>(task.a);
+    logger::info("TulliusWidgets view ready (id: {})", view);
+
+    if (g_callbacks.setView) {
+        g_callbacks.setView(view);
+    }
+    if (g_callbacks.setViewDomReady) {
+        g_callbacks.setViewDomReady(true);
+    }
+    if (g_callbacks.sendRuntimeDiagnostics) {
+        g_callbacks.sendRuntimeDiagnostics();
+    }
+    if (g_callbacks.sendHUDColor) {
+        g_callbacks.sendHUDColor();
+    }
+    if (g_callbacks.sendSettings) {
+        g_callbacks.sendSettings();
+    }
+    if (g_callbacks.sendStatsSchema) {
+        g_callbacks.sendStatsSchema();
+    }
+    if (g_callbacks.sendStatsForced) {
+        g_callbacks.sendStatsForced();
     }
-    std::forward<Fn>(fn)();
 }
 
+// PrismaUI calls this off the game thread.
 void OnViewDomReady(PrismaView view)
 {
-    const auto callbacks = g_callbacks;
-    DispatchToGameThread([view, callbacks]() {
-        logger::info("TulliusWidgets view ready (id: {})", view);
-
-        if (callbacks.setView) {
-            callbacks.setView(view);
-        }
-        if (callbacks.setViewDomReady) {
-            callbacks.setViewDomReady(true);
-        }
-        if (callbacks.sendRuntimeDiagnostics) {
-            callbacks.sendRuntimeDiagnostics();
-        }
-        if (callbacks.sendHUDColor) {
-            callbacks.sendHUDColor();
-        }
-        if (callbacks.sendSettings) {
-            callbacks.sendSettings();
-        }
-        if (callbacks.sendStatsForced) {
-            callbacks.sendStatsForced();
-        }
-    });
+    GameTaskQueue::GetSingleton().Post(GameTaskKind::kViewDomReady, view);
 }
 
 }  // namespace
@@ -49,6 +45,7 @@ void OnViewDomReady(PrismaView view)
 bool InitializeOnDataLoaded(PRISMA_UI_API::IVPrismaUI1*& prismaUI, const Callbacks& callbacks)
 {
     g_callbacks = callbacks;
+    GameTaskQueue::GetSingleton().SetHandler(GameTaskKind::kViewDomReady, &FinishViewDomReady);
 
     prismaUI = nullptr;
     prismaUI = static_cast<PRISMA_UI_API::IVPrismaUI1*>(
@@ -14,6 +14,7 @@ struct Callbacks {
     void (*sendRuntimeDiagnostics)() = nullptr;
     void (*sendHUDColor)() = nullptr;
     void (*sendSettings)() = nullptr;
+    void (*sendStatsSchema)() = nullptr;
     void (*sendStatsForced)() = nullptr;
     void (*registerJsListeners)() = nullptr;
     void (*registerEventSinks)() = nullptr;
@@ -1,4 +1,6 @@
 #include "WidgetEvents.h"
+#include "GameTaskQueue.h"
+#include "StatsPayload.h"
 #include "WidgetVisibilityState.h"
 
 #include <algorithm>
@@ -7,6 +9,12 @@ namespace TulliusWidgets::WidgetEvents {
 namespace {
 
 using namespace std::literals;
+using namespace TulliusWidgets::StatsCollectorInternal;
+
+// Equipment carries enchantments, so it can move any event-driven section.
+constexpr std::uint32_t kEquipDirtySections = kStatsSectionsEventDriven;
+constexpr std::uint32_t kActiveEffectDirtySections =
+    kStatsSectionResistances | kStatsSectionDefense | kStatsSectionOffense | kStatsSectionCalcMeta;
 
 Callbacks g_callbacks{};
 
@@ -50,18 +58,17 @@ void HideView()
     }
 }
 
+// Sinks may be notified off the game thread (menu events come from the UI
+// thread), so stats requests always go through the game task queue, where
+// repeated ones also merge.
 void SendStats()
 {
-    if (g_callbacks.sendStats) {
-        g_callbacks.sendStats();
-    }
+    GameTaskQueue::GetSingleton().Post(GameTaskKind::kStatsDispatch, 0);
 }
 
 void SendStatsForced()
 {
-    if (g_callbacks.sendStatsForced) {
-        g_callbacks.sendStatsForced();
-    }
+    GameTaskQueue::GetSingleton().Post(GameTaskKind::kStatsDispatch, 1);
 }
 
 void ScheduleStatsUpdateAfter(std::chrono::milliseconds delay)
@@ -71,6 +78,34 @@ void ScheduleStatsUpdateAfter(std::chrono::milliseconds delay)
     }
 }
 
+void MarkStatsDirty(std::uint32_t sections)
+{
+    if (g_callbacks.markStatsDirty) {
+        g_callbacks.markStatsDirty(sections);
+    }
+}
+
+void NoteInventoryChange(std::uint32_t baseFormId, std::int32_t delta)
+{
+    if (g_callbacks.noteInventoryChange) {
+        g_callbacks.noteInventoryChange(baseFormId, delta);
+    }
+}
+
+void ResetInventoryIndex()
+{
+    if (g_callbacks.resetInventoryIndex) {
+        g_callbacks.resetInventoryIndex();
+    }
+}
+
+void NoteTimedEffectRemoved(std::uint32_t instanceId)
+{
+    if (g_callbacks.noteTimedEffectRemoved) {
+        g_callbacks.noteTimedEffectRemoved(instanceId);
+    }
+}
+
 class CombatEventSink : public RE::BSTEventSink<RE::TESCombatEvent> {
 public:
     static CombatEventSink* GetSingleton()
@@ -105,13 +140,8 @@ public:
         if (!event) return RE::BSEventNotifyControl::kContinue;
         auto* actor = event->actor.get();
         if (IsPlayerReference(actor)) {
-            if (auto* taskInterface = SKSE::GetTaskInterface()) {
-                taskInterface->AddTask([]() {
-                    SendStatsForced();
-                });
-            } else {
-                SendStatsForced();
-            }
+            MarkStatsDirty(kEquipDirtySections);
+            SendStatsForced();
             // Follow-up: equipment slot data may lag behind the event by
             // several frames, so schedule a second collection to catch the
             // final state without waiting for the 2-second heartbeat.
@@ -121,6 +151,31 @@ public:
     }
 };
 
+class ContainerChangedEventSink : public RE::BSTEventSink<RE::TESContainerChangedEvent> {
+public:
+    static ContainerChangedEventSink* GetSingleton()
+    {
+        static ContainerChangedEventSink singleton;
+        return &singleton;
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(
+        const RE::TESContainerChangedEvent* event,
+        RE::BSTEventSource<RE::TESContainerChangedEvent>*) override
+    {
+        if (!event || event->itemCount <= 0) return RE::BSEventNotifyControl::kContinue;
+
+        constexpr RE::FormID kPlayerFormId = 0x00000014;
+        const bool gained = event->newContainer == kPlayerFormId;
+        const bool lost = event->oldContainer == kPlayerFormId;
+        if (gained == lost) return RE::BSEventNotifyControl::kContinue;
+
+        NoteInventoryChange(event->baseObj, gained ? event->itemCount : -event->itemCount);
+        SendStats();
+        return RE::BSEventNotifyControl::kContinue;
+    }
+};
+
 class QuestStageEventSink : public RE::BSTEventSink<RE::TESQuestStageEvent> {
 public:
     static QuestStageEventSink* GetSingleton()
@@ -156,6 +211,12 @@ public:
         if (!event) return RE::BSEventNotifyControl::kContinue;
         auto player = RE::PlayerCharacter::GetSingleton();
         if (player && event->target.get() == player) {
+            MarkStatsDirty(kActiveEffectDirtySections);
+            // The instance id can be handed to a new effect right away, so
+            // the cached names must go now rather than on the next pass.
+            if (!event->isApplied) {
+                NoteTimedEffectRemoved(event->activeEffectUniqueID);
+            }
             SendStats();
         }
         return RE::BSEventNotifyControl::kContinue;
@@ -202,6 +263,11 @@ public:
                    && IsGameLoaded()
                    && ui
                    && !WidgetVisibilityState::IsBlockingUiState(ui, HasViewFocus())) {
+            // Smithing, enchanting and perk menus change stats without an
+            // equip or effect event; barter and crafting can move items in
+            // bulk, so the inventory counters are re-seeded as well.
+            MarkStatsDirty(kStatsSectionsEventDriven);
+            ResetInventoryIndex();
             if (ShowView()) {
                 SendStatsForced();
                 ScheduleStatsUpdateAfter(std::chrono::milliseconds(500));
@@ -222,6 +288,7 @@ void RegisterEventSinks(const Callbacks& callbacks)
     if (scriptEventSource) {
         scriptEventSource->AddEventSink(CombatEventSink::GetSingleton());
         scriptEventSource->AddEventSink(EquipEventSink::GetSingleton());
+        scriptEventSource->AddEventSink(ContainerChangedEventSink::GetSingleton());
         scriptEventSource->AddEventSink(ActiveEffectEventSink::GetSingleton());
         scriptEventSource->AddEventSink(QuestStageEventSink::GetSingleton());
         logger::info("Event sinks registered");
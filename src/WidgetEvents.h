@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 namespace TulliusWidgets::WidgetEvents {
 
@@ -11,9 +12,11 @@ struct Callbacks {
     void (*setGameLoaded)(bool) = nullptr;
     bool (*showView)() = nullptr;
     void (*hideView)() = nullptr;
-    void (*sendStats)() = nullptr;
-    void (*sendStatsForced)() = nullptr;
     void (*scheduleStatsUpdateAfter)(std::chrono::milliseconds) = nullptr;
+    void (*markStatsDirty)(std::uint32_t sections) = nullptr;
+    void (*noteInventoryChange)(std::uint32_t baseFormId, std::int32_t delta) = nullptr;
+    void (*resetInventoryIndex)() = nullptr;
+    void (*noteTimedEffectRemoved)(std::uint32_t instanceId) = nullptr;
 };
 
 void RegisterEventSinks(const Callbacks& callbacks);
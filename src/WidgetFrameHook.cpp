@@ -0,0 +1,33 @@
+#include "WidgetFrameHook.h"
+
+namespace TulliusWidgets::WidgetFrameHook {
+namespace {
+
+void (*g_onFrame)() = nullptr;
+
+struct MainUpdateHook {
+    static void Thunk()
+    {
+        Original();
+        if (g_onFrame) {
+            g_onFrame();
+        }
+    }
+
+    static inline REL::Relocation<decltype(Thunk)> Original;
+};
+
+}  // namespace
+
+void Install(void (*onFrame)())
+{
+    g_onFrame = onFrame;
+    REL::Relocation<std::uintptr_t> mainUpdate{ RELOCATION_ID(35565, 36564) };
+    auto& trampoline = SKSE::GetTrampoline();
+    MainUpdateHook::Original = trampoline.write_call<5>(
+        mainUpdate.address() + RELOCATION_OFFSET(0x748, 0xC26),
+        MainUpdateHook::Thunk);
+    logger::info("Frame hook installed");
+}
+
+}  // namespace TulliusWidgets::WidgetFrameHook
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace TulliusWidgets::WidgetFrameHook {
+
+// Calls `onFrame` on the game thread once per main-loop iteration, from the
+// nullsub call in Main::Update. Install once, after SKSE::AllocTrampoline.
+void Install(void (*onFrame)());
+
+}  // namespace TulliusWidgets::WidgetFrameHook
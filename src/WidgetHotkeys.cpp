@@ -1,5 +1,6 @@
 #include "WidgetHotkeys.h"
 
+#include "GameTaskQueue.h"
 #include "WidgetInteropContracts.h"
 #include <keyhandler/keyhandler.h>
 #include <cstdint>
@@ -12,14 +13,9 @@ constexpr std::uint32_t kInsertScanCode = 0xD2;
 constexpr std::uint32_t kEscapeScanCode = 0x01;
 constexpr std::uint32_t kF11ScanCode = 0x57;
 
-template <class Fn>
-void DispatchToGameThread(Fn&& fn)
+void PostGameTask(GameTaskKind kind)
 {
-    if (auto* taskInterface = SKSE::GetTaskInterface()) {
-        taskInterface->AddTask(std::forward<Fn>(fn));
-        return;
-    }
-    std::forward<Fn>(fn)();
+    GameTaskQueue::GetSingleton().Post(kind);
 }
 
 bool IsViewReady()
@@ -58,6 +54,50 @@ bool InvokeScript(const char* script)
     return false;
 }
 
+void ToggleSettingsPanel(const GameTask&)
+{
+    if (!IsViewReady() || !IsGameLoaded()) {
+        return;
+    }
+
+    if (IsSettingsPanelOpen()) {
+        InvokeScript(TulliusWidgets::WidgetInteropContracts::kCloseSettingsScript);
+        UnfocusView();
+        return;
+    }
+
+    if (!InvokeScript(TulliusWidgets::WidgetInteropContracts::kToggleSettingsScript)) {
+        return;
+    }
+
+    // Focus on the next task tick so PrismaUI can finish opening the
+    // settings overlay before it switches the game into cursor mode.
+    PostGameTask(GameTaskKind::kFocusSettingsPanel);
+}
+
+void FocusSettingsPanel(const GameTask&)
+{
+    if (!IsViewReady() || !IsGameLoaded()) {
+        return;
+    }
+    (void)FocusView();
+}
+
+void CloseSettingsPanel(const GameTask&)
+{
+    if (IsViewReady() && IsGameLoaded() && IsSettingsPanelOpen()) {
+        InvokeScript(TulliusWidgets::WidgetInteropContracts::kCloseSettingsScript);
+        UnfocusView();
+    }
+}
+
+void ToggleWidgetsVisibility(const GameTask&)
+{
+    if (IsViewReady() && IsGameLoaded()) {
+        InvokeScript(TulliusWidgets::WidgetInteropContracts::kToggleWidgetsVisibilityScript);
+    }
+}
+
 }  // namespace
 
 void RegisterDefaultHotkeys(const Callbacks& callbacks)
@@ -71,50 +111,23 @@ void RegisterDefaultHotkeys(const Callbacks& callbacks)
         return;
     }
 
+    auto& tasks = GameTaskQueue::GetSingleton();
+    tasks.SetHandler(GameTaskKind::kToggleSettingsPanel, &ToggleSettingsPanel);
+    tasks.SetHandler(GameTaskKind::kFocusSettingsPanel, &FocusSettingsPanel);
+    tasks.SetHandler(GameTaskKind::kCloseSettingsPanel, &CloseSettingsPanel);
+    tasks.SetHandler(GameTaskKind::kToggleWidgetsVisibility, &ToggleWidgetsVisibility);
+
     (void)keyHandler->Register(kInsertScanCode, KeyEventType::KEY_DOWN, []() {
-        DispatchToGameThread([]() {
-            if (!IsViewReady() || !IsGameLoaded()) {
-                return;
-            }
-
-            if (IsSettingsPanelOpen()) {
-                InvokeScript(TulliusWidgets::WidgetInteropContracts::kCloseSettingsScript);
-                UnfocusView();
-                return;
-            }
-
-            if (!InvokeScript(TulliusWidgets::WidgetInteropContracts::kToggleSettingsScript)) {
-                return;
-            }
-
-            // Focus on the next task tick so PrismaUI can finish opening the
-            // settings overlay before it switches the game into cursor mode.
-            DispatchToGameThread([]() {
-                if (!IsViewReady() || !IsGameLoaded()) {
-                    return;
-                }
-                (void)FocusView();
-            });
-        });
+        PostGameTask(GameTaskKind::kToggleSettingsPanel);
     });
 
     (void)keyHandler->Register(kEscapeScanCode, KeyEventType::KEY_DOWN, []() {
-        DispatchToGameThread([]() {
-            if (IsViewReady() && IsGameLoaded() && IsSettingsPanelOpen()) {
-                InvokeScript(TulliusWidgets::WidgetInteropContracts::kCloseSettingsScript);
-                UnfocusView();
-            }
-        });
+        PostGameTask(GameTaskKind::kCloseSettingsPanel);
     });
 
     (void)keyHandler->Register(kF11ScanCode, KeyEventType::KEY_DOWN, []() {
-        DispatchToGameThread([]() {
-            if (IsViewReady() && IsGameLoaded()) {
-                InvokeScript(TulliusWidgets::WidgetInteropContracts::kToggleWidgetsVisibilityScript);
-            }
-        });
+        PostGameTask(GameTaskKind::kToggleWidgetsVisibility);
     });
-
 }
 
 }  // namespace TulliusWidgets::WidgetHotkeys
@@ -3,6 +3,7 @@
 namespace TulliusWidgets::WidgetInteropContracts {
 
 inline constexpr char kUpdateStats[] = "updateStats";
+inline constexpr char kUpdateStatsSchema[] = "updateStatsSchema";
 inline constexpr char kUpdateSettings[] = "updateSettings";
 inline constexpr char kUpdateRuntimeStatus[] = "updateRuntimeStatus";
 inline constexpr char kImportSettingsFromNative[] = "importSettingsFromNative";
@@ -13,6 +14,8 @@ inline constexpr char kOnExportSettings[] = "onExportSettings";
 inline constexpr char kOnImportSettings[] = "onImportSettings";
 inline constexpr char kOnRequestUnfocus[] = "onRequestUnfocus";
 inline constexpr char kOnSettingsVisibilityChanged[] = "onSettingsVisibilityChanged";
+inline constexpr char kOnRequestStatsKeyframe[] = "onRequestStatsKeyframe";
+inline constexpr char kOnStatsCapabilities[] = "onStatsCapabilities";
 
 inline constexpr char kOnExportResult[] = "onExportResult";
 inline constexpr char kOnImportResult[] = "onImportResult";
@@ -1,6 +1,7 @@
 #include "WidgetJsListeners.h"
 
-#include "JsonUtils.h"
+#include "GameTaskQueue.h"
+#include "JsonReader.h"
 #include "NativeStorage.h"
 #include "WidgetInteropContracts.h"
 
@@ -14,14 +15,9 @@ namespace {
 
 Callbacks g_callbacks{};
 
-template <class Fn>
-void DispatchToGameThread(Fn&& fn)
+void PostGameTask(GameTaskKind kind, std::uint64_t a = 0, std::uint64_t b = 0)
 {
-    if (auto* taskInterface = SKSE::GetTaskInterface()) {
-        taskInterface->AddTask(std::forward<Fn>(fn));
-        return;
-    }
-    std::forward<Fn>(fn)();
+    GameTaskQueue::GetSingleton().Post(kind, a, b);
 }
 
 std::filesystem::path ResolveStorageBasePath()
@@ -77,12 +73,39 @@ void SetSettingsOpen(bool open)
     }
 }
 
+void RequestStatsKeyframe()
+{
+    if (g_callbacks.requestStatsKeyframe) {
+        g_callbacks.requestStatsKeyframe();
+    }
+}
+
+void SetStatsViewSchemaVersion(std::uint32_t schemaVersion)
+{
+    if (g_callbacks.setStatsViewSchemaVersion) {
+        g_callbacks.setStatsViewSchemaVersion(schemaVersion);
+    }
+}
+
 bool TryImportSettingsToView(const std::string& json)
 {
     if (!g_callbacks.interopCall) return false;
     return g_callbacks.interopCall(TulliusWidgets::WidgetInteropContracts::kImportSettingsFromNative, json.c_str());
 }
 
+// Reads top-level `key` as an unsigned integer while validating the whole
+// payload. Returns false for malformed JSON; `value` stays empty when the
+// key is missing or not a non-negative integer.
+bool TryReadTopLevelUInt(std::string_view payload, std::string_view key, std::optional<std::uint32_t>& value)
+{
+    value.reset();
+    return TulliusWidgets::JsonUtils::ScanTopLevelFields(payload, [&](const TulliusWidgets::JsonUtils::JsonField& field) {
+        if (!field.keyEscaped && field.key == key) {
+            value = TulliusWidgets::JsonUtils::ReadUInt32(field);
+        }
+    });
+}
+
 bool IsPayloadWithinLimit(std::string_view payload, std::string_view label)
 {
     if (payload.size() <= TulliusWidgets::NativeStorage::kMaxSettingsFileBytes) return true;
@@ -94,6 +117,42 @@ bool IsPayloadWithinLimit(std::string_view payload, std::string_view label)
     return false;
 }
 
+void ImportPreset(const GameTask&)
+{
+    std::string json;
+    if (!TulliusWidgets::NativeStorage::LoadPreset(ResolveStorageBasePath(), json)) {
+        NotifyImportResult(false);
+        return;
+    }
+
+    if (!TryImportSettingsToView(json)) {
+        logger::warn("Failed to send preset import payload to view (interop call failed)");
+        NotifyImportResult(false);
+        return;
+    }
+
+    logger::info("Preset import payload sent");
+}
+
+void RegisterGameTaskHandlers()
+{
+    auto& tasks = GameTaskQueue::GetSingleton();
+    tasks.SetHandler(GameTaskKind::kUnfocusView, [](const GameTask&) { UnfocusView(); });
+    tasks.SetHandler(GameTaskKind::kSetSettingsOpen, [](const GameTask& task) { SetSettingsOpen(task.a != 0); });
+    tasks.SetHandler(GameTaskKind::kRequestStatsKeyframe, [](const GameTask&) { RequestStatsKeyframe(); });
+    tasks.SetHandler(GameTaskKind::kSetStatsViewSchemaVersion, [](const GameTask& task) {
+        SetStatsViewSchemaVersion(static_cast<std::uint32_t>(task.a));
+    });
+    tasks.SetHandler(GameTaskKind::kSettingsSyncResult, [](const GameTask& task) {
+        const bool saved = task.a != 0;
+        const auto revision = task.b != 0
+            ? std::optional<std::uint32_t>(static_cast<std::uint32_t>(task.b - 1))
+            : std::nullopt;
+        NotifySettingsSyncResult(saved, revision);
+    });
+    tasks.SetHandler(GameTaskKind::kImportPreset, &ImportPreset);
+}
+
 }  // namespace
 
 void Register(PRISMA_UI_API::IVPrismaUI1* prismaUI, PrismaView view, const Callbacks& callbacks)
@@ -104,6 +163,7 @@ void Register(PRISMA_UI_API::IVPrismaUI1* prismaUI, PrismaView view, const Callb
     }
 
     g_callbacks = callbacks;
+    RegisterGameTaskHandlers();
 
     prismaUI->RegisterJSListener(view, TulliusWidgets::WidgetInteropContracts::kOnSettingsChanged, [](const char* data) -> void {
         if (!data) return;
@@ -113,16 +173,27 @@ void Register(PRISMA_UI_API::IVPrismaUI1* prismaUI, PrismaView view, const Callb
             return;
         }
 
+        std::optional<std::uint32_t> revision;
+        if (!TryReadTopLevelUInt(payloadView, "rev", revision)) {
+            // Never persist a document the view could not load back.
+            logger::warn("Settings update is not a well-formed JSON object, rejecting");
+            NotifySettingsSyncResult(false);
+            return;
+        }
+
         std::string payload(payloadView);
-        const auto revision = TulliusWidgets::JsonUtils::TryReadUIntField(payloadView, "rev");
-        DispatchToGameThread([payload = std::move(payload), revision]() {
+        GameTaskQueue::GetSingleton().PostCallback([payload = std::move(payload), revision]() {
+            if (g_callbacks.applyNativeSettings) {
+                g_callbacks.applyNativeSettings(payload);
+            }
             const bool success = TulliusWidgets::NativeStorage::SaveSettingsAsync(
                 ResolveStorageBasePath(),
                 payload,
                 [revision](bool saved) {
-                    DispatchToGameThread([saved, revision]() {
-                        NotifySettingsSyncResult(saved, revision);
-                    });
+                    PostGameTask(
+                        GameTaskKind::kSettingsSyncResult,
+                        saved ? 1 : 0,
+                        revision ? std::uint64_t{ *revision } + 1 : 0);
                 });
             if (!success) {
                 logger::warn("Failed to queue async settings save from JS listener");
@@ -140,42 +211,38 @@ void Register(PRISMA_UI_API::IVPrismaUI1* prismaUI, PrismaView view, const Callb
         }
 
         std::string copiedPayload(payload);
-        DispatchToGameThread([copiedPayload = std::move(copiedPayload)]() {
+        GameTaskQueue::GetSingleton().PostCallback([copiedPayload = std::move(copiedPayload)]() {
             const bool success = TulliusWidgets::NativeStorage::ExportPreset(ResolveStorageBasePath(), copiedPayload);
             NotifyExportResult(success);
         });
     });
 
     prismaUI->RegisterJSListener(view, TulliusWidgets::WidgetInteropContracts::kOnImportSettings, [](const char*) -> void {
-        DispatchToGameThread([]() {
-            std::string json;
-            if (!TulliusWidgets::NativeStorage::LoadPreset(ResolveStorageBasePath(), json)) {
-                NotifyImportResult(false);
-                return;
-            }
-
-            if (!TryImportSettingsToView(json)) {
-                logger::warn("Failed to send preset import payload to view (interop call failed)");
-                NotifyImportResult(false);
-                return;
-            }
-
-            logger::info("Preset import payload sent");
-        });
+        PostGameTask(GameTaskKind::kImportPreset);
     });
 
     prismaUI->RegisterJSListener(view, TulliusWidgets::WidgetInteropContracts::kOnRequestUnfocus, [](const char*) -> void {
-        DispatchToGameThread([]() {
-            UnfocusView();
-        });
+        PostGameTask(GameTaskKind::kUnfocusView);
     });
 
     prismaUI->RegisterJSListener(view, TulliusWidgets::WidgetInteropContracts::kOnSettingsVisibilityChanged, [](const char* data) -> void {
         const std::string_view state = data ? std::string_view(data) : std::string_view{};
         const bool open = state == "open" || state == "true" || state == "1";
-        DispatchToGameThread([open]() {
-            SetSettingsOpen(open);
-        });
+        PostGameTask(GameTaskKind::kSetSettingsOpen, open ? 1 : 0);
+    });
+
+    prismaUI->RegisterJSListener(view, TulliusWidgets::WidgetInteropContracts::kOnRequestStatsKeyframe, [](const char*) -> void {
+        PostGameTask(GameTaskKind::kRequestStatsKeyframe);
+    });
+
+    prismaUI->RegisterJSListener(view, TulliusWidgets::WidgetInteropContracts::kOnStatsCapabilities, [](const char* data) -> void {
+        const std::string_view payload = data ? std::string_view(data) : std::string_view{};
+        // A view that cannot be parsed is treated as v1-only.
+        std::optional<std::uint32_t> reportedVersion;
+        const auto schemaVersion = TryReadTopLevelUInt(payload, "schemaVersion", reportedVersion)
+            ? reportedVersion.value_or(1)
+            : 1;
+        PostGameTask(GameTaskKind::kSetStatsViewSchemaVersion, schemaVersion);
     });
 }
 
@@ -2,7 +2,9 @@
 
 #include "PrismaUI_API.h"
 
+#include <cstdint>
 #include <filesystem>
+#include <string_view>
 
 namespace TulliusWidgets::WidgetJsListeners {
 
@@ -12,6 +14,10 @@ struct Callbacks {
     bool (*interopCall)(const char*, const char*) = nullptr;
     void (*unfocusView)() = nullptr;
     void (*setSettingsOpen)(bool) = nullptr;
+    void (*requestStatsKeyframe)() = nullptr;
+    void (*setStatsViewSchemaVersion)(std::uint32_t) = nullptr;
+    // Game thread, with every settings document the view saves.
+    void (*applyNativeSettings)(std::string_view) = nullptr;
 };
 
 void Register(PRISMA_UI_API::IVPrismaUI1* prismaUI, PrismaView view, const Callbacks& callbacks);
@@ -1,38 +1,94 @@
 #include "WidgetRuntime.h"
+#include "DeadlineTable.h"
+#include "GameTaskQueue.h"
+#include "StatsDiagnostics.h"
 #include "WidgetInteropContracts.h"
 #include "WidgetVisibilityState.h"
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <mutex>
+#include <stop_token>
+#include <string>
 #include <thread>
 #include <utility>
 
 namespace TulliusWidgets::WidgetRuntime {
 namespace {
 
-constexpr auto kFastIntervalCombat = std::chrono::milliseconds(100);
-constexpr auto kFastIntervalIdle = std::chrono::milliseconds(500);
 constexpr auto kHeartbeatInterval = std::chrono::seconds(2);
-constexpr auto kHeartbeatPoll = std::chrono::milliseconds(100);
+constexpr auto kVisibilityCheckInterval = std::chrono::milliseconds(500);
 constexpr auto kPausedRetryDelay = std::chrono::milliseconds(100);
+// How often the heartbeat thread logs the collection timing histograms
+// while a game is loaded.
+constexpr auto kCollectionTimingsLogInterval = std::chrono::minutes(10);
 
 struct RuntimeState {
     std::atomic<bool> gameLoaded{ false };
     std::atomic<bool> heartbeatStarted{ false };
     std::atomic<std::int64_t> scheduledStatsDueMs{ 0 };
-    std::chrono::steady_clock::time_point lastFastUpdateTime{};
-    std::mutex statsUpdateMutex;
-    std::atomic<bool> statsDispatchRunning{ false };
-    std::atomic<bool> statsDispatchPending{ false };
-    std::atomic<bool> statsDispatchForcePending{ false };
+    // Steady ms of the last dispatch the throttle let through.
+    std::atomic<std::int64_t> lastFastUpdateMs{ 0 };
+    // Throttle interval, fed by every capture; the heartbeat polls at the
+    // mirrored statsUpdateIntervalMs. Game loads, unloads and settings reach
+    // the controller from other threads, hence the mutex.
+    std::mutex updateRateMutex;
+    UpdateRateController updateRate;
+    std::atomic<std::int64_t> statsUpdateIntervalMs{ kDefaultMinUpdateInterval.count() };
     std::atomic<bool> menusWereHidden{ false };
+    std::atomic<std::uint64_t> dispatchesSent{ 0 };
+    std::atomic<std::uint64_t> dispatchesFailed{ 0 };
+    std::atomic<std::uint64_t> dispatchesSkippedThrottled{ 0 };
+    std::atomic<std::uint64_t> dispatchesSkippedUnchanged{ 0 };
+    std::atomic<std::uint64_t> dispatchesRequested{ 0 };
+    std::atomic<std::uint64_t> dispatchesCoalesced{ 0 };
+    // Requests of the current frame waiting for RunFrameStatsDispatch()
+    // (game thread only).
+    std::atomic<bool> frameCoalescing{ false };
+    std::uint8_t pendingFrameDispatch{ 0 };
     std::jthread heartbeatThread;
+    // Wakes the heartbeat thread early: a deadline moved or the game loaded
+    // or unloaded.
+    std::mutex heartbeatMutex;
+    std::condition_variable_any heartbeatCv;
+    bool heartbeatWakeRequested{ false };
+    // Captures the game thread published to the collector, and how many of
+    // them the builder has caught up with (builder only).
+    std::atomic<std::uint64_t> statsCapturesPublished{ 0 };
+    std::uint64_t statsCapturesBuilt{ 0 };
+    // Set while a built payload waits for its interop call; the builder
+    // leaves the collector's JSON buffer alone until then.
+    std::atomic<bool> statsDeliveryPending{ false };
+    // Set while DrainStatsCaptures() runs inline, so a request made from
+    // within a build only publishes its capture (builder only).
+    bool statsBuilding{ false };
+    // Bumped to wake the stats worker; it waits on the value it last saw.
+    std::atomic<std::uint32_t> statsWorkerSignal{ 0 };
+    std::atomic<bool> statsWorkerStarted{ false };
+    std::jthread statsWorkerThread;
 };
 
+constexpr std::uint8_t kFrameDispatchThrottled = 0x1;
+constexpr std::uint8_t kFrameDispatchForced = 0x2;
+
 RuntimeState g_state;
 Callbacks g_callbacks{};
 
+// Deadlines the heartbeat thread sleeps towards. Armed only while a game is
+// loaded; with none armed it sleeps until woken.
+enum class HeartbeatTimer : std::uint8_t {
+    kHeartbeat,
+    kVisibilityCheck,
+    kScheduledStats,
+    kStatsPoll,
+    kTimingsLog,
+    kCount
+};
+
+using HeartbeatTimers = DeadlineTable<HeartbeatTimer>;
+
 std::int64_t SteadyNowMs()
 {
     return std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -50,16 +106,13 @@ bool HasViewFocus()
     return g_callbacks.hasViewFocus && g_callbacks.hasViewFocus();
 }
 
-void QueueGameTask(std::function<void()> task)
+void WakeHeartbeat()
 {
-    if (!task) {
-        return;
+    {
+        std::scoped_lock lock(g_state.heartbeatMutex);
+        g_state.heartbeatWakeRequested = true;
     }
-    if (g_callbacks.queueGameTask) {
-        g_callbacks.queueGameTask(std::move(task));
-        return;
-    }
-    task();
+    g_state.heartbeatCv.notify_one();
 }
 
 bool ShowView()
@@ -96,37 +149,158 @@ enum class StatsDispatchMode {
 
 StatsDispatchMode SelectStatsDispatchMode(bool force)
 {
-    const auto now = std::chrono::steady_clock::now();
+    const auto nowMs = SteadyNowMs();
 
     if (force) {
-        std::scoped_lock lock(g_state.statsUpdateMutex);
-        g_state.lastFastUpdateTime = now;
+        g_state.lastFastUpdateMs.store(nowMs, std::memory_order_relaxed);
         return StatsDispatchMode::kReady;
     }
 
+    // Entering or leaving combat does not wait for the interval; the
+    // capture then shows the controller the flip.
     const auto* player = RE::PlayerCharacter::GetSingleton();
     const bool inCombat = player && player->IsInCombat();
-    const auto interval = inCombat ? kFastIntervalCombat : kFastIntervalIdle;
-
-    std::scoped_lock lock(g_state.statsUpdateMutex);
-    if (now - g_state.lastFastUpdateTime < interval) {
-        return StatsDispatchMode::kSkip;
+    std::int64_t interval = 0;
+    {
+        std::scoped_lock lock(g_state.updateRateMutex);
+        if (inCombat == g_state.updateRate.LastInCombat()) {
+            interval = g_state.updateRate.Interval().count();
+        }
     }
 
-    g_state.lastFastUpdateTime = now;
+    auto lastMs = g_state.lastFastUpdateMs.load(std::memory_order_relaxed);
+    do {
+        if (nowMs - lastMs < interval) {
+            return StatsDispatchMode::kSkip;
+        }
+    } while (!g_state.lastFastUpdateMs.compare_exchange_weak(lastMs, nowMs, std::memory_order_relaxed));
     return StatsDispatchMode::kReady;
 }
 
-void SendStatsToView(bool force)
+bool HasStatsBuildWork()
 {
-    if (!IsInteropReady() || !g_state.gameLoaded.load(std::memory_order_acquire)) {
+    return g_state.statsCapturesPublished.load(std::memory_order_acquire) != g_state.statsCapturesBuilt
+        && !g_state.statsDeliveryPending.load(std::memory_order_acquire);
+}
+
+void DeliverStats(std::string_view stats);
+
+// Builder: turns the newest published capture into a payload until it has
+// caught up or a payload waits for delivery. Captures published while it
+// builds are picked up on the next round; only the newest is built.
+void DrainStatsCaptures()
+{
+    if (g_state.statsBuilding) {
+        return;
+    }
+    g_state.statsBuilding = true;
+    while (HasStatsBuildWork()) {
+        g_state.statsCapturesBuilt = g_state.statsCapturesPublished.load(std::memory_order_acquire);
+
+        // No capture to build: the builder already reached a newer one than
+        // the count it just read. An empty result means the capture's
+        // fingerprint matched the last payload sent; the view already shows
+        // exactly this content. Non-empty results are NUL-terminated views
+        // into the collector's reusable buffer, which the next build (not
+        // before DeliverStats) rewrites.
+        std::string_view stats;
+        if (!g_callbacks.buildStatsJson(stats)) {
+            continue;
+        }
+        if (stats.empty()) {
+            g_state.dispatchesSkippedUnchanged.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Interop calls stay on the game thread, like every other view call.
+        g_state.statsDeliveryPending.store(true, std::memory_order_release);
+        GameTaskQueue::GetSingleton().Post(
+            GameTaskKind::kDeliverStats,
+            reinterpret_cast<std::uintptr_t>(stats.data()),
+            stats.size());
+    }
+    g_state.statsBuilding = false;
+}
+
+// Runs the builder on the stats worker once it started, inline before.
+void WakeStatsBuilder()
+{
+    if (!g_state.statsWorkerStarted.load(std::memory_order_acquire)) {
+        DrainStatsCaptures();
         return;
     }
+    g_state.statsWorkerSignal.fetch_add(1, std::memory_order_release);
+    g_state.statsWorkerSignal.notify_one();
+}
+
+void RunStatsWorker(std::stop_token stopToken)
+{
+    const std::stop_callback wakeOnStop(stopToken, []() { WakeStatsBuilder(); });
+    while (!stopToken.stop_requested()) {
+        // Read the signal before checking for work, so a wake-up between
+        // the check and the wait is not lost.
+        const auto signal = g_state.statsWorkerSignal.load(std::memory_order_acquire);
+        if (HasStatsBuildWork()) {
+            DrainStatsCaptures();
+            continue;
+        }
+        g_state.statsWorkerSignal.wait(signal, std::memory_order_acquire);
+    }
+}
+
+void RunDeliverStatsTask(const GameTask& task)
+{
+    DeliverStats(std::string_view(reinterpret_cast<const char*>(task.a), static_cast<std::size_t>(task.b)));
+}
+
+void DeliverStats(std::string_view stats)
+{
+    bool delivered = false;
+    if (IsInteropReady() && g_state.gameLoaded.load(std::memory_order_acquire)) {
+        StatsCollectorInternal::ScopedStageTimer timer(StatsCollectorInternal::CollectionStage::kInterop);
+        delivered = g_callbacks.interopCall(TulliusWidgets::WidgetInteropContracts::kUpdateStats, stats.data());
+    }
+    if (delivered) {
+        g_state.dispatchesSent.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // The builder has already taken this payload as its diff base and
+        // fingerprint; without a keyframe the view would apply the next
+        // delta to a state it never had, or never hear of this one.
+        g_state.dispatchesFailed.fetch_add(1, std::memory_order_relaxed);
+        if (g_callbacks.requestKeyframe) {
+            g_callbacks.requestKeyframe();
+        }
+    }
+    g_state.statsDeliveryPending.store(false, std::memory_order_release);
+    WakeStatsBuilder();
+}
+
+// Hands the controller's interval to the heartbeat.
+void PublishUpdateInterval()
+{
+    std::int64_t interval = 0;
+    {
+        std::scoped_lock lock(g_state.updateRateMutex);
+        interval = g_state.updateRate.Interval().count();
+    }
+    const auto previous = g_state.statsUpdateIntervalMs.exchange(interval, std::memory_order_acq_rel);
+    if (interval < previous) {
+        // The heartbeat may be asleep until the slower poll.
+        WakeHeartbeat();
+    }
+}
+
+// Game thread. True when a capture was published for the builder.
+bool CaptureStatsForDispatch(bool force)
+{
+    if (!IsInteropReady() || !g_state.gameLoaded.load(std::memory_order_acquire)) {
+        return false;
+    }
 
     auto* ui = RE::UI::GetSingleton();
     if (WidgetVisibilityState::IsBlockingUiState(ui, HasViewFocus())) {
         ScheduleStatsUpdateAfter(kPausedRetryDelay);
-        return;
+        return false;
     }
 
     if (!force && TryConsumeScheduledStatsUpdate(SteadyNowMs())) {
@@ -134,14 +308,195 @@ void SendStatsToView(bool force)
     }
 
     if (SelectStatsDispatchMode(force) == StatsDispatchMode::kSkip) {
+        g_state.dispatchesSkippedThrottled.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (!g_callbacks.captureStats || !g_callbacks.buildStatsJson || !g_callbacks.interopCall) {
+        return false;
+    }
+    UpdateRateSample sample{};
+    if (!g_callbacks.captureStats(sample)) {
+        return false;
+    }
+    {
+        std::scoped_lock lock(g_state.updateRateMutex);
+        g_state.updateRate.Observe(sample, std::chrono::steady_clock::now());
+    }
+    PublishUpdateInterval();
+    return true;
+}
+
+// Game thread: one capture for however many requests it stands for.
+void DispatchStats(bool force)
+{
+    if (!CaptureStatsForDispatch(force)) {
         return;
     }
-    if (!g_callbacks.collectStatsJson || !g_callbacks.interopCall) {
+    g_state.statsCapturesPublished.fetch_add(1, std::memory_order_release);
+    WakeStatsBuilder();
+}
+
+void LogCollectionTimings()
+{
+    std::string timings;
+    StatsCollectorInternal::AppendCollectionTimingsJson(timings);
+    logger::info("Stats collection timings: {{{}}}", timings);
+}
+
+void LogDispatchCounters()
+{
+    const auto counters = GetDispatchCounters();
+    logger::info(
+        "Stats dispatch summary: sent={}, failed={}, skippedThrottled={}, skippedUnchanged={}, requested={}, coalesced={}",
+        counters.sent,
+        counters.failed,
+        counters.skippedThrottled,
+        counters.skippedUnchanged,
+        counters.requested,
+        counters.coalesced);
+}
+
+
+void RunDueHeartbeatTimers(std::uint32_t due)
+{
+    const bool heartbeatDue = due & HeartbeatTimers::Bit(HeartbeatTimer::kHeartbeat);
+    const bool visibilityCheckDue = due & HeartbeatTimers::Bit(HeartbeatTimer::kVisibilityCheck);
+    const bool scheduledDue = (due & HeartbeatTimers::Bit(HeartbeatTimer::kScheduledStats))
+        && TryConsumeScheduledStatsUpdate(SteadyNowMs());
+    // Nothing to poll for while menus keep the view hidden.
+    const bool pollDue = (due & HeartbeatTimers::Bit(HeartbeatTimer::kStatsPoll))
+        && !g_state.menusWereHidden.load(std::memory_order_acquire);
+    if (due & HeartbeatTimers::Bit(HeartbeatTimer::kTimingsLog)) {
+        LogCollectionTimings();
+    }
+    if (!heartbeatDue && !scheduledDue && !visibilityCheckDue && !pollDue) {
         return;
     }
 
-    std::string stats = g_callbacks.collectStatsJson();
-    (void)g_callbacks.interopCall(TulliusWidgets::WidgetInteropContracts::kUpdateStats, stats.c_str());
+    std::uint32_t timers = 0;
+    if (heartbeatDue) {
+        timers |= HeartbeatTimers::Bit(HeartbeatTimer::kHeartbeat);
+    }
+    if (visibilityCheckDue) {
+        timers |= HeartbeatTimers::Bit(HeartbeatTimer::kVisibilityCheck);
+    }
+    if (scheduledDue) {
+        timers |= HeartbeatTimers::Bit(HeartbeatTimer::kScheduledStats);
+    }
+    if (pollDue) {
+        timers |= HeartbeatTimers::Bit(HeartbeatTimer::kStatsPoll);
+    }
+    GameTaskQueue::GetSingleton().Post(GameTaskKind::kHeartbeatTimers, timers);
+}
+
+// Game thread: the view work of the heartbeat timers in `task.a`.
+void RunHeartbeatTimers(const GameTask& task)
+{
+    if (!IsGameLoaded()) {
+        return;
+    }
+
+    const auto due = static_cast<std::uint32_t>(task.a);
+    const bool heartbeatDue = due & HeartbeatTimers::Bit(HeartbeatTimer::kHeartbeat);
+    const bool visibilityCheckDue = due & HeartbeatTimers::Bit(HeartbeatTimer::kVisibilityCheck);
+    const bool scheduledDue = due & HeartbeatTimers::Bit(HeartbeatTimer::kScheduledStats);
+    const bool pollDue = due & HeartbeatTimers::Bit(HeartbeatTimer::kStatsPoll);
+
+    if (visibilityCheckDue || heartbeatDue) {
+        auto* ui = RE::UI::GetSingleton();
+        if (WidgetVisibilityState::IsBlockingUiState(ui, HasViewFocus())) {
+            HideView();
+            g_state.menusWereHidden.store(true, std::memory_order_release);
+            return;
+        }
+        if (g_state.menusWereHidden.exchange(false, std::memory_order_acq_rel)) {
+            if (ShowView()) {
+                RequestStatsDispatch(true);
+            }
+        }
+    }
+
+    if (heartbeatDue || scheduledDue) {
+        RequestStatsDispatch(true);
+    } else if (pollDue) {
+        RequestStatsDispatch(false);
+    }
+}
+
+void RunStatsDispatchTask(const GameTask& task)
+{
+    RequestStatsDispatch(task.a != 0);
+}
+
+// Sleeps until the earliest deadline, a wake-up or a stop; nothing is armed
+// while no game is loaded, so it then sleeps until SetGameLoaded().
+void RunHeartbeat(std::stop_token stopToken)
+{
+    using Clock = HeartbeatTimers::Clock;
+    HeartbeatTimers timers;
+    bool armed = false;
+    auto nextTimingsLog = Clock::now() + kCollectionTimingsLogInterval;
+    // The poll waits a full interval after the last dispatch the throttle
+    // let through, and after its own last firing in case that one is still
+    // queued for the game thread.
+    auto lastStatsPoll = Clock::time_point{};
+
+    while (!stopToken.stop_requested()) {
+        const auto now = Clock::now();
+        if (!IsGameLoaded()) {
+            timers.DisarmAll();
+            armed = false;
+        } else {
+            if (!armed) {
+                timers.Arm(HeartbeatTimer::kHeartbeat, now + kHeartbeatInterval);
+                timers.Arm(HeartbeatTimer::kVisibilityCheck, now + kVisibilityCheckInterval);
+                timers.Arm(HeartbeatTimer::kTimingsLog, nextTimingsLog);
+                armed = true;
+            }
+            // ScheduleStatsUpdateAfter() may run on any thread; the atomic
+            // stays the source of truth and is re-read on every wake-up.
+            const auto scheduledMs = g_state.scheduledStatsDueMs.load(std::memory_order_acquire);
+            if (scheduledMs > 0) {
+                timers.Arm(
+                    HeartbeatTimer::kScheduledStats,
+                    Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(scheduledMs))));
+            } else {
+                timers.Disarm(HeartbeatTimer::kScheduledStats);
+            }
+            const auto interval = std::chrono::milliseconds(g_state.statsUpdateIntervalMs.load(std::memory_order_acquire));
+            const auto lastDispatch = Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+                std::chrono::milliseconds(g_state.lastFastUpdateMs.load(std::memory_order_relaxed))));
+            timers.Arm(HeartbeatTimer::kStatsPoll, (std::max)(lastDispatch, lastStatsPoll) + interval);
+        }
+
+        const auto due = timers.TakeDue(now);
+        if (due == 0) {
+            const auto wakeRequested = []() { return g_state.heartbeatWakeRequested; };
+            std::unique_lock lock(g_state.heartbeatMutex);
+            if (armed) {
+                g_state.heartbeatCv.wait_until(lock, stopToken, timers.Next(), wakeRequested);
+            } else {
+                g_state.heartbeatCv.wait(lock, stopToken, wakeRequested);
+            }
+            g_state.heartbeatWakeRequested = false;
+            continue;
+        }
+
+        if (due & HeartbeatTimers::Bit(HeartbeatTimer::kHeartbeat)) {
+            timers.Arm(HeartbeatTimer::kHeartbeat, now + kHeartbeatInterval);
+        }
+        if (due & HeartbeatTimers::Bit(HeartbeatTimer::kVisibilityCheck)) {
+            timers.Arm(HeartbeatTimer::kVisibilityCheck, now + kVisibilityCheckInterval);
+        }
+        if (due & HeartbeatTimers::Bit(HeartbeatTimer::kStatsPoll)) {
+            lastStatsPoll = now;
+        }
+        if (due & HeartbeatTimers::Bit(HeartbeatTimer::kTimingsLog)) {
+            nextTimingsLog = now + kCollectionTimingsLogInterval;
+            timers.Arm(HeartbeatTimer::kTimingsLog, nextTimingsLog);
+        }
+        RunDueHeartbeatTimers(due);
+    }
 }
 
 }  // namespace
@@ -149,6 +504,11 @@ void SendStatsToView(bool force)
 void Initialize(const Callbacks& callbacks)
 {
     g_callbacks = callbacks;
+
+    auto& tasks = GameTaskQueue::GetSingleton();
+    tasks.SetHandler(GameTaskKind::kStatsDispatch, &RunStatsDispatchTask);
+    tasks.SetHandler(GameTaskKind::kDeliverStats, &RunDeliverStatsTask);
+    tasks.SetHandler(GameTaskKind::kHeartbeatTimers, &RunHeartbeatTimers);
 }
 
 bool IsGameLoaded()
@@ -158,44 +518,49 @@ bool IsGameLoaded()
 
 void SetGameLoaded(bool loaded)
 {
-    g_state.gameLoaded.store(loaded, std::memory_order_release);
+    const bool wasLoaded = g_state.gameLoaded.exchange(loaded, std::memory_order_acq_rel);
     if (!loaded) {
+        if (wasLoaded) {
+            LogDispatchCounters();
+        }
         g_state.scheduledStatsDueMs.store(0, std::memory_order_release);
-        g_state.statsDispatchPending.store(false, std::memory_order_release);
-        g_state.statsDispatchForcePending.store(false, std::memory_order_release);
+    }
+    if (loaded != wasLoaded) {
+        {
+            std::scoped_lock lock(g_state.updateRateMutex);
+            g_state.updateRate.Reset();
+        }
+        PublishUpdateInterval();
+        WakeHeartbeat();
     }
 }
 
 void RequestStatsDispatch(bool force)
 {
-    if (force) {
-        g_state.statsDispatchForcePending.store(true, std::memory_order_release);
-    }
-    g_state.statsDispatchPending.store(true, std::memory_order_release);
-
-    bool expected = false;
-    if (!g_state.statsDispatchRunning.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+    g_state.dispatchesRequested.fetch_add(1, std::memory_order_relaxed);
+    if (!g_state.frameCoalescing.load(std::memory_order_acquire)) {
+        DispatchStats(force);
         return;
     }
+    if (g_state.pendingFrameDispatch != 0) {
+        g_state.dispatchesCoalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+    g_state.pendingFrameDispatch |= force ? kFrameDispatchForced : kFrameDispatchThrottled;
+}
 
-    while (true) {
-        const bool shouldForce = g_state.statsDispatchForcePending.exchange(false, std::memory_order_acq_rel);
-        g_state.statsDispatchPending.store(false, std::memory_order_release);
-        SendStatsToView(shouldForce);
-
-        // Release the running flag before the final pending check so a new
-        // caller can either pick up the work or let this loop reacquire it.
-        g_state.statsDispatchRunning.store(false, std::memory_order_release);
-
-        if (!g_state.statsDispatchPending.load(std::memory_order_acquire)
-            && !g_state.statsDispatchForcePending.load(std::memory_order_acquire)) {
-            return;
-        }
+void SetFrameCoalescing(bool enabled)
+{
+    g_state.frameCoalescing.store(enabled, std::memory_order_release);
+    if (!enabled) {
+        RunFrameStatsDispatch();
+    }
+}
 
-        expected = false;
-        if (!g_state.statsDispatchRunning.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
-            return;
-        }
+void RunFrameStatsDispatch()
+{
+    const auto pending = std::exchange(g_state.pendingFrameDispatch, std::uint8_t{ 0 });
+    if (pending != 0) {
+        DispatchStats((pending & kFrameDispatchForced) != 0);
     }
 }
 
@@ -212,76 +577,54 @@ void ScheduleStatsUpdateAfter(std::chrono::milliseconds delay)
                 targetMs,
                 std::memory_order_acq_rel,
                 std::memory_order_acquire)) {
+            // The heartbeat may be asleep until a later deadline.
+            WakeHeartbeat();
             return;
         }
     }
 }
 
+void SetUpdateRateBounds(const UpdateRateBounds& bounds)
+{
+    UpdateRateBounds applied{};
+    {
+        std::scoped_lock lock(g_state.updateRateMutex);
+        g_state.updateRate.SetBounds(bounds);
+        applied = g_state.updateRate.Bounds();
+    }
+    logger::info(
+        "Stats update interval bounds: {}-{} ms",
+        applied.minInterval.count(),
+        applied.maxInterval.count());
+    PublishUpdateInterval();
+}
+
 void StartHeartbeat()
 {
     if (g_state.heartbeatStarted.exchange(true, std::memory_order_acq_rel)) {
         return;
     }
 
-    g_state.heartbeatThread = std::jthread([](std::stop_token stopToken) {
-        constexpr auto kVisibilityCheckInterval = std::chrono::milliseconds(500);
-        auto nextHeartbeatDue = std::chrono::steady_clock::now() + kHeartbeatInterval;
-        auto nextVisibilityCheck = std::chrono::steady_clock::now() + kVisibilityCheckInterval;
-
-        while (!stopToken.stop_requested()) {
-            std::this_thread::sleep_for(kHeartbeatPoll);
-            if (stopToken.stop_requested()) {
-                break;
-            }
-
-            if (!IsGameLoaded()) {
-                nextHeartbeatDue = std::chrono::steady_clock::now() + kHeartbeatInterval;
-                nextVisibilityCheck = std::chrono::steady_clock::now() + kVisibilityCheckInterval;
-                continue;
-            }
-
-            const auto now = std::chrono::steady_clock::now();
-            const auto nowMs = SteadyNowMs();
-            const bool heartbeatDue = now >= nextHeartbeatDue;
-            const bool scheduledDue = TryConsumeScheduledStatsUpdate(nowMs);
-            const bool visibilityCheckDue = now >= nextVisibilityCheck;
-            if (!heartbeatDue && !scheduledDue && !visibilityCheckDue) {
-                continue;
-            }
-
-            if (visibilityCheckDue) {
-                nextVisibilityCheck = now + kVisibilityCheckInterval;
-            }
+    g_state.statsWorkerThread = std::jthread([](std::stop_token stopToken) {
+        RunStatsWorker(stopToken);
+    });
+    g_state.statsWorkerStarted.store(true, std::memory_order_release);
 
-            QueueGameTask([heartbeatDue, scheduledDue, visibilityCheckDue]() {
-                if (!IsGameLoaded()) {
-                    return;
-                }
-
-                if (visibilityCheckDue || heartbeatDue) {
-                    auto* ui = RE::UI::GetSingleton();
-                    if (WidgetVisibilityState::IsBlockingUiState(ui, HasViewFocus())) {
-                        HideView();
-                        g_state.menusWereHidden.store(true, std::memory_order_release);
-                        return;
-                    }
-                    if (g_state.menusWereHidden.exchange(false, std::memory_order_acq_rel)) {
-                        if (ShowView()) {
-                            RequestStatsDispatch(true);
-                        }
-                    }
-                }
-
-                if (heartbeatDue || scheduledDue) {
-                    RequestStatsDispatch(true);
-                }
-            });
-
-            if (heartbeatDue) {
-                nextHeartbeatDue = now + kHeartbeatInterval;
-            }
-        }
+    g_state.heartbeatThread = std::jthread([](std::stop_token stopToken) {
+        RunHeartbeat(stopToken);
     });
 }
 
+DispatchCounters GetDispatchCounters()
+{
+    return DispatchCounters{
+        g_state.dispatchesSent.load(std::memory_order_relaxed),
+        g_state.dispatchesFailed.load(std::memory_order_relaxed),
+        g_state.dispatchesSkippedThrottled.load(std::memory_order_relaxed),
+        g_state.dispatchesSkippedUnchanged.load(std::memory_order_relaxed),
+        g_state.dispatchesRequested.load(std::memory_order_relaxed),
+        g_state.dispatchesCoalesced.load(std::memory_order_relaxed)
+    };
+}
+
 }  // namespace TulliusWidgets::WidgetRuntime
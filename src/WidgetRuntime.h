@@ -1,26 +1,67 @@
 #pragma once
 
+#include "UpdateRateController.h"
+
 #include <chrono>
+#include <cstdint>
 #include <functional>
-#include <string>
+#include <string_view>
 
 namespace TulliusWidgets::WidgetRuntime {
 
 struct Callbacks {
     std::function<bool()> isInteropReady;
     std::function<bool()> hasViewFocus;
-    std::function<std::string()> collectStatsJson;
+    // Game-thread half of a stats dispatch: reads what needs the engine and
+    // publishes it to the collector, filling in the values that drive the
+    // update rate. False when there is nothing to send.
+    std::function<bool(UpdateRateSample&)> captureStats;
+    // Stats worker half: derives, diffs and serializes the newest published
+    // capture into `json`. False when there was no capture left to build;
+    // otherwise `json` is empty when the view already shows the capture, and
+    // NUL-terminated and valid until the next call when it is not.
+    std::function<bool(std::string_view&)> buildStatsJson;
     std::function<bool(const char*, const char*)> interopCall;
+    // Makes the next build a keyframe. Called when a built payload never
+    // reached the view, since the builder already diffs against it.
+    std::function<void()> requestKeyframe;
     std::function<bool()> showView;
     std::function<void()> hideView;
-    std::function<void(std::function<void()>)> queueGameTask;
+};
+
+struct DispatchCounters {
+    // Payloads the view accepted, and built payloads it never received.
+    std::uint64_t sent{ 0 };
+    std::uint64_t failed{ 0 };
+    std::uint64_t skippedThrottled{ 0 };
+    std::uint64_t skippedUnchanged{ 0 };
+    // Every RequestStatsDispatch() call, and those merged into a dispatch
+    // another request of the same frame had already asked for.
+    std::uint64_t requested{ 0 };
+    std::uint64_t coalesced{ 0 };
 };
 
 void Initialize(const Callbacks& callbacks);
 bool IsGameLoaded();
 void SetGameLoaded(bool loaded);
 void ScheduleStatsUpdateAfter(std::chrono::milliseconds delay);
+// Limits the interval between throttled stats updates, which otherwise
+// follows how fast the key values change. Any thread.
+void SetUpdateRateBounds(const UpdateRateBounds& bounds);
+// Game thread only: captures and leaves building and delivery to the stats
+// worker, which skips captures superseded before it got to them. With frame
+// coalescing on, the capture waits for RunFrameStatsDispatch(). Other
+// threads post GameTaskKind::kStatsDispatch instead.
 void RequestStatsDispatch(bool force);
+// Game thread only. While on, requests only note whether one of them was
+// forced, and RunFrameStatsDispatch() runs at most one dispatch for all of
+// them. Turning it off runs a pending dispatch right away.
+void SetFrameCoalescing(bool enabled);
+// Game thread, once per main-loop iteration.
+void RunFrameStatsDispatch();
+// Starts the heartbeat and the stats worker thread. Until then stats are
+// built inline on the thread that captured them.
 void StartHeartbeat();
+DispatchCounters GetDispatchCounters();
 
 }  // namespace TulliusWidgets::WidgetRuntime
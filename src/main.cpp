@@ -1,9 +1,13 @@
+#include "GameSettings.h"
+#include "GameTaskQueue.h"
+#include "NativeSettings.h"
 #include "NativeStorage.h"
 #include "PrismaUI_API.h"
 #include "RuntimeDiagnostics.h"
 #include "StatsCollector.h"
 #include "WidgetBootstrap.h"
 #include "WidgetEvents.h"
+#include "WidgetFrameHook.h"
 #include "WidgetHotkeys.h"
 #include "WidgetInteropContracts.h"
 #include "WidgetJsListeners.h"
@@ -103,32 +107,41 @@ static void TryUnfocusView() {
 
 static void SendHUDColorToView() {
     if (!IsInteropReady()) return;
-    static constexpr std::uint32_t kDefaultHUDColor = 0xFFFFFF;
-    std::uint32_t color = kDefaultHUDColor;
-    auto ini = RE::INISettingCollection::GetSingleton();
-    if (ini) {
-        auto setting = ini->GetSetting("iHUDColorDefault:Interface");
-        if (setting) {
-            color = static_cast<std::uint32_t>(setting->GetSInt()) & 0xFFFFFF;
-        }
-    }
+    const std::uint32_t color = TulliusWidgets::GameSettings::HUDColorDefault();
     char hex[16];
     std::snprintf(hex, sizeof(hex), "#%06x", color);
     if (!TryInteropCall(TulliusWidgets::WidgetInteropContracts::kSetHUDColor, hex)) return;
     logger::info("HUD color sent: {}", hex);
 }
 
+// Picks up the settings the plugin itself acts on; the view owns the rest.
+static void ApplyNativeSettings(std::string_view json) {
+    TulliusWidgets::NativeSettings::PerformanceSettings performance{};
+    if (!TulliusWidgets::NativeSettings::ReadPerformanceSettings(json, performance)) return;
+    TulliusWidgets::WidgetRuntime::SetUpdateRateBounds(performance.updateRate);
+    TulliusWidgets::GameTaskQueue::GetSingleton().SetFrameBudget(performance.gameTaskBudget);
+}
+
 static void SendSettingsToView() {
     if (!IsInteropReady()) return;
     std::string json = TulliusWidgets::NativeStorage::LoadSettings(ResolveStorageBasePath());
     if (json.empty()) return;
+    ApplyNativeSettings(json);
     if (!TryInteropCall(TulliusWidgets::WidgetInteropContracts::kUpdateSettings, json.c_str())) return;
     logger::info("Saved settings sent to view");
 }
 
+static void SendStatsSchemaToView() {
+    if (!IsInteropReady()) return;
+    const auto json = TulliusWidgets::StatsCollector::StatsKeyTableJson();
+    (void)TryInteropCall(TulliusWidgets::WidgetInteropContracts::kUpdateStatsSchema, json.data());
+}
+
 static void SendRuntimeDiagnosticsToView() {
     if (!IsInteropReady()) return;
-    const auto json = TulliusWidgets::RuntimeDiagnostics::BuildJson(g.runtimeDiagnostics);
+    const auto performance = TulliusWidgets::StatsCollector::PerformanceDiagnosticsJson();
+    logger::info("Stats collection counters: {}", performance);
+    const auto json = TulliusWidgets::RuntimeDiagnostics::BuildJson(g.runtimeDiagnostics, performance);
     if (!TryInteropCall(TulliusWidgets::WidgetInteropContracts::kUpdateRuntimeStatus, json.c_str())) return;
 }
 
@@ -138,8 +151,20 @@ static bool IsGameLoaded() {
 
 static void SetGameLoaded(bool loaded) {
     TulliusWidgets::WidgetRuntime::SetGameLoaded(loaded);
+    // Forms (and their names) can change between saves and load orders.
+    TulliusWidgets::StatsCollector::ResetNameTable();
+    TulliusWidgets::StatsCollector::RequestKeyframe();
+    TulliusWidgets::StatsCollector::ResetInventoryIndex();
+    TulliusWidgets::StatsCollector::ResetTimedEffects();
     if (!loaded) {
         g.settingsPanelOpen.store(false, std::memory_order_release);
+        const auto tasks = TulliusWidgets::GameTaskQueue::GetSingleton().GetCounters();
+        logger::info(
+            "Game task summary: posted={}, coalesced={}, run={}, deferred={}",
+            tasks.posted,
+            tasks.coalesced,
+            tasks.run,
+            tasks.deferred);
     }
 }
 
@@ -151,11 +176,33 @@ static void SetSettingsPanelOpen(bool open) {
     g.settingsPanelOpen.store(open, std::memory_order_release);
 }
 
-static void SendStatsToViewThrottled() {
-    TulliusWidgets::WidgetRuntime::RequestStatsDispatch(false);
+static void SendStatsToViewForced() {
+    TulliusWidgets::WidgetRuntime::RequestStatsDispatch(true);
 }
 
-static void SendStatsToViewForced() {
+static void SendStatsKeyframeToView() {
+    TulliusWidgets::StatsCollector::RequestKeyframe();
+    TulliusWidgets::WidgetRuntime::RequestStatsDispatch(true);
+}
+
+static void MarkStatsSectionsDirty(std::uint32_t sections) {
+    TulliusWidgets::StatsCollector::MarkSectionsDirty(sections);
+}
+
+static void NoteInventoryChange(std::uint32_t baseFormId, std::int32_t delta) {
+    TulliusWidgets::StatsCollector::NoteInventoryChange(baseFormId, delta);
+}
+
+static void ResetInventoryIndex() {
+    TulliusWidgets::StatsCollector::ResetInventoryIndex();
+}
+
+static void NoteTimedEffectRemoved(std::uint32_t instanceId) {
+    TulliusWidgets::StatsCollector::NoteTimedEffectRemoved(instanceId);
+}
+
+static void SetStatsViewSchemaVersion(std::uint32_t schemaVersion) {
+    TulliusWidgets::StatsCollector::SetViewSchemaVersion(schemaVersion);
     TulliusWidgets::WidgetRuntime::RequestStatsDispatch(true);
 }
 
@@ -169,6 +216,14 @@ static void SetView(PrismaView newView) {
 
 static void SetViewDomReady(bool ready) {
     g_viewBridge.SetDomReady(ready);
+    if (ready) {
+        // A freshly loaded DOM starts from mock stats; deltas would be
+        // applied on top of nothing. It also has no key table until
+        // updateStatsSchema arrives, so start over on the keyed encoding.
+        TulliusWidgets::StatsCollector::ResetViewSchemaVersion();
+        TulliusWidgets::StatsCollector::ResetNameTable();
+        TulliusWidgets::StatsCollector::RequestKeyframe();
+    }
 }
 
 static void RegisterWidgetJsListeners() {
@@ -179,6 +234,9 @@ static void RegisterWidgetJsListeners() {
     jsListenerCallbacks.interopCall = &TryInteropCall;
     jsListenerCallbacks.unfocusView = &TryUnfocusView;
     jsListenerCallbacks.setSettingsOpen = &SetSettingsPanelOpen;
+    jsListenerCallbacks.requestStatsKeyframe = &SendStatsKeyframeToView;
+    jsListenerCallbacks.setStatsViewSchemaVersion = &SetStatsViewSchemaVersion;
+    jsListenerCallbacks.applyNativeSettings = &ApplyNativeSettings;
     TulliusWidgets::WidgetJsListeners::Register(
         g_viewBridge.GetApi(),
         g_viewBridge.GetView(),
@@ -193,9 +251,11 @@ static void RegisterWidgetEventSinks() {
     eventCallbacks.setGameLoaded = &SetGameLoaded;
     eventCallbacks.showView = &TryShowView;
     eventCallbacks.hideView = &HideViewIfReady;
-    eventCallbacks.sendStats = &SendStatsToViewThrottled;
-    eventCallbacks.sendStatsForced = &SendStatsToViewForced;
     eventCallbacks.scheduleStatsUpdateAfter = &ScheduleStatsUpdateAfter;
+    eventCallbacks.markStatsDirty = &MarkStatsSectionsDirty;
+    eventCallbacks.noteInventoryChange = &NoteInventoryChange;
+    eventCallbacks.resetInventoryIndex = &ResetInventoryIndex;
+    eventCallbacks.noteTimedEffectRemoved = &NoteTimedEffectRemoved;
     TulliusWidgets::WidgetEvents::RegisterEventSinks(eventCallbacks);
 }
 
@@ -210,17 +270,6 @@ static void RegisterWidgetHotkeys() {
     TulliusWidgets::WidgetHotkeys::RegisterDefaultHotkeys(hotkeyCallbacks);
 }
 
-static void QueueGameTask(std::function<void()> task) {
-    if (!task) return;
-    if (auto* taskInterface = SKSE::GetTaskInterface()) {
-        taskInterface->AddTask([task = std::move(task)]() mutable {
-            task();
-        });
-        return;
-    }
-    task();
-}
-
 static TulliusWidgets::WidgetRuntime::Callbacks BuildWidgetRuntimeCallbacks() {
     TulliusWidgets::WidgetRuntime::Callbacks callbacks{};
     callbacks.isInteropReady = []() {
@@ -229,24 +278,48 @@ static TulliusWidgets::WidgetRuntime::Callbacks BuildWidgetRuntimeCallbacks() {
     callbacks.hasViewFocus = []() {
         return ViewHasFocus();
     };
-    callbacks.collectStatsJson = []() {
-        return TulliusWidgets::StatsCollector::CollectStats();
+    callbacks.captureStats = [](TulliusWidgets::WidgetRuntime::UpdateRateSample& rateSample) {
+        return TulliusWidgets::StatsCollector::CaptureStats(rateSample);
+    };
+    callbacks.buildStatsJson = [](std::string_view& json) {
+        return TulliusWidgets::StatsCollector::BuildStatsJson(json);
     };
     callbacks.interopCall = [](const char* functionName, const char* argument) {
         return TryInteropCall(functionName, argument);
     };
+    callbacks.requestKeyframe = []() {
+        TulliusWidgets::StatsCollector::RequestKeyframe();
+    };
     callbacks.showView = []() {
         return TryShowView();
     };
     callbacks.hideView = []() {
         HideViewIfReady();
     };
-    callbacks.queueGameTask = [](std::function<void()> task) {
-        QueueGameTask(std::move(task));
-    };
     return callbacks;
 }
 
+// Runs the frame's share of queued game tasks, then the one stats dispatch
+// the frame's requests were merged into.
+static void OnGameFrame() {
+    TulliusWidgets::GameTaskQueue::GetSingleton().Drain();
+    TulliusWidgets::WidgetRuntime::RunFrameStatsDispatch();
+}
+
+// The hook patches a call inside Main::Update, so it is only written where
+// that address is known to be right. Without it, stats requests dispatch
+// right away and game tasks go through SKSE's task interface.
+static void InstallFrameHook() {
+    if (!g.runtimeDiagnostics.runtimeSupported || !g.runtimeDiagnostics.addressLibraryPresent) {
+        logger::warn("Frame hook not installed; stats requests are not merged per frame.");
+        return;
+    }
+    SKSE::AllocTrampoline(1 << 10);
+    TulliusWidgets::WidgetFrameHook::Install(&OnGameFrame);
+    TulliusWidgets::WidgetRuntime::SetFrameCoalescing(true);
+    TulliusWidgets::GameTaskQueue::GetSingleton().SetDrainedPerFrame(true);
+}
+
 static void StartWidgetRuntime() {
     TulliusWidgets::WidgetRuntime::StartHeartbeat();
 }
@@ -262,6 +335,7 @@ static TulliusWidgets::WidgetBootstrap::Callbacks BuildWidgetBootstrapCallbacks(
     callbacks.sendRuntimeDiagnostics = &SendRuntimeDiagnosticsToView;
     callbacks.sendHUDColor = &SendHUDColorToView;
     callbacks.sendSettings = &SendSettingsToView;
+    callbacks.sendStatsSchema = &SendStatsSchemaToView;
     callbacks.sendStatsForced = &SendStatsToViewForced;
     callbacks.registerJsListeners = &RegisterWidgetJsListeners;
     callbacks.registerEventSinks = &RegisterWidgetEventSinks;
@@ -275,6 +349,7 @@ static void SKSEMessageHandler(SKSE::MessagingInterface::Message* message) {
 
     switch (message->type) {
     case SKSE::MessagingInterface::kDataLoaded: {
+        TulliusWidgets::GameSettings::Resolve();
         TulliusWidgets::WidgetRuntime::Initialize(BuildWidgetRuntimeCallbacks());
         if (!TulliusWidgets::WidgetBootstrap::InitializeOnDataLoaded(PrismaUI, bootstrapCallbacks)) {
             return;
@@ -283,6 +358,7 @@ static void SKSEMessageHandler(SKSE::MessagingInterface::Message* message) {
     }
     case SKSE::MessagingInterface::kPostLoadGame:
     case SKSE::MessagingInterface::kNewGame: {
+        TulliusWidgets::GameSettings::Resolve();
         TulliusWidgets::WidgetBootstrap::SyncOnGameLoaded(bootstrapCallbacks);
         break;
     }
@@ -302,7 +378,6 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
     }
 
     SKSE::Init(a_skse);
-    SKSE::AllocTrampoline(1 << 10);
     InitializeRuntimeDiagnostics(a_skse);
 
     if (!g.runtimeDiagnostics.runtimeSupported) {
@@ -316,6 +391,7 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
             std::to_string(g.runtimeDiagnostics.runtimeVersion),
             g.runtimeDiagnostics.addressLibraryPath);
     }
+    InstallFrameHook();
 
     messaging->RegisterListener("SKSE", SKSEMessageHandler);
 
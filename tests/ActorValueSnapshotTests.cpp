@@ -0,0 +1,125 @@
+#include "ActorValueSnapshot.h"
+#include "TestHarness.h"
+
+#include <limits>
+
+namespace {
+
+using namespace TulliusWidgets::StatsCollectorInternal;
+
+}  // namespace
+
+TW_TEST(ActorValueSnapshot_ClampsElementalAndDiseaseResistances)
+{
+    ActorValueSnapshot values;
+    values[PlayerValue::kResistMagic] = 40.0f;
+    values[PlayerValue::kResistFire] = 120.0f;
+    values[PlayerValue::kResistFrost] = -150.0f;
+    values[PlayerValue::kResistDisease] = 130.0f;
+
+    const auto resistances = DeriveResistances(values, StatLimits{});
+    TW_CHECK_EQ(resistances.magic.effective, 40.0f);
+    TW_CHECK(!resistances.magic.clamped);
+    TW_CHECK_EQ(resistances.fire.raw, 120.0f);
+    TW_CHECK_EQ(resistances.fire.effective, 85.0f);
+    TW_CHECK(resistances.fire.clamped);
+    // Elemental weakness is unbounded below.
+    TW_CHECK_EQ(resistances.frost.effective, -150.0f);
+    TW_CHECK(!resistances.frost.clamped);
+    TW_CHECK_EQ(resistances.disease.effective, 100.0f);
+    TW_CHECK(resistances.disease.clamped);
+    TW_CHECK(resistances.anyClamped);
+
+    StatLimits raisedCap{};
+    raisedCap.elementalResistCap = 150.0f;
+    const auto raised = DeriveResistances(values, raisedCap);
+    TW_CHECK_EQ(raised.fire.effective, 120.0f);
+    TW_CHECK_EQ(raised.fire.cap, 150.0f);
+    TW_CHECK(!raised.fire.clamped);
+}
+
+TW_TEST(ActorValueSnapshot_DerivesDamageReductionFromArmorSettings)
+{
+    ActorValueSnapshot values;
+    values[PlayerValue::kDamageResist] = 300.0f;
+
+    const auto defense = DeriveDefense(values, StatLimits{});
+    TW_CHECK_EQ(defense.armorRating, 300.0f);
+    TW_CHECK_EQ(defense.rawDamageReduction, 36.0f);
+    TW_CHECK_EQ(defense.effectiveDamageReduction, 36.0f);
+    TW_CHECK(!defense.damageReductionClamped);
+
+    values[PlayerValue::kDamageResist] = 1000.0f;
+    const auto capped = DeriveDefense(values, StatLimits{});
+    TW_CHECK_EQ(capped.rawDamageReduction, 120.0f);
+    TW_CHECK_EQ(capped.effectiveDamageReduction, 80.0f);
+    TW_CHECK(capped.damageReductionClamped);
+}
+
+TW_TEST(ActorValueSnapshot_DerivesVitalsAndAlertPercentages)
+{
+    ActorValueSnapshot values;
+    values[PlayerValue::kHealth] = 200.0f;
+    values[PlayerValue::kHealthDamage] = -50.0f;
+    values[PlayerValue::kMagicka] = 100.0f;
+    values[PlayerValue::kMagickaDamage] = -250.0f;
+    values[PlayerValue::kInventoryWeight] = 150.0f;
+    values[PlayerValue::kCarryWeight] = 300.0f;
+
+    const auto vitals = DeriveVitals(values);
+    TW_CHECK_EQ(vitals.health, 150.0f);
+    TW_CHECK_EQ(vitals.alertData.healthPct, 75.0f);
+    // Overkill damage never reports negative magicka.
+    TW_CHECK_EQ(vitals.magicka, 0.0f);
+    TW_CHECK_EQ(vitals.alertData.magickaPct, 0.0f);
+    // No maximum reads as full, not as an alert.
+    TW_CHECK_EQ(vitals.alertData.staminaPct, 100.0f);
+    TW_CHECK_EQ(vitals.carryWeight, 150.0f);
+    TW_CHECK_EQ(vitals.maxCarryWeight, 300.0f);
+    TW_CHECK_EQ(vitals.alertData.carryPct, 50.0f);
+}
+
+TW_TEST(ActorValueSnapshot_ClampsCritChanceAndDropsNonFiniteValues)
+{
+    const auto normal = DeriveCritChance(12.5f);
+    TW_CHECK_EQ(normal.effective, 12.5f);
+    TW_CHECK(!normal.clamped);
+
+    const auto over = DeriveCritChance(140.0f);
+    TW_CHECK_EQ(over.raw, 140.0f);
+    TW_CHECK_EQ(over.effective, 100.0f);
+    TW_CHECK(over.clamped);
+
+    const auto nan = DeriveCritChance(std::numeric_limits<float>::quiet_NaN());
+    TW_CHECK_EQ(nan.raw, 0.0f);
+    TW_CHECK_EQ(nan.effective, 0.0f);
+    TW_CHECK(!nan.clamped);
+}
+
+TW_TEST(ActorValueSnapshot_DerivesOnlyCapturedSectionsAndAlwaysVitals)
+{
+    RawStatsCapture raw;
+    raw.sections = kStatsSectionDefense;
+    raw.values[PlayerValue::kDamageResist] = 100.0f;
+    raw.values[PlayerValue::kResistFire] = 50.0f;
+    raw.values[PlayerValue::kHealth] = 80.0f;
+    raw.values[PlayerValue::kSpeedMult] = 110.0f;
+
+    StatsPayload payload;
+    payload.playerInfo.level = 12;
+    DeriveStatsSections(raw, payload);
+    TW_CHECK_EQ(payload.defense.armorRating, 100.0f);
+    // Sections outside the capture keep what the last payload held.
+    TW_CHECK_EQ(payload.resistances.fire.raw, 0.0f);
+    TW_CHECK_EQ(payload.movement.speedMult, 110.0f);
+    TW_CHECK_EQ(payload.playerInfo.health, 80.0f);
+    TW_CHECK_EQ(payload.playerInfo.level, 12);
+    TW_CHECK_EQ(payload.alertData.healthPct, 100.0f);
+
+    raw.sections = kStatsSectionAll;
+    raw.limits.damageReductionCap = 90.0f;
+    DeriveStatsSections(raw, payload);
+    TW_CHECK_EQ(payload.resistances.fire.effective, 50.0f);
+    TW_CHECK_EQ(payload.caps.damageReduction, 90.0f);
+    TW_CHECK_EQ(payload.caps.armorRatingForMaxReduction, 90.0f / raw.limits.armorScalingFactor);
+}
@@ -0,0 +1,80 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local std::uint64_t tAllocations = 0;
+
+void* CountedAllocate(std::size_t size) noexcept
+{
+    ++tAllocations;
+    return std::malloc(size != 0 ? size : 1);
+}
+
+}  // namespace
+
+namespace TulliusWidgets::Tests {
+
+std::uint64_t ThreadAllocationCount() noexcept
+{
+    return tAllocations;
+}
+
+}  // namespace TulliusWidgets::Tests
+
+// Replaceable global allocation functions. The over-aligned overloads keep
+// their default implementations, which pair with each other independently.
+void* operator new(std::size_t size)
+{
+    if (void* data = CountedAllocate(size)) {
+        return data;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void* data) noexcept
+{
+    std::free(data);
+}
+
+void operator delete[](void* data) noexcept
+{
+    std::free(data);
+}
+
+void operator delete(void* data, std::size_t) noexcept
+{
+    std::free(data);
+}
+
+void operator delete[](void* data, std::size_t) noexcept
+{
+    std::free(data);
+}
+
+void operator delete(void* data, const std::nothrow_t&) noexcept
+{
+    std::free(data);
+}
+
+void operator delete[](void* data, const std::nothrow_t&) noexcept
+{
+    std::free(data);
+}
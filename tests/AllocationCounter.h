@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace TulliusWidgets::Tests {
+
+// Global operator new calls made by the current thread so far. Backed by the
+// replacement allocation functions in AllocationCounter.cpp.
+std::uint64_t ThreadAllocationCount() noexcept;
+
+// Counts allocations made by the current thread while the scope is alive.
+class AllocationScope {
+public:
+    AllocationScope() noexcept : start_(ThreadAllocationCount()) {}
+
+    std::uint64_t Count() const noexcept { return ThreadAllocationCount() - start_; }
+
+private:
+    std::uint64_t start_;
+};
+
+}  // namespace TulliusWidgets::Tests
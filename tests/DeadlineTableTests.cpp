@@ -0,0 +1,62 @@
+#include "DeadlineTable.h"
+#include "TestHarness.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace {
+
+using namespace TulliusWidgets::WidgetRuntime;
+using namespace std::chrono_literals;
+
+enum class TestTimer : std::uint8_t {
+    kFast,
+    kSlow,
+    kOneShot,
+    kCount
+};
+
+using Timers = DeadlineTable<TestTimer>;
+
+constexpr auto kStart = Timers::Clock::time_point{} + 1h;
+
+}  // namespace
+
+TW_TEST(DeadlineTable_ReportsTheEarliestArmedDeadline)
+{
+    Timers timers;
+    TW_CHECK(timers.Next() == Timers::Clock::time_point::max());
+    TW_CHECK_EQ(timers.TakeDue(kStart + 24h), std::uint32_t{ 0 });
+
+    timers.Arm(TestTimer::kSlow, kStart + 2s);
+    timers.Arm(TestTimer::kFast, kStart + 500ms);
+    TW_CHECK(timers.Next() == kStart + 500ms);
+
+    // Re-arming moves a deadline either way.
+    timers.Arm(TestTimer::kOneShot, kStart + 300ms);
+    TW_CHECK(timers.Next() == kStart + 300ms);
+    timers.Arm(TestTimer::kOneShot, kStart + 900ms);
+    TW_CHECK(timers.Next() == kStart + 500ms);
+    timers.Disarm(TestTimer::kFast);
+    TW_CHECK(!timers.IsArmed(TestTimer::kFast));
+    TW_CHECK(timers.Next() == kStart + 900ms);
+}
+
+TW_TEST(DeadlineTable_TakesEveryDueTimerOnce)
+{
+    Timers timers;
+    timers.Arm(TestTimer::kFast, kStart + 500ms);
+    timers.Arm(TestTimer::kSlow, kStart + 2s);
+    timers.Arm(TestTimer::kOneShot, kStart + 500ms);
+
+    TW_CHECK_EQ(timers.TakeDue(kStart + 499ms), std::uint32_t{ 0 });
+    // A deadline is due at its exact time, not the next tick after it.
+    TW_CHECK_EQ(timers.TakeDue(kStart + 500ms), Timers::Bit(TestTimer::kFast) | Timers::Bit(TestTimer::kOneShot));
+    TW_CHECK(!timers.IsArmed(TestTimer::kFast));
+    TW_CHECK(timers.IsArmed(TestTimer::kSlow));
+    TW_CHECK_EQ(timers.TakeDue(kStart + 500ms), std::uint32_t{ 0 });
+    TW_CHECK(timers.Next() == kStart + 2s);
+
+    timers.DisarmAll();
+    TW_CHECK_EQ(timers.TakeDue(kStart + 1h), std::uint32_t{ 0 });
+}
@@ -0,0 +1,67 @@
+#include "EvaluationMemo.h"
+#include "TestHarness.h"
+
+#include <string>
+
+namespace {
+
+using namespace TulliusWidgets::StatsCollectorInternal;
+
+struct TestKey {
+    std::uint32_t weapon{ 0 };
+    std::uint32_t epoch{ 0 };
+
+    bool operator==(const TestKey&) const = default;
+};
+
+}  // namespace
+
+TW_TEST(EvaluationMemo_ReevaluatesOnlyWhenTheKeyChanges)
+{
+    EvaluationMemo<TestKey, float> memo;
+    int evaluations = 0;
+    const auto evaluate = [&evaluations]() {
+        ++evaluations;
+        return 12.5f * static_cast<float>(evaluations);
+    };
+
+    TW_CHECK_EQ(memo.Get(TestKey{ 1, 0 }, evaluate), 12.5f);
+    TW_CHECK_EQ(memo.Get(TestKey{ 1, 0 }, evaluate), 12.5f);
+    TW_CHECK_EQ(evaluations, 1);
+
+    TW_CHECK_EQ(memo.Get(TestKey{ 1, 1 }, evaluate), 25.0f);
+    TW_CHECK_EQ(memo.Get(TestKey{ 2, 1 }, evaluate), 37.5f);
+    TW_CHECK_EQ(evaluations, 3);
+
+    memo.Invalidate();
+    TW_CHECK_EQ(memo.Get(TestKey{ 2, 1 }, evaluate), 50.0f);
+
+    const auto stats = memo.Counters().Snapshot();
+    TW_CHECK_EQ(stats.hits, std::uint64_t{ 1 });
+    TW_CHECK_EQ(stats.misses, std::uint64_t{ 4 });
+}
+
+TW_TEST(StatsDiagnostics_EstimatesSavedTimeFromMeanMissCost)
+{
+    MemoCounters counters;
+    TW_CHECK_EQ(counters.Snapshot().SavedNanoseconds(), std::uint64_t{ 0 });
+
+    counters.RecordMiss(std::chrono::microseconds(30));
+    counters.RecordMiss(std::chrono::microseconds(50));
+    for (int i = 0; i < 10; ++i) {
+        counters.RecordHit();
+    }
+
+    const auto stats = counters.Snapshot();
+    TW_CHECK_EQ(stats.SavedNanoseconds(), std::uint64_t{ 400000 });
+
+    std::string json;
+    AppendMemoStatsJson(json, "critChanceMemo", stats);
+    TW_CHECK_EQ(json, std::string(R"("critChanceMemo":{"hits":10,"misses":2,"missUs":80,"savedUs":400})"));
+
+    auto combined = stats;
+    combined += MemoStats{ 5, 1, 70000 };
+    TW_CHECK_EQ(combined.hits, std::uint64_t{ 15 });
+    TW_CHECK_EQ(combined.misses, std::uint64_t{ 3 });
+    TW_CHECK_EQ(combined.SavedNanoseconds(), std::uint64_t{ 750000 });
+}
@@ -0,0 +1,201 @@
+#include "AllocationCounter.h"
+#include "GameTaskQueue.h"
+#include "TestHarness.h"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace TulliusWidgets;
+using TulliusWidgets::Tests::AllocationScope;
+
+// Handlers are plain function pointers; they record into this.
+std::vector<GameTask> g_ran;
+GameTaskQueue* g_queue = nullptr;
+
+void Record(const GameTask& task)
+{
+    g_ran.push_back(GameTask{ task.kind, task.a, task.b, {} });
+}
+
+void RecordAndRepost(const GameTask& task)
+{
+    Record(task);
+    g_queue->Post(GameTaskKind::kStatsDispatch, task.a + 1);
+}
+
+void RecordSlowly(const GameTask& task)
+{
+    Record(task);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+}  // namespace
+
+TW_TEST(GameTaskQueue_GoesThroughTheTaskInterfaceUntilDrainedPerFrame)
+{
+    HostFakes::ResetGameState();
+    g_ran.clear();
+    GameTaskQueue queue;
+    queue.SetHandler(GameTaskKind::kStatsDispatch, &Record);
+
+    // Nothing runs on the posting thread; one task-interface drain carries
+    // every post made before it runs.
+    queue.Post(GameTaskKind::kStatsDispatch, 1);
+    bool called = false;
+    queue.PostCallback([&called]() { called = true; });
+    queue.Post(GameTaskKind::kStatsDispatch, 1);
+    TW_CHECK(g_ran.empty());
+    TW_CHECK(!called);
+    TW_CHECK_EQ(queue.Pending(), std::size_t{ 2 });
+    TW_CHECK_EQ(HostFakes::RunGameTasks(), std::size_t{ 1 });
+    TW_CHECK_EQ(g_ran.size(), std::size_t{ 1 });
+    TW_CHECK(called);
+    TW_CHECK_EQ(queue.Pending(), std::size_t{ 0 });
+
+    // A kind without a handler is dropped.
+    queue.Post(GameTaskKind::kImportPreset);
+    TW_CHECK_EQ(HostFakes::RunGameTasks(), std::size_t{ 1 });
+    TW_CHECK_EQ(g_ran.size(), std::size_t{ 1 });
+
+    // Once the frame hook drains it, posts no longer reach the interface.
+    queue.SetDrainedPerFrame(true);
+    queue.Post(GameTaskKind::kStatsDispatch, 2);
+    TW_CHECK_EQ(HostFakes::RunGameTasks(), std::size_t{ 0 });
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 1 });
+    TW_CHECK_EQ(g_ran.size(), std::size_t{ 2 });
+}
+
+TW_TEST(GameTaskQueue_CoalescesIdenticalTasksAndKeepsOrder)
+{
+    g_ran.clear();
+    GameTaskQueue queue;
+    queue.SetDrainedPerFrame(true);
+    queue.SetHandler(GameTaskKind::kStatsDispatch, &Record);
+    queue.SetHandler(GameTaskKind::kSetSettingsOpen, &Record);
+    queue.SetHandler(GameTaskKind::kToggleWidgetsVisibility, &Record);
+
+    queue.Post(GameTaskKind::kStatsDispatch, 0);
+    queue.Post(GameTaskKind::kSetSettingsOpen, 1);
+    queue.Post(GameTaskKind::kStatsDispatch, 0);
+    queue.Post(GameTaskKind::kSetSettingsOpen, 0);
+    queue.Post(GameTaskKind::kStatsDispatch, 1);
+    queue.Post(GameTaskKind::kSetSettingsOpen, 1);
+    queue.Post(GameTaskKind::kToggleWidgetsVisibility);
+    queue.Post(GameTaskKind::kToggleWidgetsVisibility);
+    int callbacks = 0;
+    queue.PostCallback([&callbacks]() { ++callbacks; });
+    queue.PostCallback([&callbacks]() { ++callbacks; });
+    TW_CHECK(g_ran.empty());
+    TW_CHECK_EQ(queue.Pending(), std::size_t{ 9 });
+
+    // Only the repeated stats request folds away; open, close, open ends
+    // open and both toggles run.
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 9 });
+    TW_CHECK_EQ(g_ran.size(), std::size_t{ 7 });
+    TW_CHECK(g_ran[0].kind == GameTaskKind::kStatsDispatch && g_ran[0].a == 0);
+    TW_CHECK(g_ran[1].kind == GameTaskKind::kSetSettingsOpen && g_ran[1].a == 1);
+    TW_CHECK(g_ran[2].kind == GameTaskKind::kSetSettingsOpen && g_ran[2].a == 0);
+    TW_CHECK(g_ran[3].kind == GameTaskKind::kStatsDispatch && g_ran[3].a == 1);
+    TW_CHECK(g_ran[4].kind == GameTaskKind::kSetSettingsOpen && g_ran[4].a == 1);
+    TW_CHECK(g_ran[5].kind == GameTaskKind::kToggleWidgetsVisibility);
+    TW_CHECK(g_ran[6].kind == GameTaskKind::kToggleWidgetsVisibility);
+    TW_CHECK_EQ(callbacks, 2);
+
+    const auto counters = queue.GetCounters();
+    TW_CHECK_EQ(counters.posted, std::uint64_t{ 10 });
+    TW_CHECK_EQ(counters.coalesced, std::uint64_t{ 1 });
+    TW_CHECK_EQ(counters.run, std::uint64_t{ 9 });
+}
+
+TW_TEST(GameTaskQueue_LeavesTasksPostedDuringADrainForTheNextOne)
+{
+    g_ran.clear();
+    GameTaskQueue queue;
+    g_queue = &queue;
+    queue.SetDrainedPerFrame(true);
+    queue.SetHandler(GameTaskKind::kStatsDispatch, &RecordAndRepost);
+
+    queue.Post(GameTaskKind::kStatsDispatch, 0);
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 1 });
+    TW_CHECK_EQ(queue.Pending(), std::size_t{ 1 });
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 1 });
+    TW_CHECK_EQ(g_ran.size(), std::size_t{ 2 });
+    TW_CHECK_EQ(g_ran[1].a, std::uint64_t{ 1 });
+    g_queue = nullptr;
+}
+
+TW_TEST(GameTaskQueue_StopsAtTheFrameBudget)
+{
+    g_ran.clear();
+    GameTaskQueue queue;
+    queue.SetDrainedPerFrame(true);
+    queue.SetFrameBudget(std::chrono::microseconds(1));
+    TW_CHECK(queue.FrameBudget() == kMinGameTaskBudget);
+    queue.SetHandler(GameTaskKind::kStatsDispatch, &RecordSlowly);
+
+    for (std::uint64_t i = 0; i < 3; ++i) {
+        queue.Post(GameTaskKind::kStatsDispatch, i);
+    }
+    // Each task outlasts the budget, so every drain runs exactly one.
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 1 });
+    TW_CHECK_EQ(queue.Pending(), std::size_t{ 2 });
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 1 });
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 1 });
+    TW_CHECK_EQ(queue.Drain(), std::size_t{ 0 });
+    TW_CHECK_EQ(queue.GetCounters().deferred, std::uint64_t{ 2 });
+    TW_CHECK_EQ(g_ran.size(), std::size_t{ 3 });
+    TW_CHECK_EQ(g_ran[2].a, std::uint64_t{ 2 });
+}
+
+TW_TEST(GameTaskQueue_GrowsPastItsInitialCapacityWithoutLosingOrder)
+{
+    g_ran.clear();
+    GameTaskQueue queue;
+    queue.SetDrainedPerFrame(true);
+    queue.SetFrameBudget(kMaxGameTaskBudget);
+    queue.SetHandler(GameTaskKind::kStatsDispatch, &Record);
+
+    // Wrap the ring once before it has to grow.
+    queue.Post(GameTaskKind::kStatsDispatch, 1000);
+    (void)queue.Drain();
+    g_ran.clear();
+
+    constexpr std::uint64_t kTasks = GameTaskQueue::kInitialCapacity * 3;
+    for (std::uint64_t i = 0; i < kTasks; ++i) {
+        queue.Post(GameTaskKind::kStatsDispatch, i);
+    }
+    TW_CHECK_EQ(queue.Pending(), std::size_t{ kTasks });
+    while (queue.Pending() > 0) {
+        (void)queue.Drain();
+    }
+    TW_CHECK_EQ(g_ran.size(), std::size_t{ kTasks });
+    bool ordered = true;
+    for (std::uint64_t i = 0; i < kTasks; ++i) {
+        ordered = ordered && g_ran[i].a == i;
+    }
+    TW_CHECK(ordered);
+}
+
+TW_TEST(GameTaskQueue_TypedTasksDoNotAllocate)
+{
+    g_ran.clear();
+    g_ran.reserve(GameTaskQueue::kInitialCapacity);
+    GameTaskQueue queue;
+    queue.SetDrainedPerFrame(true);
+    queue.SetFrameBudget(kMaxGameTaskBudget);
+    queue.SetHandler(GameTaskKind::kStatsDispatch, &Record);
+
+    AllocationScope allocations;
+    for (int frame = 0; frame < 100; ++frame) {
+        queue.Post(GameTaskKind::kStatsDispatch, 1);
+        queue.Post(GameTaskKind::kStatsDispatch, 0);
+        queue.Post(GameTaskKind::kStatsDispatch, 1);
+        (void)queue.Drain();
+        g_ran.clear();
+    }
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+}
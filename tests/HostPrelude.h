@@ -0,0 +1,10 @@
+#pragma once
+
+// Force-included into host test/bench builds in place of src/pch.h. Swaps
+// CommonLibSSE and SKSE for the fake engine layer in tests/host, so the
+// game-independent plugin sources compile and run off Windows.
+#include "host/FakeGame.h"
+
+using namespace std::literals;
+
+namespace logger = SKSE::log;
@@ -0,0 +1,302 @@
+#include "FakePrismaUI.h"
+#include "NativeStorage.h"
+#include "TestHarness.h"
+#include "WidgetInteropContracts.h"
+#include "WidgetRuntime.h"
+#include "WidgetViewBridge.h"
+#include "WidgetVisibilityState.h"
+#include "keyhandler/keyhandler.h"
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using namespace TulliusWidgets;
+using HostFakes::FakePrismaUI;
+
+constexpr std::string_view kStatsJson = R"({"schemaVersion":1,"seq":1,"keyframe":true})";
+
+// Wires WidgetRuntime to a fake PrismaUI view through the real view bridge,
+// the same way main.cpp does.
+struct RuntimeFixture {
+    FakePrismaUI prisma;
+    WidgetViewBridge::Runtime bridge;
+    int collectCalls{ 0 };
+    int buildCalls{ 0 };
+    int keyframeRequests{ 0 };
+    bool interopFails{ false };
+    // What the builder reports: whether it found a capture, and the payload.
+    bool hasCapture{ true };
+    std::string_view built{ kStatsJson };
+    std::function<void()> onBuild;
+
+    RuntimeFixture()
+    {
+        HostFakes::ResetGameState();
+        WidgetVisibilityState::Reset();
+        bridge.SetApi(&prisma);
+        bridge.SetView(prisma.CreateView("index.html"));
+        bridge.SetDomReady(true);
+
+        WidgetRuntime::Callbacks callbacks{};
+        callbacks.isInteropReady = [this]() { return bridge.IsInteropReady(); };
+        callbacks.hasViewFocus = [this]() { return bridge.HasFocus(); };
+        callbacks.captureStats = [this](WidgetRuntime::UpdateRateSample&) {
+            ++collectCalls;
+            return true;
+        };
+        callbacks.buildStatsJson = [this](std::string_view& json) {
+            ++buildCalls;
+            if (onBuild) onBuild();
+            json = built;
+            return hasCapture;
+        };
+        callbacks.interopCall = [this](const char* functionName, const char* argument) {
+            return !interopFails && bridge.InteropCall(functionName, argument);
+        };
+        callbacks.requestKeyframe = [this]() { ++keyframeRequests; };
+        callbacks.showView = [this]() { return bridge.Show(); };
+        callbacks.hideView = [this]() { (void)bridge.Hide(); };
+        WidgetRuntime::Initialize(callbacks);
+        WidgetRuntime::SetGameLoaded(true);
+    }
+
+    ~RuntimeFixture()
+    {
+        WidgetRuntime::SetFrameCoalescing(false);
+        // Run what is still queued for the game thread before it is dropped.
+        HostFakes::RunGameTasks();
+        WidgetRuntime::SetGameLoaded(false);
+        WidgetRuntime::Initialize({});
+        HostFakes::ResetGameState();
+    }
+};
+
+}  // namespace
+
+TW_TEST(WidgetRuntime_DispatchesStatsThroughPrismaInterop)
+{
+    RuntimeFixture fixture;
+    const auto before = WidgetRuntime::GetDispatchCounters();
+
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.prisma.interopCalls.size(), std::size_t{ 1 });
+    if (!fixture.prisma.interopCalls.empty()) {
+        TW_CHECK_EQ(fixture.prisma.interopCalls[0].functionName, std::string(WidgetInteropContracts::kUpdateStats));
+        TW_CHECK_EQ(fixture.prisma.interopCalls[0].argument, std::string(kStatsJson));
+    }
+
+    // An unforced request right after is inside the throttle interval.
+    WidgetRuntime::RequestStatsDispatch(false);
+    const auto after = WidgetRuntime::GetDispatchCounters();
+    TW_CHECK_EQ(after.sent - before.sent, std::uint64_t{ 1 });
+    TW_CHECK_EQ(after.skippedThrottled - before.skippedThrottled, std::uint64_t{ 1 });
+    TW_CHECK_EQ(fixture.collectCalls, 1);
+}
+
+TW_TEST(WidgetRuntime_AsksForAKeyframeWhenADeliveryFails)
+{
+    RuntimeFixture fixture;
+    const auto before = WidgetRuntime::GetDispatchCounters();
+
+    fixture.interopFails = true;
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.buildCalls, 1);
+    TW_CHECK_EQ(fixture.keyframeRequests, 1);
+    auto after = WidgetRuntime::GetDispatchCounters();
+    TW_CHECK_EQ(after.sent - before.sent, std::uint64_t{ 0 });
+    TW_CHECK_EQ(after.failed - before.failed, std::uint64_t{ 1 });
+
+    fixture.interopFails = false;
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.keyframeRequests, 1);
+    after = WidgetRuntime::GetDispatchCounters();
+    TW_CHECK_EQ(after.sent - before.sent, std::uint64_t{ 1 });
+    TW_CHECK_EQ(after.failed - before.failed, std::uint64_t{ 1 });
+}
+
+TW_TEST(WidgetRuntime_CountsOnlyMatchingFingerprintsAsUnchanged)
+{
+    RuntimeFixture fixture;
+    const auto before = WidgetRuntime::GetDispatchCounters();
+
+    // The builder had already taken the capture: nothing was skipped.
+    fixture.hasCapture = false;
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.buildCalls, 1);
+    auto after = WidgetRuntime::GetDispatchCounters();
+    TW_CHECK_EQ(after.skippedUnchanged - before.skippedUnchanged, std::uint64_t{ 0 });
+
+    fixture.hasCapture = true;
+    fixture.built = {};
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.buildCalls, 2);
+    after = WidgetRuntime::GetDispatchCounters();
+    TW_CHECK_EQ(after.skippedUnchanged - before.skippedUnchanged, std::uint64_t{ 1 });
+    TW_CHECK(fixture.prisma.interopCalls.empty());
+    TW_CHECK_EQ(after.sent - before.sent, std::uint64_t{ 0 });
+}
+
+TW_TEST(WidgetRuntime_BuildsOnlyTheNewestCaptureAfterABuild)
+{
+    RuntimeFixture fixture;
+    const auto before = WidgetRuntime::GetDispatchCounters();
+
+    // Requests made while a payload is being built capture right away; the
+    // builder then skips to the newest of them once it was delivered.
+    int nestedRounds = 0;
+    fixture.onBuild = [&]() {
+        if (nestedRounds < 2) {
+            ++nestedRounds;
+            WidgetRuntime::RequestStatsDispatch(true);
+            WidgetRuntime::RequestStatsDispatch(true);
+            TW_CHECK_EQ(fixture.collectCalls, 1 + nestedRounds * 2);
+            TW_CHECK_EQ(fixture.prisma.interopCalls.size(), static_cast<std::size_t>(nestedRounds - 1));
+        }
+    };
+
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.collectCalls, 5);
+    TW_CHECK_EQ(fixture.buildCalls, 3);
+    TW_CHECK_EQ(fixture.prisma.interopCalls.size(), std::size_t{ 3 });
+    TW_CHECK_EQ(WidgetRuntime::GetDispatchCounters().sent - before.sent, std::uint64_t{ 3 });
+}
+
+TW_TEST(WidgetRuntime_CoalescesRequestsIntoOneDispatchPerFrame)
+{
+    RuntimeFixture fixture;
+    WidgetRuntime::SetFrameCoalescing(true);
+    const auto before = WidgetRuntime::GetDispatchCounters();
+
+    WidgetRuntime::RequestStatsDispatch(false);
+    WidgetRuntime::RequestStatsDispatch(true);
+    WidgetRuntime::RequestStatsDispatch(false);
+    TW_CHECK_EQ(fixture.collectCalls, 0);
+
+    // The forced request wins, so the throttle does not drop the frame.
+    WidgetRuntime::RunFrameStatsDispatch();
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.collectCalls, 1);
+    TW_CHECK_EQ(fixture.prisma.interopCalls.size(), std::size_t{ 1 });
+    WidgetRuntime::RunFrameStatsDispatch();
+    TW_CHECK_EQ(fixture.collectCalls, 1);
+
+    const auto after = WidgetRuntime::GetDispatchCounters();
+    TW_CHECK_EQ(after.requested - before.requested, std::uint64_t{ 3 });
+    TW_CHECK_EQ(after.coalesced - before.coalesced, std::uint64_t{ 2 });
+    TW_CHECK_EQ(after.skippedThrottled - before.skippedThrottled, std::uint64_t{ 0 });
+
+    // Turning coalescing off runs what is still pending.
+    WidgetRuntime::RequestStatsDispatch(true);
+    WidgetRuntime::SetFrameCoalescing(false);
+    TW_CHECK_EQ(fixture.collectCalls, 2);
+}
+
+TW_TEST(WidgetRuntime_HoldsStatsWhileBlockingMenuIsOpen)
+{
+    RuntimeFixture fixture;
+    RE::UI::GetSingleton()->openMenus.emplace_back(RE::InventoryMenu::MENU_NAME);
+
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK(fixture.prisma.interopCalls.empty());
+    TW_CHECK_EQ(fixture.collectCalls, 0);
+
+    RE::UI::GetSingleton()->openMenus.clear();
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.prisma.interopCalls.size(), std::size_t{ 1 });
+
+    fixture.bridge.SetDomReady(false);
+    WidgetRuntime::RequestStatsDispatch(true);
+    HostFakes::RunGameTasks();
+    TW_CHECK_EQ(fixture.prisma.interopCalls.size(), std::size_t{ 1 });
+}
+
+TW_TEST(WidgetVisibilityState_TracksNestedTransientMenus)
+{
+    HostFakes::ResetGameState();
+    WidgetVisibilityState::Reset();
+    auto* ui = RE::UI::GetSingleton();
+    const RE::BSFixedString photoMode{ "PhotoMode" };
+
+    TW_CHECK(WidgetVisibilityState::ShouldHideForMenu(photoMode));
+    TW_CHECK(WidgetVisibilityState::ShouldHideForMenu(RE::BSFixedString{ RE::MapMenu::MENU_NAME }));
+    TW_CHECK(!WidgetVisibilityState::ShouldHideForMenu(RE::BSFixedString{ "HUD Menu" }));
+    TW_CHECK(!WidgetVisibilityState::IsBlockingUiState(ui));
+
+    WidgetVisibilityState::NoteMenuOpenClose(photoMode, true);
+    WidgetVisibilityState::NoteMenuOpenClose(photoMode, true);
+    WidgetVisibilityState::NoteMenuOpenClose(photoMode, false);
+    TW_CHECK(WidgetVisibilityState::IsBlockingUiState(ui));
+    WidgetVisibilityState::NoteMenuOpenClose(photoMode, false);
+    WidgetVisibilityState::NoteMenuOpenClose(photoMode, false);
+    TW_CHECK(!WidgetVisibilityState::IsBlockingUiState(ui));
+
+    // A focused widget menu pauses the game but still counts as visible.
+    ui->gamePaused = true;
+    TW_CHECK(WidgetVisibilityState::IsBlockingUiState(ui));
+    TW_CHECK(!WidgetVisibilityState::IsBlockingUiState(ui, true));
+    RE::PlayerCamera::GetSingleton()->freeCamera = true;
+    TW_CHECK(WidgetVisibilityState::IsBlockingUiState(ui, true));
+    HostFakes::ResetGameState();
+}
+
+TW_TEST(KeyHandler_RunsCallbacksForRegisteredKeyboardEvents)
+{
+    KeyHandler::RegisterSink();
+    KeyHandler::RegisterSink();
+    TW_CHECK_EQ(RE::BSInputDeviceManager::GetSingleton()->SinkCount(), std::size_t{ 1 });
+
+    constexpr std::uint32_t kKeyG = 0x22;
+    int downs = 0;
+    int ups = 0;
+    auto* handler = KeyHandler::GetSingleton();
+    const auto downHandle = handler->Register(kKeyG, KeyEventType::KEY_DOWN, [&downs]() { ++downs; });
+    const auto upHandle = handler->Register(kKeyG, KeyEventType::KEY_UP, [&ups]() { ++ups; });
+    TW_CHECK(downHandle != INVALID_REGISTRATION_HANDLE);
+    TW_CHECK_EQ(handler->Register(kKeyG, KeyEventType::KEY_DOWN, {}), INVALID_REGISTRATION_HANDLE);
+
+    HostFakes::SendKeyboardEvent(kKeyG, true);
+    HostFakes::SendKeyboardEvent(kKeyG, false);
+    HostFakes::SendKeyboardEvent(kKeyG + 1, true);
+    TW_CHECK_EQ(downs, 1);
+    TW_CHECK_EQ(ups, 1);
+
+    handler->Unregister(downHandle);
+    handler->Unregister(upHandle);
+    HostFakes::SendKeyboardEvent(kKeyG, true);
+    TW_CHECK_EQ(downs, 1);
+}
+
+TW_TEST(NativeStorage_RoundTripsSettingsWithinSizeLimit)
+{
+    const auto root = std::filesystem::temp_directory_path() / "tullius-widgets-host-tests";
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+
+    TW_CHECK(NativeStorage::LoadSettings(root).empty());
+    TW_CHECK(NativeStorage::SaveSettings(root, R"({"rev":1})"));
+    TW_CHECK(NativeStorage::SaveSettings(root, R"({"rev":2})"));
+    TW_CHECK_EQ(NativeStorage::LoadSettings(root), std::string(R"({"rev":2})"));
+
+    const std::string oversized(NativeStorage::kMaxSettingsFileBytes + 1, ' ');
+    TW_CHECK(!NativeStorage::SaveSettings(root, oversized));
+    TW_CHECK_EQ(NativeStorage::LoadSettings(root), std::string(R"({"rev":2})"));
+
+    TW_CHECK(NativeStorage::ExportPreset(root, R"({"preset":true})"));
+    std::string preset;
+    TW_CHECK(NativeStorage::LoadPreset(root, preset));
+    TW_CHECK_EQ(preset, std::string(R"({"preset":true})"));
+
+    std::filesystem::remove_all(root, ec);
+}
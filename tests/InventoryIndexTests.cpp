@@ -0,0 +1,83 @@
+#include "AllocationCounter.h"
+#include "InventoryIndex.h"
+#include "TestHarness.h"
+
+namespace {
+
+using namespace TulliusWidgets::StatsCollectorInternal;
+using TulliusWidgets::Tests::AllocationScope;
+
+constexpr std::uint32_t kIronArrow = 0x0001397D;
+constexpr std::uint32_t kSteelArrow = 0x0001397F;
+constexpr std::uint32_t kMinorHealing = 0x0003EADE;
+constexpr std::uint32_t kPlentifulHealing = 0x0003EAE3;
+constexpr std::uint32_t kIronSword = 0x00012EB7;
+
+}  // namespace
+
+TW_TEST(InventoryIndex_SeedsTotalsPerCategoryAndCountsPerForm)
+{
+    InventoryIndex index;
+    TW_CHECK(!index.IsSeeded());
+
+    index.Add(kGoldFormId, InventoryCategory::kGold, 3433);
+    index.Add(kIronArrow, InventoryCategory::kAmmo, 24);
+    index.Add(kSteelArrow, InventoryCategory::kAmmo, 12);
+    index.Add(kMinorHealing, InventoryCategory::kHealthPotion, 3);
+    index.Add(kPlentifulHealing, InventoryCategory::kHealthPotion, 2);
+    index.Add(kIronSword, InventoryCategory::kUntracked, 1);
+    index.MarkSeeded();
+
+    TW_CHECK(index.IsSeeded());
+    TW_CHECK_EQ(index.Total(InventoryCategory::kGold), 3433);
+    TW_CHECK_EQ(index.Count(kIronArrow), 24);
+    TW_CHECK_EQ(index.Count(kSteelArrow), 12);
+    TW_CHECK_EQ(index.Total(InventoryCategory::kHealthPotion), 5);
+    TW_CHECK_EQ(index.Total(InventoryCategory::kMagickaPotion), 0);
+    TW_CHECK_EQ(index.Count(kIronSword), 0);
+    TW_CHECK(index.FindCategory(kIronSword) != nullptr);
+    TW_CHECK(*index.FindCategory(kIronSword) == InventoryCategory::kUntracked);
+    TW_CHECK(index.FindCategory(0x00099999) == nullptr);
+}
+
+TW_TEST(InventoryIndex_AppliesDeltasWithoutGoingNegative)
+{
+    InventoryIndex index;
+    index.Add(kGoldFormId, InventoryCategory::kGold, 100);
+    index.Add(kMinorHealing, InventoryCategory::kHealthPotion, 2);
+    index.MarkSeeded();
+
+    index.Add(kGoldFormId, InventoryCategory::kGold, -40);
+    TW_CHECK_EQ(index.Total(InventoryCategory::kGold), 60);
+
+    // A removal larger than the count must not drag the total below the
+    // other potions of the same category.
+    index.Add(kPlentifulHealing, InventoryCategory::kHealthPotion, 1);
+    index.Add(kMinorHealing, InventoryCategory::kHealthPotion, -5);
+    TW_CHECK_EQ(index.Count(kMinorHealing), 0);
+    TW_CHECK_EQ(index.Total(InventoryCategory::kHealthPotion), 1);
+
+    index.Reset();
+    TW_CHECK(!index.IsSeeded());
+    TW_CHECK_EQ(index.Total(InventoryCategory::kGold), 0);
+    TW_CHECK(index.FindCategory(kGoldFormId) == nullptr);
+}
+
+TW_TEST(InventoryIndex_ReadsAndKnownFormDeltasDoNotAllocate)
+{
+    InventoryIndex index;
+    index.Add(kGoldFormId, InventoryCategory::kGold, 100);
+    index.Add(kIronArrow, InventoryCategory::kAmmo, 30);
+    index.MarkSeeded();
+
+    AllocationScope allocations;
+    for (int i = 0; i < 100; ++i) {
+        index.Add(kIronArrow, InventoryCategory::kAmmo, -1);
+        index.Add(kGoldFormId, InventoryCategory::kGold, 5);
+        (void)index.Count(kIronArrow);
+        (void)index.Total(InventoryCategory::kGold);
+    }
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+    TW_CHECK_EQ(index.Count(kIronArrow), 0);
+    TW_CHECK_EQ(index.Total(InventoryCategory::kGold), 600);
+}
@@ -0,0 +1,177 @@
+#include "JsonUtils.h"
+#include "TestHarness.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace {
+
+namespace JsonUtils = TulliusWidgets::JsonUtils;
+
+// The pre-change byte-by-byte escape; identical to the new one on valid UTF-8.
+std::string LegacyEscape(std::string_view input)
+{
+    std::string out;
+    for (const unsigned char c : input) {
+        switch (c) {
+        case '\\': out += "\\\\"; break;
+        case '"': out += "\\\""; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char buf[7];
+                std::snprintf(buf, sizeof(buf), "\\u%04X", static_cast<unsigned int>(c));
+                out += buf;
+            } else {
+                out += static_cast<char>(c);
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+std::string AppendEscapedTo(std::string_view prefix, std::string_view input)
+{
+    std::string out(prefix);
+    JsonUtils::AppendEscaped(out, input);
+    return out;
+}
+
+// Random mix of ASCII, escapable bytes and well-formed 2/3/4-byte sequences,
+// long enough to cross several 16-byte scan blocks.
+std::string RandomValidUtf8(std::mt19937& rng)
+{
+    static constexpr std::string_view kPieces[] = {
+        "a", "Z", " ", "0", "\"", "\\", "\n", "\t", "\x01", "\x1F", "\x7F",
+        "\xC3\xA9", "\xD0\x96", "\xEA\xB0\x80", "\xED\x9E\xA3", "\xE2\x80\x94", "\xEF\xBF\xBD",
+        "\xF0\x9F\x94\xA5", "\xF4\x8F\xBF\xBF", "Fortify ", "\xEC\x86\x8C\xEC\x9D\x8C ",
+    };
+    std::uniform_int_distribution<std::size_t> lengthDist(0, 64);
+    std::uniform_int_distribution<std::size_t> pieceDist(0, std::size(kPieces) - 1);
+    std::string out;
+    for (std::size_t i = lengthDist(rng); i > 0; --i) {
+        out += kPieces[pieceDist(rng)];
+    }
+    return out;
+}
+
+}  // namespace
+
+TW_TEST(AppendEscaped_EscapesQuotesBackslashesAndControlBytes)
+{
+    TW_CHECK_EQ(AppendEscapedTo("", "plain"), std::string("plain"));
+    TW_CHECK_EQ(AppendEscapedTo("", "a\"b\\c"), std::string("a\\\"b\\\\c"));
+    TW_CHECK_EQ(AppendEscapedTo("", "\b\f\n\r\t"), std::string("\\b\\f\\n\\r\\t"));
+    TW_CHECK_EQ(AppendEscapedTo("", std::string_view("\x00\x01\x1F", 3)), std::string("\\u0000\\u0001\\u001F"));
+    TW_CHECK_EQ(AppendEscapedTo("", "\x7F"), std::string("\x7F"));
+    TW_CHECK_EQ(AppendEscapedTo("{\"k\":\"", "v"), std::string("{\"k\":\"v"));
+    TW_CHECK_EQ(JsonUtils::Escape("Sword \"x\""), std::string("Sword \\\"x\\\""));
+}
+
+TW_TEST(AppendEscaped_PassesWellFormedUtf8Through)
+{
+    const std::string_view korean = "\xEC\x84\xB1\xEC\x8A\xA4\xEB\x9F\xAC\xEC\x9A\xB4 \xEA\xB0\x80\xED\x98\xB8";
+    TW_CHECK_EQ(AppendEscapedTo("", korean), std::string(korean));
+    TW_CHECK_EQ(AppendEscapedTo("", "\xF0\x9F\x94\xA5\"\xC3\xA9"), std::string("\xF0\x9F\x94\xA5\\\"\xC3\xA9"));
+}
+
+TW_TEST(AppendEscaped_ReplacesEachMaximalIllFormedSubpart)
+{
+    const std::string fffd = "\xEF\xBF\xBD";
+    // Lone continuation, invalid leads, overlongs, surrogates, > U+10FFFF.
+    TW_CHECK_EQ(AppendEscapedTo("", "a\x80z"), "a" + fffd + "z");
+    TW_CHECK_EQ(AppendEscapedTo("", "\xC0\xAF"), fffd + fffd);
+    TW_CHECK_EQ(AppendEscapedTo("", "\xE0\x80\xAF"), fffd + fffd + fffd);
+    TW_CHECK_EQ(AppendEscapedTo("", "\xED\xA0\x80"), fffd + fffd + fffd);
+    TW_CHECK_EQ(AppendEscapedTo("", "\xF4\x90\x80\x80"), fffd + fffd + fffd + fffd);
+    TW_CHECK_EQ(AppendEscapedTo("", "\xF5"), fffd);
+    // Truncated sequences collapse to one replacement each.
+    TW_CHECK_EQ(AppendEscapedTo("", "\xE2\x80"), fffd);
+    TW_CHECK_EQ(AppendEscapedTo("", "\xF0\x9F\x94"), fffd);
+    TW_CHECK_EQ(AppendEscapedTo("", "\xE2\x80z\xE2\x80\x94"), fffd + "z\xE2\x80\x94");
+    TW_CHECK_EQ(AppendEscapedTo("", "\xEA\xB0\x22"), fffd + "\\\"");
+}
+
+TW_TEST(AppendEscaped_MatchesLegacyEscapeOnRandomValidInput)
+{
+    std::mt19937 rng(0x7A11u);
+    int mismatches = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const auto input = RandomValidUtf8(rng);
+        if (AppendEscapedTo("", input) != LegacyEscape(input)) {
+            ++mismatches;
+        }
+    }
+    TW_CHECK_EQ(mismatches, 0);
+}
+
+TW_TEST(FindEscapeCandidate_ScannersAgreeAtEveryOffset)
+{
+    namespace Detail = JsonUtils::Detail;
+    std::mt19937 rng(0x5CA7u);
+    std::uniform_int_distribution<int> byteDist(0x20, 0x7E);
+    std::uniform_int_distribution<int> specialDist(0, 255);
+    int mismatches = 0;
+    for (int length = 0; length <= 48; ++length) {
+        for (int position = 0; position <= length; ++position) {
+            std::string text(static_cast<std::size_t>(length), 'x');
+            for (auto& ch : text) {
+                ch = static_cast<char>(byteDist(rng));
+                if (ch == '"' || ch == '\\') ch = 'q';
+            }
+            if (position < length) {
+                int special = specialDist(rng);
+                while (special >= 0x20 && special < 0x80 && special != '"' && special != '\\') {
+                    special = specialDist(rng);
+                }
+                text[static_cast<std::size_t>(position)] = static_cast<char>(special);
+            }
+            const char* begin = text.data();
+            const char* end = begin + text.size();
+            const auto expected = static_cast<std::size_t>(position);
+            mismatches += Detail::FindEscapeCandidateScalar(begin, end) != expected;
+            mismatches += Detail::FindEscapeCandidateSwar(begin, end) != expected;
+#if defined(TULLIUS_WIDGETS_JSON_SSE2)
+            mismatches += Detail::FindEscapeCandidateSse2(begin, end) != expected;
+#endif
+        }
+    }
+    TW_CHECK_EQ(mismatches, 0);
+}
+
+TW_TEST(NormalizeDisplayText_CollapsesControlsAndWhitespace)
+{
+    const auto normalize = [](std::string text) {
+        JsonUtils::NormalizeDisplayText(text);
+        return text;
+    };
+    TW_CHECK_EQ(normalize("  Fortify\tHealth \r\n"), std::string("Fortify Health"));
+    TW_CHECK_EQ(normalize("a\x01\x7F" "b"), std::string("a b"));
+    TW_CHECK_EQ(normalize("\xEC\x86\x8C   \xEC\x9D\x8C"), std::string("\xEC\x86\x8C \xEC\x9D\x8C"));
+    TW_CHECK_EQ(normalize(" \t\n"), std::string());
+    TW_CHECK_EQ(normalize(""), std::string());
+}
+
+TW_TEST(NormalizeDisplayText_CollapsesUnicodeSpaces)
+{
+    const auto normalize = [](std::string text) {
+        JsonUtils::NormalizeDisplayText(text);
+        return text;
+    };
+    // NBSP, ideographic space, thin space and a line separator, as in
+    // localized effect names.
+    TW_CHECK_EQ(normalize("\xC2\xA0" "Fortify\xC2\xA0\xC2\xA0" "Health\xE3\x80\x80"), std::string("Fortify Health"));
+    TW_CHECK_EQ(normalize("\xEC\xB2\xB4\xEB\xA0\xA5\xE3\x80\x80\xEA\xB0\x95\xED\x99\x94"), std::string("\xEC\xB2\xB4\xEB\xA0\xA5 \xEA\xB0\x95\xED\x99\x94"));
+    TW_CHECK_EQ(normalize("a\xE2\x80\x89 \xE2\x80\xA8" "b\xEF\xBB\xBF"), std::string("a b"));
+    // Neighbouring characters of the same lead bytes are left alone.
+    TW_CHECK_EQ(normalize("\xC2\xA9 \xE2\x80\x94 \xE3\x80\x81"), std::string("\xC2\xA9 \xE2\x80\x94 \xE3\x80\x81"));
+    TW_CHECK_EQ(normalize("\xE2\x80"), std::string("\xE2\x80"));
+}
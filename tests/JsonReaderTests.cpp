@@ -0,0 +1,97 @@
+#include "AllocationCounter.h"
+#include "JsonReader.h"
+#include "TestHarness.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+namespace JsonUtils = TulliusWidgets::JsonUtils;
+using TulliusWidgets::Tests::AllocationScope;
+
+bool IsWellFormed(std::string_view input)
+{
+    return JsonUtils::ScanTopLevelFields(input, [](const JsonUtils::JsonField&) {});
+}
+
+std::optional<std::uint32_t> ReadTopLevelUInt(std::string_view input, std::string_view key)
+{
+    std::optional<std::uint32_t> value;
+    const bool wellFormed = JsonUtils::ScanTopLevelFields(input, [&](const JsonUtils::JsonField& field) {
+        if (field.key == key) value = JsonUtils::ReadUInt32(field);
+    });
+    return wellFormed ? value : std::nullopt;
+}
+
+}  // namespace
+
+TW_TEST(ScanTopLevelFields_ReportsOnlyTopLevelMembersInOrder)
+{
+    std::vector<std::string> seen;
+    const bool ok = JsonUtils::ScanTopLevelFields(
+        R"( { "a" : 1, "nested": {"rev": 9, "x": [1, {"rev": 8}]}, "s": "q\"rev\":7", "t": true, "n": null, "rev": 42 } )",
+        [&](const JsonUtils::JsonField& field) {
+            seen.push_back(std::string(field.key) + "=" + std::string(field.raw));
+        });
+    TW_CHECK(ok);
+    TW_CHECK_EQ(seen.size(), std::size_t{ 6 });
+    TW_CHECK_EQ(seen[1], std::string(R"(nested={"rev": 9, "x": [1, {"rev": 8}]})"));
+    TW_CHECK_EQ(seen[2], std::string(R"(s=q\"rev\":7)"));
+    TW_CHECK_EQ(seen[5], std::string("rev=42"));
+}
+
+TW_TEST(ScanTopLevelFields_IgnoresKeysInsideStringsAndNestedObjects)
+{
+    TW_CHECK(!ReadTopLevelUInt(R"({"positions":{"rev":5},"label":"\"rev\": 6"})", "rev").has_value());
+    TW_CHECK_EQ(ReadTopLevelUInt(R"({"positions":{"rev":5},"rev":12})", "rev"), std::optional<std::uint32_t>(12));
+    TW_CHECK_EQ(ReadTopLevelUInt(R"({"rev":0})", "rev"), std::optional<std::uint32_t>(0));
+    TW_CHECK_EQ(ReadTopLevelUInt(R"({"rev":4294967295})", "rev"), std::optional<std::uint32_t>(4294967295u));
+}
+
+TW_TEST(ReadUInt32_RejectsValuesThatAreNotUnsigned32BitIntegers)
+{
+    for (const auto* input : {
+             R"({"rev":-1})", R"({"rev":1.5})", R"({"rev":1e3})", R"({"rev":4294967296})",
+             R"({"rev":"7"})", R"({"rev":true})", R"({"rev":null})", R"({"rev":[1]})" }) {
+        TW_CHECK(IsWellFormed(input));
+        TW_CHECK(!ReadTopLevelUInt(input, "rev").has_value());
+    }
+}
+
+TW_TEST(ScanTopLevelFields_RejectsMalformedDocuments)
+{
+    for (const auto* input : {
+             "", "[]", "1", R"("s")", "{", "}", R"({"a"})", R"({"a":})", R"({"a":1,})", R"({"a":1}{})",
+             R"({"a":1} x)", R"({a:1})", R"({"a":[1,]})", R"({"a":[1 2]})", R"({"a":{"b"}})", R"({"a":{,}})",
+             R"({"a":01})", R"({"a":1.})", R"({"a":-})", R"({"a":1e})", R"({"a":tru})", R"({"a":"\x"})",
+             R"({"a":"\u12G4"})", "{\"a\":\"line\nbreak\"}", R"({"a":"unterminated})", R"({"a":[}])", R"({"a":{]})" }) {
+        TW_CHECK(!IsWellFormed(input));
+    }
+    for (const auto* input : {
+             "{}", " {\t}\r\n", R"({"a":[]})", R"({"a":{}})", R"({"a":[[],[{}]]})", R"({"a":-0.5e+10})",
+             R"({"a":"é\n\/"})", R"({"rev":1})" }) {
+        TW_CHECK(IsWellFormed(input));
+    }
+}
+
+TW_TEST(ScanTopLevelFields_CapsNestingDepthAndDoesNotAllocate)
+{
+    const auto nested = [](std::size_t depth) {
+        return "{\"a\":" + std::string(depth, '[') + std::string(depth, ']') + "}";
+    };
+    const auto atLimit = nested(JsonUtils::kMaxJsonDepth);
+    const auto overLimit = nested(JsonUtils::kMaxJsonDepth + 1);
+    const std::string escapedKey = R"({"r\u0065v":3})";
+
+    AllocationScope allocations;
+    TW_CHECK(IsWellFormed(atLimit));
+    TW_CHECK(!IsWellFormed(overLimit));
+    TW_CHECK(JsonUtils::ScanTopLevelFields(escapedKey, [](const JsonUtils::JsonField& field) {
+        TW_CHECK(field.keyEscaped);
+    }));
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+}
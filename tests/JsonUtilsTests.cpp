@@ -0,0 +1,132 @@
+#include "JsonUtils.h"
+#include "TestHarness.h"
+
+#include <bit>
+#include <cfloat>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+namespace {
+
+using TulliusWidgets::JsonUtils::AppendFixed2;
+using TulliusWidgets::JsonUtils::AppendInteger;
+
+std::string FormatWithPrintf(float value)
+{
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.2f", static_cast<double>(value));
+    return buf;
+}
+
+std::string FormatFixed2(float value)
+{
+    std::string out = "prefix:";
+    AppendFixed2(out, value);
+    return out.substr(7);
+}
+
+// Returns the number of mismatches so sweeps report once instead of
+// flooding the log.
+int CheckParity(float value)
+{
+    if (!std::isfinite(value)) return 0;
+    const auto expected = FormatWithPrintf(value);
+    const auto actual = FormatFixed2(value);
+    if (expected == actual) return 0;
+
+    static int reported = 0;
+    if (reported++ < 16) {
+        std::fprintf(stderr, "  %%.2f mismatch for %a: printf=%s ours=%s\n",
+            static_cast<double>(value), expected.c_str(), actual.c_str());
+    }
+    return 1;
+}
+
+}  // namespace
+
+TW_TEST(AppendFixed2_NonFiniteValuesWriteZero)
+{
+    TW_CHECK_EQ(FormatFixed2(std::numeric_limits<float>::quiet_NaN()), std::string("0"));
+    TW_CHECK_EQ(FormatFixed2(-std::numeric_limits<float>::quiet_NaN()), std::string("0"));
+    TW_CHECK_EQ(FormatFixed2(std::numeric_limits<float>::infinity()), std::string("0"));
+    TW_CHECK_EQ(FormatFixed2(-std::numeric_limits<float>::infinity()), std::string("0"));
+}
+
+TW_TEST(AppendFixed2_MatchesPrintfForEdgeValues)
+{
+    const float values[] = {
+        0.0f, -0.0f, 0.001f, -0.001f, 0.005f, -0.005f, 0.004999f, 0.015f, 0.125f, -0.125f,
+        0.375f, 2.675f, 1.005f, 85.0f, -100.0f, 666.67f, 241.71f, 1280.25f, 9999.0f,
+        16777216.0f, 16777217.0f, 1e10f, 9.0e13f, 9.1e13f, 1e15f, -1e15f, 1e20f, 1e30f,
+        FLT_MIN, -FLT_MIN, FLT_TRUE_MIN, -FLT_TRUE_MIN, FLT_MAX, -FLT_MAX, FLT_EPSILON,
+        std::nextafter(0.125f, 1.0f), std::nextafter(0.125f, 0.0f),
+    };
+    int mismatches = 0;
+    for (const float value : values) {
+        mismatches += CheckParity(value);
+    }
+    TW_CHECK_EQ(mismatches, 0);
+    TW_CHECK_EQ(FormatFixed2(-0.0f), std::string("-0.00"));
+    TW_CHECK_EQ(FormatFixed2(0.125f), std::string("0.12"));
+    TW_CHECK_EQ(FormatFixed2(0.375f), std::string("0.38"));
+}
+
+TW_TEST(AppendFixed2_MatchesPrintfForExactTies)
+{
+    // Every multiple of 1/1024 is exact in float; the x.xx5 ones among them
+    // (k/8 with odd k) are true ties for %.2f and exercise ties-to-even.
+    int mismatches = 0;
+    for (int k = -1024 * 512; k <= 1024 * 512; ++k) {
+        mismatches += CheckParity(static_cast<float>(k) / 1024.0f);
+    }
+    TW_CHECK_EQ(mismatches, 0);
+}
+
+TW_TEST(AppendFixed2_MatchesPrintfNearDecimalHalfways)
+{
+    int mismatches = 0;
+    for (int k = -200000; k <= 200000; ++k) {
+        const float nearHalf = static_cast<float>((static_cast<double>(k) + 0.5) / 100.0);
+        mismatches += CheckParity(nearHalf);
+        mismatches += CheckParity(std::nextafter(nearHalf, -FLT_MAX));
+        mismatches += CheckParity(std::nextafter(nearHalf, FLT_MAX));
+    }
+    TW_CHECK_EQ(mismatches, 0);
+}
+
+TW_TEST(AppendFixed2_MatchesPrintfAcrossBitPatterns)
+{
+    // Strided sweep of the full float space by default; set
+    // TULLIUS_WIDGETS_EXHAUSTIVE=1 to check all 2^32 bit patterns.
+    const bool exhaustive = std::getenv("TULLIUS_WIDGETS_EXHAUSTIVE") != nullptr;
+    const std::uint64_t stride = exhaustive ? 1 : 16411;
+    int mismatches = 0;
+    for (std::uint64_t bits = 0; bits <= 0xFFFFFFFFull; bits += stride) {
+        mismatches += CheckParity(std::bit_cast<float>(static_cast<std::uint32_t>(bits)));
+    }
+    TW_CHECK_EQ(mismatches, 0);
+}
+
+TW_TEST(AppendInteger_MatchesPrintf)
+{
+    const std::int32_t signedValues[] = { 0, 1, -1, 42, -42, 2147483647, -2147483647 - 1 };
+    for (const auto value : signedValues) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%d", value);
+        std::string out;
+        AppendInteger(out, value);
+        TW_CHECK_EQ(out, std::string(buf));
+    }
+
+    const std::uint32_t unsignedValues[] = { 0u, 1u, 4294967295u, 0x0001E4ABu };
+    for (const auto value : unsignedValues) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%u", value);
+        std::string out = "x";
+        AppendInteger(out, value);
+        TW_CHECK_EQ(out, "x" + std::string(buf));
+    }
+}
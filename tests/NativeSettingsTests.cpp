@@ -0,0 +1,37 @@
+#include "NativeSettings.h"
+#include "TestHarness.h"
+
+#include <chrono>
+
+namespace {
+
+using namespace TulliusWidgets;
+using namespace std::chrono_literals;
+using NativeSettings::PerformanceSettings;
+using NativeSettings::ReadPerformanceSettings;
+
+}  // namespace
+
+TW_TEST(NativeSettings_ReadsThePerformanceSection)
+{
+    PerformanceSettings settings{ { 1s, 1s }, 5ms };
+    TW_CHECK(ReadPerformanceSettings(
+        R"({"rev":3,"general":{"minUpdateIntervalMs":5},"performance":{"minUpdateIntervalMs":50,"maxUpdateIntervalMs":1500,"gameTaskBudgetUs":2000}})",
+        settings));
+    TW_CHECK(settings.updateRate.minInterval == 50ms);
+    TW_CHECK(settings.updateRate.maxInterval == 1500ms);
+    TW_CHECK(settings.gameTaskBudget == 2000us);
+
+    // Out-of-range values are clamped; missing or invalid ones fall back to
+    // the defaults.
+    TW_CHECK(ReadPerformanceSettings(R"({"performance":{"minUpdateIntervalMs":-1,"gameTaskBudgetUs":1}})", settings));
+    TW_CHECK(settings.updateRate.minInterval == WidgetRuntime::kDefaultMinUpdateInterval);
+    TW_CHECK(settings.updateRate.maxInterval == WidgetRuntime::kDefaultMaxUpdateInterval);
+    TW_CHECK(settings.gameTaskBudget == kMinGameTaskBudget);
+    TW_CHECK(ReadPerformanceSettings(R"({"general":{}})", settings));
+    TW_CHECK(settings.gameTaskBudget == kDefaultGameTaskBudget);
+
+    settings = PerformanceSettings{ { 1s, 1s }, 5ms };
+    TW_CHECK(!ReadPerformanceSettings(R"({"performance":{"minUpdateIntervalMs":50})", settings));
+    TW_CHECK(settings.updateRate.minInterval == 1s);
+}
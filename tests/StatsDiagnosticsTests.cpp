@@ -0,0 +1,79 @@
+#include "AllocationCounter.h"
+#include "StatsDiagnostics.h"
+#include "TestHarness.h"
+
+#include <string>
+
+namespace {
+
+using namespace TulliusWidgets::StatsCollectorInternal;
+using TulliusWidgets::Tests::AllocationScope;
+
+}  // namespace
+
+TW_TEST(LatencyHistogram_BucketsAreContiguousAndQuarterOctaveWide)
+{
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(0), std::size_t{ 0 });
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(3), std::size_t{ 3 });
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(4), std::size_t{ 4 });
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(7), std::size_t{ 7 });
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(8), std::size_t{ 8 });
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(9), std::size_t{ 8 });
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(10), std::size_t{ 9 });
+
+    for (std::size_t i = 0; i + 1 < LatencyHistogram::kBucketCount; ++i) {
+        const auto upper = LatencyHistogram::BucketUpperBound(i);
+        TW_CHECK_EQ(LatencyHistogram::BucketIndex(upper), i);
+        TW_CHECK_EQ(LatencyHistogram::BucketIndex(upper + 1), i + 1);
+    }
+    TW_CHECK_EQ(LatencyHistogram::BucketIndex(UINT64_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+TW_TEST(LatencyHistogram_ReportsPercentilesAtBucketUpperEdges)
+{
+    LatencyHistogram histogram;
+    TW_CHECK_EQ(histogram.Summarize().count, std::uint64_t{ 0 });
+    TW_CHECK_EQ(histogram.Summarize().p99Nanoseconds, std::uint64_t{ 0 });
+
+    for (int i = 0; i < 90; ++i) {
+        histogram.Record(std::chrono::nanoseconds(1000));
+    }
+    for (int i = 0; i < 9; ++i) {
+        histogram.Record(std::chrono::nanoseconds(20000));
+    }
+    histogram.Record(std::chrono::nanoseconds(150000));
+
+    const auto summary = histogram.Summarize();
+    TW_CHECK_EQ(summary.count, std::uint64_t{ 100 });
+    // 1000 ns lands in [896, 1023]; 20000 ns in [18432, 20479].
+    TW_CHECK_EQ(summary.p50Nanoseconds, std::uint64_t{ 1023 });
+    TW_CHECK_EQ(summary.p95Nanoseconds, std::uint64_t{ 20479 });
+    TW_CHECK_EQ(summary.p99Nanoseconds, std::uint64_t{ 20479 });
+    // The top bucket is capped by the largest sample seen.
+    TW_CHECK_EQ(summary.maxNanoseconds, std::uint64_t{ 150000 });
+}
+
+TW_TEST(LatencyHistogram_RecordingDoesNotAllocate)
+{
+    LatencyHistogram histogram;
+    AllocationScope allocations;
+    for (int i = 0; i < 1000; ++i) {
+        ScopedStageTimer timer(CollectionStage::kTimedEffects);
+        histogram.Record(std::chrono::nanoseconds(i * 37));
+    }
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+    TW_CHECK_EQ(histogram.Summarize().count, std::uint64_t{ 1000 });
+}
+
+TW_TEST(StatsDiagnostics_EmitsEveryCollectionStage)
+{
+    {
+        ScopedStageTimer timer(CollectionStage::kInterop);
+    }
+    std::string json;
+    AppendCollectionTimingsJson(json);
+    TW_CHECK(json.starts_with("\"collectionTimings\":{\"actorValues\":{\"count\":"));
+    TW_CHECK(json.find("\"interop\":{\"count\":") != std::string::npos);
+    TW_CHECK(json.find(",\"p95Ns\":") != std::string::npos);
+    TW_CHECK(json.ends_with("}}"));
+}
@@ -0,0 +1,532 @@
+#include "AllocationCounter.h"
+#include "StatsCaptureFrame.h"
+#include "StatsDispatcher.h"
+#include "StatsPayloadDiff.h"
+#include "StatsPayloadSchema.h"
+#include "TestHarness.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using namespace TulliusWidgets::StatsCollectorInternal;
+using TulliusWidgets::Tests::AllocationScope;
+
+constexpr std::string_view kMonthNames[] = {
+    "Morning Star", "Sun's Dawn", "First Seed", "Rain's Hand", "Second Seed", "Midyear",
+    "Sun's Height", "Last Seed", "Hearthfire", "Frostfall", "Sun's Dusk", "Evening Star",
+};
+constexpr std::string_view kEffectNames[] = {
+    "Fortify Health", "  Potion of\tUltimate Healing ", "Blessing of Talos",
+    "\xEC\xB2\xB4\xEB\xA0\xA5 \xEA\xB0\x95\xED\x99\x94",
+    "\xED\x83\x88\xEB\xA1\x9C\xEC\x8A\xA4\xEC\x9D\x98 \xEC\xB6\x95\xEB\xB3\xB5",
+    "Dragonbane \"Fury\" of the Ancients",
+};
+
+constexpr auto kStart = std::chrono::steady_clock::time_point{} + std::chrono::hours(1);
+
+// Stand-in for the collector's capture and merge: overwrites the capture slot the same way,
+// with values and effect counts that vary from tick to tick.
+void CaptureTick(StatsDispatcher& dispatcher, int tick, std::chrono::steady_clock::time_point now)
+{
+    const auto capture = dispatcher.BeginCapture(now);
+    auto& payload = capture.payload;
+    payload.sequence = static_cast<std::uint32_t>(tick + 1);
+    payload.resistances.fire.effective = 30.0f + static_cast<float>(tick % 7);
+    payload.playerInfo.health = 250.0f + static_cast<float>(tick % 3) * 0.5f;
+    payload.time.minute = static_cast<std::uint32_t>(tick % 60);
+    payload.time.monthName = capture.strings.Store(kMonthNames[(tick / 5) % 12]);
+    payload.equipped.rightHand = capture.strings.Store((tick / 3) % 2 ? "Daedric Sword" : "\xEB\x8D\xB0\xEC\x9D\xB4\xEB\x93\x9C\xEB\xA6\xAD \xEA\xB2\x80");
+    payload.equipped.leftHand = capture.strings.Store("Chain Lightning");
+    payload.equipped.rightHandNameId = capture.names.Intern(payload.equipped.rightHand);
+    payload.equipped.leftHandNameId = capture.names.Intern(payload.equipped.leftHand);
+
+    const int effectCount = tick % 11;
+    for (int i = 0; i < effectCount; ++i) {
+        const auto name = capture.strings.StoreDisplayText(kEffectNames[static_cast<std::size_t>(i) % std::size(kEffectNames)]);
+        const auto nameId = capture.names.Intern(name);
+        payload.timedEffects.push_back(TimedEffectEntry{
+            100 + i,
+            name,
+            name,
+            60 - i,
+            60,
+            i % 2 == 0,
+            0x00012345u + static_cast<std::uint32_t>(i),
+            0x00067890u,
+            0x00112233u,
+            nameId,
+            nameId });
+    }
+}
+
+void CaptureFixed(StatsDispatcher& dispatcher, std::uint32_t sequence, std::string_view rightHand)
+{
+    const auto capture = dispatcher.BeginCapture(kStart);
+    capture.payload.sequence = sequence;
+    capture.payload.equipped.rightHand = capture.strings.Store(rightHand);
+    capture.payload.equipped.rightHandNameId = capture.names.Intern(rightHand);
+}
+
+void ExpectSteadyStateDoesNotAllocate(std::uint32_t schemaVersion)
+{
+    StatsDispatcher dispatcher;
+    dispatcher.SetWireSchemaVersion(schemaVersion);
+    auto now = std::chrono::steady_clock::time_point{} + std::chrono::hours(1);
+    int tick = 0;
+    const auto runTicks = [&](int count) {
+        std::size_t emitted = 0;
+        for (int i = 0; i < count; ++i, ++tick) {
+            if (tick % 17 == 0) {
+                dispatcher.RequestKeyframe();
+            }
+            CaptureTick(dispatcher, tick, now);
+            emitted += dispatcher.Commit(now).size();
+            now += std::chrono::milliseconds(100);
+        }
+        return emitted;
+    };
+
+    // Warm-up reaches every buffer's high-water mark: max effect count,
+    // longest names, keyframes from requests and from max age. It must
+    // allocate, which also proves the counting hook is live.
+    {
+        AllocationScope warmUp;
+        runTicks(2 * 11 * 17);
+        TW_CHECK(warmUp.Count() > 0);
+    }
+
+    AllocationScope allocations;
+    const auto emitted = runTicks(2000);
+    TW_CHECK(emitted > 0);
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+}
+
+}  // namespace
+
+TW_TEST(StatsDispatcher_EmitsKeyframeThenSkipsThenDeltas)
+{
+    StatsDispatcher dispatcher;
+    const auto now = std::chrono::steady_clock::time_point{} + std::chrono::hours(1);
+
+    CaptureFixed(dispatcher, 1, "Iron Sword");
+    const std::string first(dispatcher.Commit(now));
+    TW_CHECK(first.find("\"keyframe\":true") != std::string::npos);
+    TW_CHECK(first.find("\"rightHand\":\"Iron Sword\"") != std::string::npos);
+
+    // Same content after the capture slot was rewound: the last sent slot
+    // still holds its own copy of the name.
+    CaptureFixed(dispatcher, 2, "Iron Sword");
+    TW_CHECK(dispatcher.Commit(now).empty());
+
+    CaptureFixed(dispatcher, 3, "Steel Sword");
+    const auto delta = dispatcher.Commit(now + std::chrono::milliseconds(100));
+    TW_CHECK_EQ(std::string(delta),
+        std::string("{\"schemaVersion\":1,\"seq\":3,\"keyframe\":false,\"baseSeq\":1,"
+                    "\"equipped\":{\"rightHand\":\"Steel Sword\",\"leftHand\":\"\"}}"));
+    TW_CHECK_EQ(delta.data()[delta.size()], '\0');
+
+    dispatcher.RequestKeyframe();
+    CaptureFixed(dispatcher, 4, "Steel Sword");
+    TW_CHECK(dispatcher.Commit(now + std::chrono::milliseconds(200)).find("\"keyframe\":true") != std::string_view::npos);
+
+    CaptureFixed(dispatcher, 5, "Iron Sword");
+    TW_CHECK(dispatcher.Commit(now + kKeyframeMaxAge + std::chrono::seconds(1)).find("\"keyframe\":true") != std::string_view::npos);
+}
+
+TW_TEST(StatsDispatcher_SteadyStateDoesNotAllocate)
+{
+    for (const auto version : { kStatsSchemaVersion, kStatsSchemaVersionPositional }) {
+        ExpectSteadyStateDoesNotAllocate(version);
+    }
+}
+
+TW_TEST(StatsDispatcher_CarriesCleanSectionsUntilMarkedOrSwept)
+{
+    constexpr auto kAlwaysCollected = kStatsSectionAll & ~kStatsSectionsEventDriven;
+    StatsDispatcher dispatcher;
+    auto now = kStart;
+    {
+        const auto capture = dispatcher.BeginCapture(now);
+        TW_CHECK_EQ(capture.sections, kStatsSectionAll);
+        capture.payload.sequence = 1;
+        capture.payload.resistances.fire.effective = 40.0f;
+        capture.payload.offense.rightHandDamage = 12.0f;
+        capture.payload.equipped.rightHand = capture.strings.Store("Iron Sword");
+    }
+    (void)dispatcher.Commit(now);
+
+    now += std::chrono::milliseconds(100);
+    {
+        const auto capture = dispatcher.BeginCapture(now);
+        TW_CHECK_EQ(capture.sections, kAlwaysCollected);
+        TW_CHECK_EQ(capture.payload.resistances.fire.effective, 40.0f);
+        TW_CHECK_EQ(std::string(capture.payload.equipped.rightHand), std::string("Iron Sword"));
+        capture.payload.sequence = 2;
+    }
+    TW_CHECK(dispatcher.Commit(now).empty());
+
+    dispatcher.MarkSectionsDirty(kStatsSectionOffense | kStatsSectionEquipped, now);
+    now += std::chrono::milliseconds(100);
+    {
+        const auto capture = dispatcher.BeginCapture(now);
+        TW_CHECK_EQ(capture.sections, kAlwaysCollected | kStatsSectionOffense | kStatsSectionEquipped);
+        capture.payload.sequence = 3;
+        capture.payload.offense.rightHandDamage = 15.0f;
+        capture.payload.equipped.rightHand = capture.strings.Store("Steel Sword");
+    }
+    TW_CHECK(dispatcher.Commit(now).find("\"offense\":{\"rightHandDamage\":15.00,") != std::string_view::npos);
+
+    // The mark holds across captures, then lapses; the new values carry on.
+    now += std::chrono::milliseconds(500);
+    {
+        const auto capture = dispatcher.BeginCapture(now);
+        TW_CHECK(capture.sections & kStatsSectionOffense);
+        capture.payload.offense.rightHandDamage = 15.0f;
+        capture.payload.equipped.rightHand = capture.strings.Store("Steel Sword");
+    }
+    TW_CHECK(dispatcher.Commit(now).empty());
+    now += kDirtySectionHold;
+    {
+        const auto capture = dispatcher.BeginCapture(now);
+        TW_CHECK_EQ(capture.sections, kAlwaysCollected);
+        TW_CHECK_EQ(capture.payload.offense.rightHandDamage, 15.0f);
+        TW_CHECK_EQ(std::string(capture.payload.equipped.rightHand), std::string("Steel Sword"));
+    }
+    TW_CHECK(dispatcher.Commit(now).empty());
+
+    TW_CHECK_EQ(dispatcher.BeginCapture(kStart + kFullCollectionMaxAge).sections, kStatsSectionAll);
+    (void)dispatcher.Commit(kStart + kFullCollectionMaxAge);
+    dispatcher.RequestNameTableReset();
+    TW_CHECK_EQ(dispatcher.BeginCapture(kStart + kFullCollectionMaxAge).sections, kStatsSectionAll);
+}
+
+TW_TEST(StatsScratch_ViewsSurviveGrowthAndResetReusesChunks)
+{
+    StatsScratch scratch;
+    std::vector<std::string_view> views;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 200; ++i) {
+        expected.push_back(std::string(static_cast<std::size_t>(40 + i % 90), static_cast<char>('a' + i % 26)));
+        views.push_back(scratch.Store(expected.back()));
+    }
+    views.push_back(scratch.Store(std::string(10000, 'z')));
+    expected.push_back(std::string(10000, 'z'));
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        TW_CHECK_EQ(std::string(views[i]), expected[i]);
+    }
+
+    scratch.Reset();
+    AllocationScope allocations;
+    for (int round = 0; round < 3; ++round) {
+        for (const auto& text : expected) {
+            (void)scratch.Store(text);
+        }
+        scratch.Reset();
+    }
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+
+    TW_CHECK(scratch.Store({}).empty());
+    TW_CHECK_EQ(std::string(scratch.StoreDisplayText(" \tFortify\n\nHealth ")), std::string("Fortify Health"));
+}
+
+TW_TEST(StatsDispatcher_PositionalSwitchSendsKeyframeInNewEncoding)
+{
+    StatsDispatcher dispatcher;
+    const auto now = std::chrono::steady_clock::time_point{} + std::chrono::hours(1);
+
+    CaptureFixed(dispatcher, 1, "Iron Sword");
+    TW_CHECK(dispatcher.Commit(now).find("\"schemaVersion\":1,") != std::string_view::npos);
+
+    // Unchanged content still goes out once: the encoding changed.
+    dispatcher.SetWireSchemaVersion(kStatsSchemaVersionPositional);
+    CaptureFixed(dispatcher, 2, "Iron Sword");
+    const std::string keyframe(dispatcher.Commit(now));
+    TW_CHECK(keyframe.starts_with("{\"schemaVersion\":2,\"seq\":2,\"keyframe\":true,"
+                                  "\"nameBase\":0,\"names\":[\"\",\"Iron Sword\"],\"resistances\":[0.00,"));
+    TW_CHECK(keyframe.find("\"equipped\":[1,0]") != std::string::npos);
+    TW_CHECK(keyframe.find("\"timedEffects\":[]") != std::string::npos);
+    TW_CHECK(keyframe.ends_with(",\"isInCombat\":false}"));
+
+    CaptureFixed(dispatcher, 3, "Iron Sword");
+    TW_CHECK(dispatcher.Commit(now).empty());
+
+    CaptureFixed(dispatcher, 4, "Steel Sword");
+    TW_CHECK_EQ(std::string(dispatcher.Commit(now + std::chrono::milliseconds(100))),
+        std::string("{\"schemaVersion\":2,\"seq\":4,\"keyframe\":false,\"baseSeq\":2,"
+                    "\"nameBase\":2,\"names\":[\"Steel Sword\"],\"equipped\":[2,0]}"));
+
+    // Known names go out as ids only.
+    CaptureFixed(dispatcher, 5, "Iron Sword");
+    TW_CHECK_EQ(std::string(dispatcher.Commit(now + std::chrono::milliseconds(150))),
+        std::string("{\"schemaVersion\":2,\"seq\":5,\"keyframe\":false,\"baseSeq\":4,\"equipped\":[1,0]}"));
+
+    dispatcher.SetWireSchemaVersion(kStatsSchemaVersion);
+    CaptureFixed(dispatcher, 6, "Steel Sword");
+    TW_CHECK(dispatcher.Commit(now + std::chrono::milliseconds(200)).starts_with("{\"schemaVersion\":1,\"seq\":6,\"keyframe\":true,\"resistances\":{"));
+}
+
+TW_TEST(StatsDispatcher_MergesFramesCapturedOnAnotherThread)
+{
+    constexpr auto kAlwaysCollected = kStatsSectionAll & ~kStatsSectionsEventDriven;
+    StatsDispatcher dispatcher;
+    dispatcher.SetWireSchemaVersion(kStatsSchemaVersionPositional);
+    StatsCaptureFrame frame;
+
+    const auto capture = [&](std::chrono::steady_clock::time_point now, std::uint32_t sequence, std::string_view rightHand) {
+        frame.time = now;
+        frame.raw.sections = dispatcher.SectionsDue(now);
+        frame.strings.Reset();
+        frame.payload.sequence = sequence;
+        frame.payload.equipped.rightHand = frame.strings.Store(rightHand);
+        frame.payload.time.monthName = frame.strings.Store("Frostfall");
+        frame.payload.playerInfo.level = 20;
+    };
+    const auto build = [&]() {
+        const auto slot = dispatcher.BeginCapture(frame.time, frame.raw.sections);
+        MergeCapturedSections(frame, slot.payload, slot.strings, slot.names);
+        return std::string(dispatcher.Commit(frame.time));
+    };
+
+    capture(kStart, 1, "Iron Sword");
+    TW_CHECK_EQ(frame.raw.sections, kStatsSectionAll);
+    // Asking again does not consume the full collection; building does.
+    TW_CHECK_EQ(dispatcher.SectionsDue(kStart), kStatsSectionAll);
+    const auto keyframe = build();
+    TW_CHECK(keyframe.find("\"names\":[\"\",\"Iron Sword\"]") != std::string::npos);
+    TW_CHECK(keyframe.find("\"Frostfall\"") != std::string::npos);
+    TW_CHECK(keyframe.find("\"equipped\":[1,0]") != std::string::npos);
+
+    // Equipped is event-driven: a later frame that did not read it keeps the
+    // built name, re-interned after a table reset.
+    const auto later = kStart + std::chrono::milliseconds(100);
+    capture(later, 2, "Ignored Sword");
+    TW_CHECK_EQ(frame.raw.sections, kAlwaysCollected);
+    dispatcher.RequestNameTableReset();
+    const auto rebuilt = build();
+    TW_CHECK(rebuilt.find("\"keyframe\":true,\"nameBase\":0,\"names\":[\"\",\"Iron Sword\"]") != std::string::npos);
+    TW_CHECK(rebuilt.find("Ignored Sword") == std::string::npos);
+    TW_CHECK(rebuilt.find("\"equipped\":[1,0]") != std::string::npos);
+}
+
+TW_TEST(StatsDispatcher_NameTableResetRenumbersAndResendsWithKeyframe)
+{
+    StatsDispatcher dispatcher;
+    dispatcher.SetWireSchemaVersion(kStatsSchemaVersionPositional);
+    const auto now = std::chrono::steady_clock::time_point{} + std::chrono::hours(1);
+
+    CaptureFixed(dispatcher, 1, "Iron Sword");
+    (void)dispatcher.Commit(now);
+    CaptureFixed(dispatcher, 2, "Steel Sword");
+    TW_CHECK(dispatcher.Commit(now).find("\"nameBase\":2,\"names\":[\"Steel Sword\"]") != std::string_view::npos);
+
+    dispatcher.RequestNameTableReset();
+    CaptureFixed(dispatcher, 3, "Steel Sword");
+    const std::string keyframe(dispatcher.Commit(now));
+    TW_CHECK(keyframe.find("\"keyframe\":true,\"nameBase\":0,\"names\":[\"\",\"Steel Sword\"],") != std::string::npos);
+    TW_CHECK(keyframe.find("\"equipped\":[1,0]") != std::string::npos);
+}
+
+TW_TEST(StatsNameTable_InternsOncePerEpochWithoutAllocatingOnHits)
+{
+    StatsNameTable names;
+    TW_CHECK_EQ(names.Intern(""), std::uint32_t{ 0 });
+    const auto fortify = names.Intern("Fortify Health");
+    TW_CHECK_EQ(fortify, std::uint32_t{ 1 });
+    TW_CHECK_EQ(names.Intern("\xEC\xB2\xB4\xEB\xA0\xA5 \xEA\xB0\x95\xED\x99\x94"), std::uint32_t{ 2 });
+    TW_CHECK_EQ(names.Unsent().size(), std::size_t{ 3 });
+
+    names.MarkSent();
+    const std::string lookup = "Fortify Health, looked up through a heap-allocated key";
+    {
+        AllocationScope allocations;
+        TW_CHECK_EQ(names.Intern(std::string_view(lookup).substr(0, 14)), fortify);
+        TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+    }
+    TW_CHECK(names.Unsent().empty());
+    TW_CHECK_EQ(names.Intern("Resist Fire"), std::uint32_t{ 3 });
+    TW_CHECK_EQ(names.SentCount(), std::uint32_t{ 3 });
+    TW_CHECK_EQ(std::string(names.Unsent().front()), std::string("Resist Fire"));
+
+    names.Reset();
+    TW_CHECK_EQ(names.Size(), std::size_t{ 1 });
+    TW_CHECK_EQ(names.Intern("Resist Fire"), std::uint32_t{ 1 });
+}
+
+TW_TEST(StatsKeyTable_ListsSectionsAndChildrenInWireOrder)
+{
+    const auto table = BuildStatsKeyTableJson();
+    TW_CHECK(table.starts_with("{\"schemaVersion\":2,\"sections\":[[\"resistances\",\"o\",[[\"magic\",\"v\"],"));
+    TW_CHECK(table.find("[\"equipped\",\"o\",[[\"rightHand\",\"n\"],[\"leftHand\",\"n\"]]]") != std::string::npos);
+    TW_CHECK(table.find("[\"timedEffects\",\"a\",[[\"instanceId\",\"v\"],[\"sourceName\",\"n\"],[\"effectName\",\"n\"],") != std::string::npos);
+    TW_CHECK(table.ends_with(",[\"isInCombat\",\"v\"]]}"));
+}
+
+namespace {
+
+struct MiniRow {
+    std::int32_t id;
+    std::string_view name;
+};
+
+struct MiniSource {
+    float value;
+    bool flag;
+    std::vector<MiniRow> rows;
+};
+
+// A table with no hand-written compare or hash code behind it.
+constexpr auto kMiniSchema = std::tuple{
+    StatsSchema::Section<0x1>(StatsSchema::Object<"a">(
+        StatsSchema::Field<"value">([](const MiniSource& s) { return s.value; }))),
+    StatsSchema::Section<0x2>(StatsSchema::Field<"flag">([](const MiniSource& s) { return s.flag; })),
+    StatsSchema::Section<0x4>(StatsSchema::Array<"rows">(
+        [](const MiniSource& s) -> const std::vector<MiniRow>& { return s.rows; },
+        StatsSchema::Field<"id">([](const MiniRow& r) { return r.id; }),
+        StatsSchema::NameRef<"name">(
+            [](const MiniRow& r) { return r.name; },
+            [](const MiniRow&) { return std::uint32_t{ 0 }; }))),
+};
+
+}  // namespace
+
+TW_TEST(StatsSchema_DumpMatchesTheCheckedInFieldList)
+{
+    // The contract tests compare this list with the docs and the view's
+    // types; regenerate it from DumpStatsPayloadSchema() after a change.
+    std::ifstream file("docs/stats-payload-schema.fields.txt", std::ios::binary);
+    TW_CHECK(file.is_open());
+    std::string checkedIn{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    // A Windows checkout may have converted the line endings.
+    std::erase(checkedIn, '\r');
+    TW_CHECK(DumpStatsPayloadSchema() == checkedIn);
+}
+
+TW_TEST(StatsSchema_DiffsAndVisitsEveryDeclaredValue)
+{
+    const auto same = [](std::string_view, const auto& a, const auto& b) { return a == b; };
+    const MiniSource base{ 1.0f, false, { { 1, "Oakflesh" } } };
+    TW_CHECK_EQ(StatsSchema::DiffSections(base, base, kMiniSchema, same), std::uint32_t{ 0 });
+
+    auto changed = base;
+    changed.flag = true;
+    changed.rows[0].name = "Stoneflesh";
+    TW_CHECK_EQ(StatsSchema::DiffSections(base, changed, kMiniSchema, same), std::uint32_t{ 0x6 });
+    changed = base;
+    changed.rows.push_back({ 2, "Oakflesh" });
+    TW_CHECK_EQ(StatsSchema::DiffSections(base, changed, kMiniSchema, same), std::uint32_t{ 0x4 });
+
+    std::size_t visited = 0;
+    auto count = [&visited](const auto&) { ++visited; };
+    StatsSchema::VisitSections(changed, kMiniSchema, count);
+    // value, flag, row count, then two columns per row.
+    TW_CHECK_EQ(visited, std::size_t{ 7 });
+}
+
+TW_TEST(StatsPayloadDiff_CoversEveryFieldOfTheSchema)
+{
+    StatsPayload base{};
+    const auto baseFingerprint = FingerprintStatsPayload(base);
+
+    auto changed = base;
+    changed.playerInfo.staminaPotionCount = 3;
+    TW_CHECK_EQ(DiffStatsSections(base, changed), kStatsSectionPlayerInfo);
+    TW_CHECK(FingerprintStatsPayload(changed) != baseFingerprint);
+
+    changed = base;
+    changed.defense.damageReductionClamped = true;
+    TW_CHECK_EQ(DiffStatsSections(base, changed), kStatsSectionCalcMeta);
+    TW_CHECK(FingerprintStatsPayload(changed) != baseFingerprint);
+
+    // Below the displayed precision.
+    changed = base;
+    changed.playerInfo.health += 0.001f;
+    TW_CHECK_EQ(DiffStatsSections(base, changed), std::uint32_t{ 0 });
+    TW_CHECK_EQ(FingerprintStatsPayload(changed), baseFingerprint);
+
+    changed = base;
+    changed.sequence += 1;
+    TW_CHECK_EQ(FingerprintStatsPayload(changed), baseFingerprint);
+}
+
+namespace {
+
+void CaptureCountdown(
+    StatsDispatcher& dispatcher,
+    std::chrono::steady_clock::time_point now,
+    std::int32_t remainingSec,
+    std::uint32_t gameMinute,
+    float health = 300.0f)
+{
+    const auto capture = dispatcher.BeginCapture(now);
+    auto& payload = capture.payload;
+    payload.playerInfo.health = health;
+    payload.time = GameTimeEntry{ 201, 7, 24, 5, gameMinute, 20.0f, capture.strings.Store("Last Seed") };
+    const auto name = capture.strings.Store("Oakflesh");
+    const auto nameId = capture.names.Intern(name);
+    payload.timedEffects.push_back(TimedEffectEntry{ 101, name, name, remainingSec, 120, false, 1u, 2u, 3u, nameId, nameId });
+}
+
+}  // namespace
+
+TW_TEST(StatsDispatcher_HoldsCountdownsAndClockWhileTheyFollowTheAnchor)
+{
+    StatsDispatcher dispatcher;
+    auto now = kStart;
+    CaptureCountdown(dispatcher, now, 100, 10);
+    TW_CHECK(dispatcher.Commit(now).find("\"keyframe\":true") != std::string_view::npos);
+
+    // Countdown and clock (20 game seconds per second) tick as predicted.
+    for (int second = 1; second <= 4; ++second) {
+        now += std::chrono::seconds(1);
+        CaptureCountdown(dispatcher, now, 100 - second, 10 + static_cast<std::uint32_t>(second) / 3);
+        TW_CHECK(dispatcher.Commit(now).empty());
+    }
+
+    // Another change goes out alone; the held sections keep their anchors.
+    now += std::chrono::milliseconds(500);
+    CaptureCountdown(dispatcher, now, 96, 11, 250.0f);
+    const std::string delta(dispatcher.Commit(now));
+    TW_CHECK(delta.find("\"playerInfo\":") != std::string::npos);
+    TW_CHECK(delta.find("\"timedEffects\"") == std::string::npos);
+    TW_CHECK(delta.find("\"time\"") == std::string::npos);
+
+    // A refreshed effect and a wait both break the prediction.
+    now += std::chrono::milliseconds(500);
+    CaptureCountdown(dispatcher, now, 120, 11, 250.0f);
+    TW_CHECK(dispatcher.Commit(now).find("\"timedEffects\":[{\"instanceId\":101,\"sourceName\":\"Oakflesh\",\"effectName\":\"Oakflesh\",\"remainingSec\":120,") != std::string_view::npos);
+    now += std::chrono::seconds(1);
+    CaptureCountdown(dispatcher, now, 119, 59, 250.0f);
+    TW_CHECK(dispatcher.Commit(now).find("\"time\":{\"year\":201,\"month\":7,\"day\":24,\"hour\":5,\"minute\":59,") != std::string_view::npos);
+}
+
+TW_TEST(StatsDispatcher_KeyframesCarryCurrentCountdowns)
+{
+    StatsDispatcher dispatcher;
+    auto now = kStart;
+    CaptureCountdown(dispatcher, now, 100, 10);
+    (void)dispatcher.Commit(now);
+
+    now += kKeyframeMaxAge + std::chrono::seconds(1);
+    CaptureCountdown(dispatcher, now, 94, 12);
+    TW_CHECK(dispatcher.Commit(now).empty());
+
+    // The keyframe re-anchors the view on arrival, so it must not carry the
+    // held anchor values.
+    CaptureCountdown(dispatcher, now, 94, 12, 250.0f);
+    const std::string keyframe(dispatcher.Commit(now));
+    TW_CHECK(keyframe.find("\"keyframe\":true") != std::string::npos);
+    TW_CHECK(keyframe.find("\"remainingSec\":94,") != std::string::npos);
+    TW_CHECK(keyframe.find("\"minute\":12,") != std::string::npos);
+
+    now += std::chrono::seconds(2);
+    CaptureCountdown(dispatcher, now, 92, 12, 250.0f);
+    TW_CHECK(dispatcher.Commit(now).empty());
+}
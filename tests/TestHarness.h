@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Minimal self-registering test harness for the host-side native tests.
+// Keeps the test target free of third-party dependencies so it builds
+// anywhere xmake and a C++23 compiler are available.
+namespace TulliusWidgets::Tests {
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+inline std::vector<TestCase>& Registry()
+{
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+inline int& FailureCount()
+{
+    static int failures = 0;
+    return failures;
+}
+
+struct Registrar {
+    Registrar(const char* name, void (*fn)())
+    {
+        Registry().push_back(TestCase{ name, fn });
+    }
+};
+
+inline void ReportFailure(const char* file, int line, const std::string& message)
+{
+    ++FailureCount();
+    std::fprintf(stderr, "%s:%d: %s\n", file, line, message.c_str());
+}
+
+}  // namespace TulliusWidgets::Tests
+
+#define TW_TEST(name)                                                                              \
+    static void name();                                                                            \
+    static const ::TulliusWidgets::Tests::Registrar name##_registrar{ #name, &name };             \
+    static void name()
+
+#define TW_CHECK(expr)                                                                             \
+    do {                                                                                           \
+        if (!(expr)) {                                                                             \
+            ::TulliusWidgets::Tests::ReportFailure(__FILE__, __LINE__, "check failed: " #expr);   \
+        }                                                                                          \
+    } while (false)
+
+#define TW_CHECK_EQ(actual, expected)                                                              \
+    do {                                                                                           \
+        const auto& twActual = (actual);                                                           \
+        const auto& twExpected = (expected);                                                       \
+        if (!(twActual == twExpected)) {                                                           \
+            ::TulliusWidgets::Tests::ReportFailure(                                                \
+                __FILE__, __LINE__, "expected " #actual " == " #expected);                         \
+        }                                                                                          \
+    } while (false)
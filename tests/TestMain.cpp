@@ -0,0 +1,23 @@
+#include "TestHarness.h"
+
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int ran = 0;
+    for (const auto& test : TulliusWidgets::Tests::Registry()) {
+        if (filter && !std::strstr(test.name, filter)) {
+            continue;
+        }
+        const int failuresBefore = TulliusWidgets::Tests::FailureCount();
+        test.fn();
+        ++ran;
+        const bool passed = TulliusWidgets::Tests::FailureCount() == failuresBefore;
+        std::printf("[%s] %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+
+    const int failures = TulliusWidgets::Tests::FailureCount();
+    std::printf("%d test(s), %d failure(s)\n", ran, failures);
+    return failures == 0 ? 0 : 1;
+}
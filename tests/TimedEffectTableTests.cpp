@@ -0,0 +1,228 @@
+#include "AllocationCounter.h"
+#include "TestHarness.h"
+#include "TimedEffectTable.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace TulliusWidgets::StatsCollectorInternal;
+using TulliusWidgets::Tests::AllocationScope;
+
+TimedEffectInfo MakeInfo(std::int32_t instanceId, std::string_view name, bool isDebuff = false)
+{
+    return TimedEffectInfo{ instanceId, name, name, isDebuff, 0x00012345u, 0x00067890u, 0x00112233u };
+}
+
+std::vector<TimedEffectEntry> EmitAll(TimedEffectTable& table, StatsScratch& strings, StatsNameTable& names)
+{
+    std::vector<TimedEffectEntry> out;
+    strings.Reset();
+    table.Emit(out, strings, names);
+    return out;
+}
+
+}  // namespace
+
+TW_TEST(TimedEffectTable_OrdersByRemainingThenDebuffThenName)
+{
+    TimedEffectTable table;
+    StatsScratch strings;
+    StatsNameTable names;
+
+    table.BeginPass();
+    (void)table.Update(1, 30, 60);
+    table.Insert(MakeInfo(1, "Oakflesh"), 30, 60);
+    table.Insert(MakeInfo(2, "Weakness to Shock", true), 30, 30);
+    table.Insert(MakeInfo(3, "Fortify Marksman"), 12, 45);
+    table.Insert(MakeInfo(4, "Blessing of Talos"), 30, 1800);
+    table.EndPass();
+
+    const auto out = EmitAll(table, strings, names);
+    TW_CHECK_EQ(out.size(), std::size_t{ 4 });
+    TW_CHECK_EQ(out[0].instanceId, 3);
+    TW_CHECK_EQ(out[1].instanceId, 2);
+    TW_CHECK_EQ(out[2].instanceId, 4);
+    TW_CHECK_EQ(out[3].instanceId, 1);
+    TW_CHECK(out[2].sourceName == "Blessing of Talos");
+    TW_CHECK_EQ(out[2].sourceNameId, names.Intern("Blessing of Talos"));
+}
+
+TW_TEST(TimedEffectTable_KeepsNamesAndReordersAsCountdownsMove)
+{
+    TimedEffectTable table;
+    StatsScratch strings;
+    StatsNameTable names;
+
+    table.BeginPass();
+    table.Insert(MakeInfo(10, "  Potion of\tUltimate Healing "), 20, 20);
+    table.Insert(MakeInfo(11, "Oakflesh"), 50, 60);
+    table.EndPass();
+
+    // Later passes only move countdowns; a refreshed effect jumps back.
+    table.BeginPass();
+    TW_CHECK(table.Update(10, 19, 20));
+    TW_CHECK(table.Update(11, 49, 60));
+    TW_CHECK(!table.Update(12, 5, 5));
+    table.EndPass();
+    table.BeginPass();
+    TW_CHECK(table.Update(10, 120, 120));
+    TW_CHECK(table.Update(11, 48, 60));
+    table.EndPass();
+
+    const auto out = EmitAll(table, strings, names);
+    TW_CHECK_EQ(out.size(), std::size_t{ 2 });
+    TW_CHECK_EQ(out[0].instanceId, 11);
+    TW_CHECK_EQ(out[1].instanceId, 10);
+    TW_CHECK(out[1].effectName == "Potion of Ultimate Healing");
+    TW_CHECK_EQ(out[1].remainingSec, 120);
+    TW_CHECK_EQ(out[1].totalSec, 120);
+}
+
+TW_TEST(TimedEffectTable_DropsUnseenAndRemovedInstances)
+{
+    TimedEffectTable table;
+    StatsScratch strings;
+    StatsNameTable names;
+
+    table.BeginPass();
+    table.Insert(MakeInfo(1, "Oakflesh"), 30, 60);
+    table.Insert(MakeInfo(2, "Fortify Marksman"), 20, 45);
+    table.Insert(MakeInfo(3, "Blessing of Talos"), 10, 1800);
+    table.EndPass();
+
+    table.BeginPass();
+    TW_CHECK(table.Update(1, 29, 60));
+    TW_CHECK(table.Update(3, 9, 1800));
+    table.EndPass();
+    TW_CHECK_EQ(table.Size(), std::size_t{ 2 });
+
+    const auto out = EmitAll(table, strings, names);
+    TW_CHECK_EQ(out.size(), std::size_t{ 2 });
+    TW_CHECK_EQ(out[0].instanceId, 3);
+    TW_CHECK_EQ(out[1].instanceId, 1);
+
+    table.Clear();
+    TW_CHECK_EQ(table.Size(), std::size_t{ 0 });
+}
+
+TW_TEST(TimedEffectSources_ResolveOnceAndRenumberReusedIds)
+{
+    TimedEffectSources sources;
+
+    sources.BeginPass();
+    TW_CHECK(sources.Find(1) == nullptr);
+    const auto firstSerial = sources.Insert(MakeInfo(1, "Oakflesh")).serial;
+    sources.EndPass();
+
+    sources.BeginPass();
+    const auto* known = sources.Find(1);
+    TW_CHECK(known != nullptr);
+    if (known) {
+        TW_CHECK_EQ(known->serial, firstSerial);
+        TW_CHECK(known->sourceName == "Oakflesh");
+    }
+    TW_CHECK(sources.Find(2) == nullptr);
+    sources.EndPass();
+    TW_CHECK_EQ(sources.Size(), std::size_t{ 1 });
+
+    // A removed id handed to a new effect resolves again.
+    sources.Remove(1);
+    sources.BeginPass();
+    TW_CHECK(sources.Find(1) == nullptr);
+    TW_CHECK(sources.Insert(MakeInfo(1, "Flame Cloak")).serial != firstSerial);
+    sources.EndPass();
+
+    sources.BeginPass();
+    sources.EndPass();
+    TW_CHECK_EQ(sources.Size(), std::size_t{ 0 });
+}
+
+TW_TEST(TimedEffectTable_AppliesCaptureRowsAndReplacesReusedIds)
+{
+    TimedEffectTable table;
+    StatsScratch strings;
+    StatsNameTable names;
+
+    auto row = [](std::int32_t instanceId, std::string_view name, std::uint32_t serial, std::int32_t remainingSec, std::int32_t totalSec) {
+        auto info = MakeInfo(instanceId, name);
+        info.serial = serial;
+        return TimedEffectRow{ info, remainingSec, totalSec };
+    };
+
+    table.Apply({ row(1, "Oakflesh", 1, 30, 60), row(3, "Blessing of Talos", 2, 10, 1800) });
+    auto out = EmitAll(table, strings, names);
+    TW_CHECK_EQ(out.size(), std::size_t{ 2 });
+    TW_CHECK_EQ(out[0].instanceId, 3);
+
+    // Same serial: only the countdown moves. New serial: the id now belongs
+    // to another effect.
+    table.Apply({ row(1, "Ignored", 1, 29, 60), row(3, "Flame Cloak", 3, 15, 15) });
+    out = EmitAll(table, strings, names);
+    TW_CHECK_EQ(out.size(), std::size_t{ 2 });
+    TW_CHECK_EQ(out[0].instanceId, 3);
+    TW_CHECK(out[0].sourceName == "Flame Cloak");
+    TW_CHECK_EQ(out[0].totalSec, 15);
+    TW_CHECK_EQ(out[1].instanceId, 1);
+    TW_CHECK(out[1].sourceName == "Oakflesh");
+    TW_CHECK_EQ(out[1].remainingSec, 29);
+
+    table.Apply({});
+    TW_CHECK_EQ(table.Size(), std::size_t{ 0 });
+}
+
+TW_TEST(TimedEffectTable_SkipsNamelessAndReinternsAfterNameTableReset)
+{
+    TimedEffectTable table;
+    StatsScratch strings;
+    StatsNameTable names;
+
+    table.BeginPass();
+    table.Insert(MakeInfo(1, " \t "), 30, 60);
+    table.Insert(TimedEffectInfo{ 2, {}, "Oakflesh", false, 0, 0, 0 }, 40, 60);
+    table.EndPass();
+
+    auto out = EmitAll(table, strings, names);
+    TW_CHECK_EQ(out.size(), std::size_t{ 1 });
+    TW_CHECK(out[0].sourceName == "Oakflesh");
+    const auto firstId = out[0].sourceNameId;
+    TW_CHECK(firstId != 0u);
+
+    names.Reset();
+    (void)names.Intern("Something Else");
+    out = EmitAll(table, strings, names);
+    TW_CHECK(out[0].sourceNameId != firstId);
+    TW_CHECK_EQ(out[0].sourceNameId, names.Intern("Oakflesh"));
+}
+
+TW_TEST(TimedEffectTable_SteadyStatePassesDoNotAllocate)
+{
+    TimedEffectTable table;
+    StatsScratch strings;
+    StatsNameTable names;
+    std::vector<TimedEffectEntry> out;
+    out.reserve(64);
+
+    table.BeginPass();
+    for (std::int32_t i = 0; i < 60; ++i) {
+        table.Insert(MakeInfo(i, i % 2 ? "Fortify Health" : "Blessing of Talos", i % 5 == 0), 100 + i, 300);
+    }
+    table.EndPass();
+    strings.Reset();
+    table.Emit(out, strings, names);
+
+    AllocationScope allocations;
+    for (std::int32_t tick = 1; tick < 50; ++tick) {
+        table.BeginPass();
+        for (std::int32_t i = 0; i < 60; ++i) {
+            (void)table.Update(i, 100 + i - tick + (i % 7 == 0 ? tick : 0), 300);
+        }
+        table.EndPass();
+        out.clear();
+        strings.Reset();
+        table.Emit(out, strings, names);
+    }
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+    TW_CHECK_EQ(out.size(), std::size_t{ 60 });
+}
@@ -0,0 +1,124 @@
+#include "AllocationCounter.h"
+#include "TestHarness.h"
+#include "TripleBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+using namespace TulliusWidgets::StatsCollectorInternal;
+using TulliusWidgets::Tests::AllocationScope;
+
+// Every word carries the sequence, so a snapshot torn between two
+// publishes shows up as mismatched words.
+struct Snapshot {
+    std::uint64_t sequence{ 0 };
+    std::array<std::uint64_t, 31> words{};
+};
+
+void Fill(Snapshot& snapshot, std::uint64_t sequence)
+{
+    snapshot.sequence = sequence;
+    for (std::size_t i = 0; i < snapshot.words.size(); ++i) {
+        snapshot.words[i] = sequence * 131 + i;
+    }
+}
+
+bool IsComplete(const Snapshot& snapshot)
+{
+    for (std::size_t i = 0; i < snapshot.words.size(); ++i) {
+        if (snapshot.words[i] != snapshot.sequence * 131 + i) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TW_TEST(TripleBuffer_HandsOverTheNewestPublishedSnapshot)
+{
+    TripleBuffer<Snapshot> buffer;
+    TW_CHECK(!buffer.Acquire());
+
+    Fill(buffer.WriteSlot(), 1);
+    buffer.Publish();
+    TW_CHECK(buffer.Acquire());
+    TW_CHECK_EQ(buffer.ReadSlot().sequence, std::uint64_t{ 1 });
+    TW_CHECK(!buffer.Acquire());
+    TW_CHECK_EQ(buffer.ReadSlot().sequence, std::uint64_t{ 1 });
+
+    // An unread snapshot is replaced, not queued.
+    Fill(buffer.WriteSlot(), 2);
+    buffer.Publish();
+    Fill(buffer.WriteSlot(), 3);
+    buffer.Publish();
+    TW_CHECK(buffer.Acquire());
+    TW_CHECK_EQ(buffer.ReadSlot().sequence, std::uint64_t{ 3 });
+    TW_CHECK(IsComplete(buffer.ReadSlot()));
+    TW_CHECK(!buffer.Acquire());
+
+    // The producer never writes into the slot the consumer holds.
+    for (std::uint64_t sequence = 4; sequence < 10; ++sequence) {
+        TW_CHECK(&buffer.WriteSlot() != &buffer.ReadSlot());
+        Fill(buffer.WriteSlot(), sequence);
+        buffer.Publish();
+    }
+    TW_CHECK(buffer.Acquire());
+    TW_CHECK_EQ(buffer.ReadSlot().sequence, std::uint64_t{ 9 });
+}
+
+TW_TEST(TripleBuffer_ConcurrentHandoffNeverTearsOrGoesBackwards)
+{
+    constexpr std::uint64_t kPublishes = 200000;
+    TripleBuffer<Snapshot> buffer;
+    std::atomic<bool> producerDone{ false };
+
+    std::thread producer([&]() {
+        for (std::uint64_t sequence = 1; sequence <= kPublishes; ++sequence) {
+            Fill(buffer.WriteSlot(), sequence);
+            buffer.Publish();
+        }
+        producerDone.store(true, std::memory_order_release);
+    });
+
+    std::uint64_t last = 0;
+    std::uint64_t acquired = 0;
+    bool torn = false;
+    bool backwards = false;
+    while (last < kPublishes) {
+        // The final snapshot is published before producerDone is set, so
+        // once it reads true an empty Acquire() means it was taken already.
+        const bool done = producerDone.load(std::memory_order_acquire);
+        if (!buffer.Acquire()) {
+            if (done) break;
+            continue;
+        }
+        const auto& snapshot = buffer.ReadSlot();
+        torn = torn || !IsComplete(snapshot);
+        backwards = backwards || snapshot.sequence <= last;
+        last = snapshot.sequence;
+        ++acquired;
+    }
+    producer.join();
+
+    TW_CHECK(!torn);
+    TW_CHECK(!backwards);
+    TW_CHECK_EQ(last, kPublishes);
+    TW_CHECK(acquired > 0);
+}
+
+TW_TEST(TripleBuffer_HandoffDoesNotAllocate)
+{
+    TripleBuffer<Snapshot> buffer;
+    AllocationScope allocations;
+    for (std::uint64_t sequence = 1; sequence <= 1000; ++sequence) {
+        Fill(buffer.WriteSlot(), sequence);
+        buffer.Publish();
+        if (sequence % 3 == 0) {
+            (void)buffer.Acquire();
+        }
+    }
+    TW_CHECK_EQ(allocations.Count(), std::uint64_t{ 0 });
+}
@@ -0,0 +1,101 @@
+#include "TestHarness.h"
+#include "UpdateRateController.h"
+
+#include <chrono>
+
+namespace {
+
+using namespace TulliusWidgets::WidgetRuntime;
+using namespace std::chrono_literals;
+using Clock = UpdateRateController::Clock;
+
+constexpr auto kStart = Clock::time_point{} + 1h;
+
+UpdateRateSample WithHealth(float healthPct)
+{
+    UpdateRateSample sample{};
+    sample.healthPct = healthPct;
+    return sample;
+}
+
+}  // namespace
+
+TW_TEST(UpdateRateController_FollowsHowFastValuesMove)
+{
+    UpdateRateController controller;
+    TW_CHECK(controller.Interval() == kDefaultMinUpdateInterval);
+
+    // Static values relax to the slowest rate.
+    auto now = kStart;
+    for (int i = 0; i < 3; ++i) {
+        controller.Observe(WithHealth(80.0f), now);
+        now += 500ms;
+    }
+    TW_CHECK(controller.Interval() == kDefaultMaxUpdateInterval);
+
+    // Health draining 20 points a second wants an update every 50 ms.
+    float health = 80.0f;
+    for (int i = 0; i < 10; ++i) {
+        health -= 1.0f;
+        controller.Observe(WithHealth(health), now);
+        now += 50ms;
+    }
+    TW_CHECK(controller.Interval() == 50ms);
+
+    // A drain that is a little faster or slower stays inside the band.
+    for (int i = 0; i < 10; ++i) {
+        health -= 1.1f;
+        controller.Observe(WithHealth(health), now);
+        now += 50ms;
+    }
+    TW_CHECK(controller.Interval() == 50ms);
+
+    // Once values settle the rate decays over a few seconds, not at once.
+    controller.Observe(WithHealth(health), now + 200ms);
+    TW_CHECK(controller.Interval() < 100ms);
+    controller.Observe(WithHealth(health), now + 5s);
+    TW_CHECK(controller.Interval() == kDefaultMaxUpdateInterval);
+}
+
+TW_TEST(UpdateRateController_TreatsEffectsAndCombatAsSteps)
+{
+    UpdateRateController controller;
+    controller.Observe(UpdateRateSample{}, kStart);
+    controller.Observe(UpdateRateSample{}, kStart + 1s);
+    TW_CHECK(controller.Interval() == kDefaultMaxUpdateInterval);
+    TW_CHECK(!controller.LastInCombat());
+
+    UpdateRateSample fighting{};
+    fighting.inCombat = true;
+    fighting.timedEffectCount = 2;
+    controller.Observe(fighting, kStart + 2s);
+    TW_CHECK(controller.Interval() < 100ms);
+    TW_CHECK(controller.LastInCombat());
+
+    controller.Reset();
+    TW_CHECK(!controller.LastInCombat());
+    TW_CHECK(controller.Interval() == kDefaultMinUpdateInterval);
+}
+
+TW_TEST(UpdateRateController_KeepsTheIntervalWithinItsBounds)
+{
+    UpdateRateController controller;
+    controller.SetBounds(UpdateRateBounds{ 100ms, 800ms });
+    TW_CHECK(controller.Interval() == 100ms);
+
+    controller.Observe(WithHealth(100.0f), kStart);
+    controller.Observe(WithHealth(10.0f), kStart + 10ms);
+    TW_CHECK(controller.Interval() == 100ms);
+    controller.Observe(WithHealth(10.0f), kStart + 30s);
+    TW_CHECK(controller.Interval() == 800ms);
+
+    controller.SetBounds(UpdateRateBounds{ 100ms, 400ms });
+    TW_CHECK(controller.Interval() == 400ms);
+
+    const auto clamped = ClampUpdateRateBounds(UpdateRateBounds{ 1ms, 1h });
+    TW_CHECK(clamped.minInterval == kMinUpdateIntervalLimit);
+    TW_CHECK(clamped.maxInterval == kMaxUpdateIntervalLimit);
+    const auto inverted = ClampUpdateRateBounds(UpdateRateBounds{ 500ms, 200ms });
+    TW_CHECK(inverted.minInterval == 500ms);
+    TW_CHECK(inverted.maxInterval == 500ms);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "AllocationCounter.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace TulliusWidgets::Bench {
+
+// Prevents the optimizer from discarding benchmark results.
+template <class T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static volatile const void* sink;
+    sink = &value;
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+// Runs `fn` `iterations` times after a short warm-up and prints ns/op and
+// global operator new calls per op.
+template <class Fn>
+inline double Run(const char* name, std::uint64_t iterations, Fn&& fn)
+{
+    for (std::uint64_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn();
+    }
+
+    const Tests::AllocationScope allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double nsPerOp =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+        / static_cast<double>(iterations);
+    const double allocsPerOp = static_cast<double>(allocations.Count()) / static_cast<double>(iterations);
+    std::printf("%-48s %12.1f ns/op %10.2f allocs/op\n", name, nsPerOp, allocsPerOp);
+    return nsPerOp;
+}
+
+}  // namespace TulliusWidgets::Bench
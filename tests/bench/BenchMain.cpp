@@ -0,0 +1,22 @@
+#include <cstdio>
+
+namespace TulliusWidgets::Bench {
+void RunNumberFormatBenchmarks();
+void RunJsonEscapeBenchmarks();
+void RunJsonReaderBenchmarks();
+void RunHostRuntimeBenchmarks();
+void RunTimedEffectTableBenchmarks();
+void RunTripleBufferBenchmarks();
+}  // namespace TulliusWidgets::Bench
+
+int main()
+{
+    std::printf("TulliusWidgets host benchmarks\n");
+    TulliusWidgets::Bench::RunNumberFormatBenchmarks();
+    TulliusWidgets::Bench::RunJsonEscapeBenchmarks();
+    TulliusWidgets::Bench::RunJsonReaderBenchmarks();
+    TulliusWidgets::Bench::RunHostRuntimeBenchmarks();
+    TulliusWidgets::Bench::RunTimedEffectTableBenchmarks();
+    TulliusWidgets::Bench::RunTripleBufferBenchmarks();
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "BenchHarness.h"
+#include "FakePrismaUI.h"
+#include "NativeStorage.h"
+#include "StatsJsonWriter.h"
+#include "WidgetRuntime.h"
+#include "WidgetViewBridge.h"
+#include "WidgetVisibilityState.h"
+#include "keyhandler/keyhandler.h"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace TulliusWidgets::Bench {
+namespace {
+
+using namespace StatsCollectorInternal;
+
+constexpr std::string_view kEffectNames[] = {
+    "Fortify Health", "Potion of Ultimate Healing", "Blessing of Talos", "Resist Fire",
+    "Waterbreathing", "Elixir of Extreme Destruction", "Rested", "Agent of Mara",
+    "\xEC\xB2\xB4\xEB\xA0\xA5 \xEA\xB0\x95\xED\x99\x94", "Dragonbane \"Fury\" of the Ancients",
+};
+
+// A mid-game keyframe: every section filled, ten timed effects.
+StatsPayload BuildSamplePayload()
+{
+    StatsPayload payload{};
+    payload.sequence = 4211;
+    payload.resistances.fire = ResistanceEvaluation{ 91.0f, 85.0f, 85.0f, 0.0f, true };
+    payload.resistances.magic = ResistanceEvaluation{ 30.0f, 30.0f, 85.0f, 0.0f, false };
+    payload.defense = DefenseSnapshot{ 712.0f, 85.44f, 80.0f, true };
+    payload.offense.rightHandDamage = 120.0f;
+    payload.offense.leftHandDamage = 30.0f;
+    payload.equipped.rightHand = "Daedric Sword";
+    payload.equipped.leftHand = "Chain Lightning";
+    payload.time = GameTimeEntry{ 201, 7, 24, 5, 18, 20.0f, "Sun's Height" };
+    payload.playerInfo.level = 48;
+    payload.playerInfo.health = 445.0f;
+    payload.playerInfo.gold = 3433;
+    for (std::size_t i = 0; i < std::size(kEffectNames); ++i) {
+        payload.timedEffects.push_back(TimedEffectEntry{
+            static_cast<std::int32_t>(100 + i), "Alchemy", kEffectNames[i], static_cast<std::int32_t>(60 + i),
+            120, i % 3 == 0, 0x00012345u + static_cast<std::uint32_t>(i), 0x0003EB2Cu, 0x0010FC5Bu,
+            static_cast<std::uint32_t>(1), static_cast<std::uint32_t>(2 + i) });
+    }
+    payload.inCombat = true;
+    return payload;
+}
+
+void RunStatsWriterBenchmarks()
+{
+    StatsJsonWriter writer;
+    auto payload = BuildSamplePayload();
+    Run("host/StatsJsonWriter keyframe v1", 100000, [&]() {
+        DoNotOptimize(writer.Build(payload));
+    });
+    payload.schemaVersion = kStatsSchemaVersionPositional;
+    Run("host/StatsJsonWriter keyframe v2", 100000, [&]() {
+        DoNotOptimize(writer.Build(payload));
+    });
+}
+
+void RunRuntimeDispatchBenchmarks()
+{
+    HostFakes::FakePrismaUI prisma;
+    prisma.recordCalls = false;
+    WidgetViewBridge::Runtime bridge;
+    bridge.SetApi(&prisma);
+    bridge.SetView(prisma.CreateView("index.html"));
+    bridge.SetDomReady(true);
+
+    StatsJsonWriter writer;
+    const auto stats = writer.Build(BuildSamplePayload());
+
+    Run("host/WidgetViewBridge InteropCall", 1000000, [&]() {
+        DoNotOptimize(bridge.InteropCall("updateStats", stats.data()));
+    });
+
+    WidgetRuntime::Callbacks callbacks{};
+    callbacks.isInteropReady = [&]() { return bridge.IsInteropReady(); };
+    callbacks.hasViewFocus = [&]() { return bridge.HasFocus(); };
+    callbacks.captureStats = [](WidgetRuntime::UpdateRateSample&) { return true; };
+    callbacks.buildStatsJson = [&](std::string_view& json) {
+        json = stats;
+        return true;
+    };
+    callbacks.interopCall = [&](const char* functionName, const char* argument) {
+        return bridge.InteropCall(functionName, argument);
+    };
+    WidgetRuntime::Initialize(callbacks);
+    WidgetRuntime::SetGameLoaded(true);
+
+    Run("host/WidgetRuntime forced dispatch", 1000000, [&]() {
+        WidgetRuntime::RequestStatsDispatch(true);
+    });
+    Run("host/WidgetRuntime throttled dispatch", 1000000, [&]() {
+        WidgetRuntime::RequestStatsDispatch(false);
+    });
+
+    WidgetRuntime::SetGameLoaded(false);
+    WidgetRuntime::Initialize({});
+}
+
+void RunVisibilityBenchmarks()
+{
+    HostFakes::ResetGameState();
+    auto* ui = RE::UI::GetSingleton();
+    const RE::BSFixedString hudMenu{ "HUD Menu" };
+
+    Run("host/WidgetVisibilityState IsBlockingUiState", 1000000, [&]() {
+        DoNotOptimize(WidgetVisibilityState::IsBlockingUiState(ui));
+    });
+    Run("host/WidgetVisibilityState ShouldHideForMenu", 1000000, [&]() {
+        DoNotOptimize(WidgetVisibilityState::ShouldHideForMenu(hudMenu));
+    });
+}
+
+void RunKeyHandlerBenchmarks()
+{
+    constexpr std::uint32_t kKeyF = 0x21;
+    KeyHandler::RegisterSink();
+    auto* handler = KeyHandler::GetSingleton();
+    std::uint64_t presses = 0;
+    const auto handle = handler->Register(kKeyF, KeyEventType::KEY_DOWN, [&presses]() { ++presses; });
+
+    Run("host/KeyHandler registered key down", 1000000, [&]() {
+        HostFakes::SendKeyboardEvent(kKeyF, true);
+    });
+    Run("host/KeyHandler unregistered key down", 1000000, [&]() {
+        HostFakes::SendKeyboardEvent(kKeyF + 1, true);
+    });
+    DoNotOptimize(presses);
+    handler->Unregister(handle);
+}
+
+void RunNativeStorageBenchmarks()
+{
+    const auto root = std::filesystem::temp_directory_path() / "tullius-widgets-host-bench";
+    const std::string settings(16 * 1024, ' ');
+
+    Run("host/NativeStorage save+load 16KB", 500, [&]() {
+        DoNotOptimize(NativeStorage::SaveSettings(root, settings));
+        DoNotOptimize(NativeStorage::LoadSettings(root));
+    });
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+}
+
+}  // namespace
+
+void RunHostRuntimeBenchmarks()
+{
+    RunStatsWriterBenchmarks();
+    RunRuntimeDispatchBenchmarks();
+    RunVisibilityBenchmarks();
+    RunKeyHandlerBenchmarks();
+    RunNativeStorageBenchmarks();
+}
+
+}  // namespace TulliusWidgets::Bench
@@ -0,0 +1,112 @@
+#include "BenchHarness.h"
+#include "JsonUtils.h"
+
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace TulliusWidgets::Bench {
+namespace {
+
+// Effect/source names as they show up in timedEffects for an English and a
+// Korean load order, plus a handful that actually need escaping.
+constexpr std::string_view kEnglishNames[] = {
+    "Fortify Health", "Potion of Ultimate Healing", "Blessing of Talos", "Fortify Shout",
+    "Resist Fire", "Waterbreathing", "Elixir of Extreme Destruction", "Ancient Knowledge",
+    "Lover's Comfort", "Rested", "Well Rested", "Agent of Mara", "Frenzy", "Damage Stamina Regen",
+    "Mara's Eye Pond Frostbite Venom", "Vampiric Drain", "Dragonbane Fury of the Ancients",
+};
+constexpr std::string_view kKoreanNames[] = {
+    "\xEC\xB2\xB4\xEB\xA0\xA5 \xEA\xB0\x95\xED\x99\x94",
+    "\xEA\xB6\x81\xEA\xB7\xB9\xEC\x9D\x98 \xEC\xB9\x98\xEC\x9C\xA0 \xEB\xAC\xBC\xEC\x95\xBD",
+    "\xED\x83\x88\xEB\xA1\x9C\xEC\x8A\xA4\xEC\x9D\x98 \xEC\xB6\x95\xEB\xB3\xB5",
+    "\xEC\x8A\xA4\xEB\x9E\x98\xEB\x93\x9C \xEA\xB0\x95\xED\x99\x94",
+    "\xED\x99\x94\xEC\x97\xBC \xEC\xA0\x80\xED\x95\xAD",
+    "\xEC\x88\x98\xEC\xA4\x91 \xED\x98\xB8\xED\x9D\xA1",
+    "\xEA\xB7\xB9\xEB\x8B\xA8\xEC\xA0\x81\xEC\x9D\xB8 \xED\x8C\x8C\xEA\xB4\xB4\xEC\x9D\x98 \xEB\xB9\x84\xEC\x95\xBD",
+    "\xEA\xB3\xA0\xEB\x8C\x80\xEC\x9D\x98 \xEC\xA7\x80\xEC\x8B\x9D",
+    "\xEC\x97\xB0\xEC\x9D\xB8\xEC\x9D\x98 \xEC\x9C\xA0\xEC\x95\x88",
+    "\xED\x9C\xB4\xEC\x8B\x9D", "\xEC\xB6\xA9\xEB\xB6\x84\xED\x95\x9C \xED\x9C\xB4\xEC\x8B\x9D",
+    "\xEB\xA7\x88\xEB\x9D\xBC\xEC\x9D\x98 \xEB\x8C\x80\xEB\xA6\xAC\xEC\x9D\xB8",
+    "\xEA\xB4\x91\xEB\xB6\x84", "\xEC\xA7\x80\xEA\xB5\xAC\xEB\xA0\xA5 \xEC\x9E\xAC\xEC\x83\x9D \xEC\x86\x90\xEC\x83\x81",
+    "\xEB\xA7\x88\xEB\x9D\xBC\xEC\x9D\x98 \xEB\x88\x88 \xEC\x97\xB0\xEB\xAA\xBB \xEB\x83\x89\xEA\xB8\xB0 \xEB\x8F\x85",
+    "\xEB\xB1\x80\xED\x8C\x8C\xEC\x9D\xB4\xEC\x96\xB4 \xED\x9D\xA1\xEC\x88\x98",
+    "\xEB\x93\x9C\xEB\x9E\x98\xEA\xB3\xA4\xEB\xB2\xA0\xEC\x9D\xB8 \xEA\xB3\xA0\xEB\x8C\x80\xEC\x9D\x98 \xEB\xB6\x84\xEB\x85\xB8",
+};
+constexpr std::string_view kEscapeHeavyNames[] = {
+    "Sword \"Dawnbreaker\"", "C:\\Games\\Skyrim\\Data", "Line\nBreak", "Tab\tSeparated",
+    "Mod [v1.2] \"Remastered\" \\ Edition", "\xEA\xB2\x80 \"\xEC\x83\x88\xEB\xB2\xBD\"",
+};
+
+// The pre-change path: Escape() into a temporary, then copy into the buffer.
+std::string LegacyEscape(std::string_view input)
+{
+    std::string out;
+    out.reserve(input.size() * 2 + 2);
+    for (unsigned char c : input) {
+        switch (c) {
+        case '\\': out += "\\\\"; break;
+        case '"': out += "\\\""; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char buf[7];
+                std::snprintf(buf, sizeof(buf), "\\u%04X", static_cast<unsigned int>(c));
+                out += buf;
+            } else {
+                out += static_cast<char>(c);
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+void RunCorpus(const char* label, std::span<const std::string_view> names)
+{
+    std::string out;
+    out.reserve(8192);
+    char legacyName[64];
+    char currentName[64];
+    std::snprintf(legacyName, sizeof(legacyName), "escape/%s legacy", label);
+    std::snprintf(currentName, sizeof(currentName), "escape/%s AppendEscaped", label);
+
+    const double legacy = Run(legacyName, 200000, [&]() {
+        out.clear();
+        for (const auto name : names) {
+            out += '"';
+            out += LegacyEscape(name);
+            out += '"';
+        }
+        DoNotOptimize(out);
+    });
+    const double current = Run(currentName, 200000, [&]() {
+        out.clear();
+        for (const auto name : names) {
+            out += '"';
+            JsonUtils::AppendEscaped(out, name);
+            out += '"';
+        }
+        DoNotOptimize(out);
+    });
+
+    char speedupName[64];
+    std::snprintf(speedupName, sizeof(speedupName), "escape/%s speedup", label);
+    std::printf("%-48s %12.2fx\n", speedupName, legacy / current);
+}
+
+}  // namespace
+
+void RunJsonEscapeBenchmarks()
+{
+    RunCorpus("english", kEnglishNames);
+    RunCorpus("korean", kKoreanNames);
+    RunCorpus("escape-heavy", kEscapeHeavyNames);
+}
+
+}  // namespace TulliusWidgets::Bench
@@ -0,0 +1,95 @@
+#include "BenchHarness.h"
+#include "JsonReader.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TulliusWidgets::Bench {
+namespace {
+
+// The pre-change reader: first `"key"` anywhere in the text, then a number.
+std::optional<std::uint32_t> LegacyTryReadUIntField(std::string_view input, std::string_view key)
+{
+    const std::string needle = "\"" + std::string(key) + "\"";
+    std::size_t searchOffset = 0;
+
+    while (true) {
+        const auto keyPos = input.find(needle, searchOffset);
+        if (keyPos == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        const auto colonPos = input.find(':', keyPos + needle.size());
+        if (colonPos == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        auto valuePos = colonPos + 1;
+        while (valuePos < input.size() && std::isspace(static_cast<unsigned char>(input[valuePos]))) {
+            ++valuePos;
+        }
+
+        std::uint32_t value = 0;
+        const char* begin = input.data() + valuePos;
+        const char* end = input.data() + input.size();
+        const auto [ptr, ec] = std::from_chars(begin, end, value);
+        if (ec == std::errc{} && ptr != begin) {
+            return value;
+        }
+
+        searchOffset = keyPos + needle.size();
+    }
+}
+
+// Shaped like serializeSettingsPayload output: nested setting groups with
+// booleans, numbers and strings, padded with per-widget layout entries up to
+// the 256 KB settings limit, and "rev" last.
+std::string BuildSettingsPayload(std::size_t targetBytes)
+{
+    std::string json =
+        "{\"general\":{\"language\":\"ko\",\"opacity\":85,\"scale\":1.25,\"accentColor\":\"#c8a45c\","
+        "\"note\":\"Preset \\\"Dragonborn\\\" \\u00e9dition\"},\"visibility\":{\"resistances\":true,"
+        "\"timedEffects\":true,\"experience\":false},\"positions\":{";
+    for (int i = 0; json.size() + 512 < targetBytes; ++i) {
+        if (i != 0) json += ',';
+        char entry[256];
+        std::snprintf(
+            entry,
+            sizeof(entry),
+            "\"widget%05d\":{\"x\":%d,\"y\":%d,\"size\":\"medium\",\"visible\":%s,\"layout\":[%d,%d,{\"grid\":null}]}",
+            i, i * 7 % 1920, i * 13 % 1080, i % 2 ? "true" : "false", i % 3, i % 5);
+        json += entry;
+    }
+    json += "},\"schemaVersion\":1,\"rev\":4821}";
+    return json;
+}
+
+}  // namespace
+
+void RunJsonReaderBenchmarks()
+{
+    const auto payload = BuildSettingsPayload(256 * 1024);
+    std::printf("json-reader payload: %zu bytes\n", payload.size());
+
+    const double legacy = Run("json-reader/256KB legacy TryReadUIntField", 2000, [&]() {
+        DoNotOptimize(LegacyTryReadUIntField(payload, "rev"));
+    });
+    const double scanner = Run("json-reader/256KB ScanTopLevelFields", 2000, [&]() {
+        std::optional<std::uint32_t> revision;
+        const bool ok = JsonUtils::ScanTopLevelFields(payload, [&](const JsonUtils::JsonField& field) {
+            if (field.key == "rev") revision = JsonUtils::ReadUInt32(field);
+        });
+        DoNotOptimize(ok);
+        DoNotOptimize(revision);
+    });
+
+    std::printf("%-48s %12.1f MB/s\n", "json-reader/256KB scanner throughput",
+        static_cast<double>(payload.size()) / scanner * 1e9 / (1024.0 * 1024.0));
+    std::printf("%-48s %12.2fx\n", "json-reader/256KB legacy/scanner", legacy / scanner);
+}
+
+}  // namespace TulliusWidgets::Bench
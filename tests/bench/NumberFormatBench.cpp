@@ -0,0 +1,100 @@
+#include "BenchHarness.h"
+#include "JsonUtils.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace TulliusWidgets::Bench {
+namespace {
+
+// Roughly the numeric mix of one updateStats payload: 42 floats from the
+// resistance/defense/offense/calcMeta/playerInfo/alert sections, the calendar
+// integers, and ten timed effects with three ints and three form IDs each.
+constexpr std::array<float, 42> kPayloadFloats = {
+    85.0f, 85.0f, 30.0f, 85.0f, 15.0f, 100.0f, 712.0f, 80.0f, 85.37f, 10.0f, 100.0f,
+    91.0f, 120.0f, 30.0f, 91.0f, 15.0f, 100.0f, 120.0f, 85.44f, 666.67f, 85.0f,
+    -100.0f, 100.0f, 0.0f, 100.0f, 80.0f, 100.0f, 5.0f, 20.0f, 1280.25f, 619.75f,
+    1900.0f, 1900.0f, 241.71f, 445.0f, 312.47f, 186.2f, 240.0f, 93.28f, 100.0f, 77.5f, 54.3f
+};
+constexpr std::array<std::int32_t, 31> kPayloadInts = {
+    8, 3433, 102, 1594, 1800, 103, 59, 60, 104, 12, 30, 105, 240, 240, 106, 7, 10,
+    107, 86, 120, 108, 33, 45, 109, 900, 900, 110, 1, 5, 111, 75
+};
+constexpr std::array<std::uint32_t, 37> kPayloadUInts = {
+    1, 4211, 201, 7, 24, 5, 18, 0x00012345u, 0x00067890u, 0x000112233u, 0x0001E4ABu,
+    0x0003EB2Cu, 0x0010FC5Bu, 0x02001A2Bu, 0x0300C3D4u, 0xFE000123u, 0x00058F5Cu,
+    0x0010F3FFu, 0x000B62E5u, 0x0003EAE3u, 0x0001C4E5u, 0x0010F7F4u, 0x0008F8A1u,
+    0x0004DEE1u, 0x000A26E8u, 0x0010FE8Fu, 0x00102DC7u, 0x00088F1Au, 0x0001D6F2u,
+    0x000E40DFu, 0x0002ACE6u, 0x0006A2F3u, 0x0003A151u, 0x00100E4Au, 0x00049B16u,
+    0x0007B51Cu, 0x000C2E8Du
+};
+
+// The pre-change StatsJsonWriter number path, kept here as the baseline.
+void LegacyAppendFloat(std::string& out, float value)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.2f", value);
+    out += buf;
+}
+
+void LegacyAppendInt(std::string& out, std::int32_t value)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%d", value);
+    out += buf;
+}
+
+void LegacyAppendUInt(std::string& out, std::uint32_t value)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%u", value);
+    out += buf;
+}
+
+}  // namespace
+
+void RunNumberFormatBenchmarks()
+{
+    std::string out;
+    out.reserve(4096);
+
+    const double legacy = Run("numbers/payload snprintf (legacy)", 200000, [&]() {
+        out.clear();
+        for (const float value : kPayloadFloats) {
+            LegacyAppendFloat(out, value);
+            out += ',';
+        }
+        for (const auto value : kPayloadInts) {
+            LegacyAppendInt(out, value);
+            out += ',';
+        }
+        for (const auto value : kPayloadUInts) {
+            LegacyAppendUInt(out, value);
+            out += ',';
+        }
+        DoNotOptimize(out);
+    });
+
+    const double current = Run("numbers/payload AppendFixed2+to_chars", 200000, [&]() {
+        out.clear();
+        for (const float value : kPayloadFloats) {
+            JsonUtils::AppendFixed2(out, value);
+            out += ',';
+        }
+        for (const auto value : kPayloadInts) {
+            JsonUtils::AppendInteger(out, value);
+            out += ',';
+        }
+        for (const auto value : kPayloadUInts) {
+            JsonUtils::AppendInteger(out, value);
+            out += ',';
+        }
+        DoNotOptimize(out);
+    });
+
+    std::printf("%-48s %12.2fx\n", "numbers/payload speedup", legacy / current);
+}
+
+}  // namespace TulliusWidgets::Bench
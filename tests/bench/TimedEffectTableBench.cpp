@@ -0,0 +1,120 @@
+#include "BenchHarness.h"
+#include "TimedEffectTable.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace TulliusWidgets::Bench {
+namespace {
+
+using namespace StatsCollectorInternal;
+
+constexpr std::int32_t kEffectCount = 60;
+
+struct FakeEffect {
+    std::int32_t instanceId;
+    std::string name;
+    bool isDebuff;
+    float duration;
+    float elapsed;
+};
+
+std::vector<FakeEffect> BuildEffects()
+{
+    std::vector<FakeEffect> effects;
+    for (std::int32_t i = 0; i < kEffectCount; ++i) {
+        char name[48];
+        std::snprintf(name, sizeof(name), "  Fortify\tSkill %d  ", i % 17);
+        effects.push_back(FakeEffect{ i, name, i % 6 == 0, 60.0f + static_cast<float>(i * 7 % 240), 0.0f });
+    }
+    return effects;
+}
+
+std::int32_t RemainingSec(const FakeEffect& effect)
+{
+    return static_cast<std::int32_t>(std::max(effect.duration - effect.elapsed, 0.0f)) + 1;
+}
+
+// The pre-change collection: names normalized and interned per tick, then a
+// full sort of the rebuilt list.
+void LegacyCollect(
+    const std::vector<FakeEffect>& effects,
+    std::vector<TimedEffectEntry>& out,
+    StatsScratch& strings,
+    StatsNameTable& names)
+{
+    out.clear();
+    for (const auto& effect : effects) {
+        const auto name = strings.StoreDisplayText(effect.name);
+        out.push_back(TimedEffectEntry{
+            effect.instanceId, name, name, RemainingSec(effect), static_cast<std::int32_t>(effect.duration),
+            effect.isDebuff, 0x00012345u, 0x00067890u, 0x00112233u, names.Intern(name), names.Intern(name) });
+    }
+    std::sort(out.begin(), out.end(), [](const TimedEffectEntry& a, const TimedEffectEntry& b) {
+        if (a.remainingSec != b.remainingSec) return a.remainingSec < b.remainingSec;
+        if (a.isDebuff != b.isDebuff) return a.isDebuff && !b.isDebuff;
+        if (a.sourceName != b.sourceName) return a.sourceName < b.sourceName;
+        if (a.effectName != b.effectName) return a.effectName < b.effectName;
+        if (a.effectFormId != b.effectFormId) return a.effectFormId < b.effectFormId;
+        if (a.sourceFormId != b.sourceFormId) return a.sourceFormId < b.sourceFormId;
+        if (a.spellFormId != b.spellFormId) return a.spellFormId < b.spellFormId;
+        return a.instanceId < b.instanceId;
+    });
+}
+
+void TableCollect(
+    const std::vector<FakeEffect>& effects,
+    TimedEffectTable& table,
+    std::vector<TimedEffectEntry>& out,
+    StatsScratch& strings,
+    StatsNameTable& names)
+{
+    out.clear();
+    table.BeginPass();
+    for (const auto& effect : effects) {
+        const auto remaining = RemainingSec(effect);
+        const auto total = static_cast<std::int32_t>(effect.duration);
+        if (!table.Update(effect.instanceId, remaining, total)) {
+            table.Insert(
+                TimedEffectInfo{ effect.instanceId, effect.name, effect.name, effect.isDebuff, 0x00012345u, 0x00067890u, 0x00112233u },
+                remaining,
+                total);
+        }
+    }
+    table.EndPass();
+    table.Emit(out, strings, names);
+}
+
+}  // namespace
+
+void RunTimedEffectTableBenchmarks()
+{
+    std::printf("\n[timed effects: %d active, one second per tick]\n", kEffectCount);
+
+    auto effects = BuildEffects();
+    StatsScratch strings;
+    StatsNameTable names;
+    std::vector<TimedEffectEntry> out;
+    out.reserve(kEffectCount);
+
+    Run("legacy rebuild + std::sort", 20000, [&]() {
+        for (auto& effect : effects) effect.elapsed = effect.elapsed >= effect.duration ? 0.0f : effect.elapsed + 1.0f;
+        strings.Reset();
+        LegacyCollect(effects, out, strings, names);
+        DoNotOptimize(out.data());
+    });
+
+    TimedEffectTable table;
+    for (auto& effect : effects) effect.elapsed = 0.0f;
+    Run("TimedEffectTable update + emit", 20000, [&]() {
+        for (auto& effect : effects) effect.elapsed = effect.elapsed >= effect.duration ? 0.0f : effect.elapsed + 1.0f;
+        strings.Reset();
+        TableCollect(effects, table, out, strings, names);
+        DoNotOptimize(out.data());
+    });
+}
+
+}  // namespace TulliusWidgets::Bench
@@ -0,0 +1,96 @@
+#include "ActorValueSnapshot.h"
+#include "BenchHarness.h"
+#include "TripleBuffer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace TulliusWidgets::Bench {
+namespace {
+
+using namespace StatsCollectorInternal;
+
+void FillCapture(RawStatsCapture& raw, std::uint32_t sequence)
+{
+    raw.sections = sequence;
+    for (auto& value : raw.values.values) {
+        value = static_cast<float>(sequence);
+    }
+    raw.timedEffectsRefreshed = (sequence & 1) != 0;
+}
+
+// The pre-change handoff: one slot, written and read under a mutex.
+struct LockedSlot {
+    std::mutex mutex;
+    RawStatsCapture raw;
+};
+
+}  // namespace
+
+void RunTripleBufferBenchmarks()
+{
+    std::printf("\n[capture handoff: the other side runs flat out on a second thread]\n");
+
+    {
+        LockedSlot slot;
+        std::uint32_t sequence = 0;
+        std::jthread reader([&](std::stop_token stop) {
+            while (!stop.stop_requested()) {
+                std::scoped_lock lock(slot.mutex);
+                DoNotOptimize(slot.raw.values[PlayerValue::kHealth]);
+            }
+        });
+        Run("mutex slot publish", 1000000, [&]() {
+            std::scoped_lock lock(slot.mutex);
+            FillCapture(slot.raw, ++sequence);
+        });
+    }
+    {
+        TripleBuffer<RawStatsCapture> buffer;
+        std::uint32_t sequence = 0;
+        std::jthread reader([&](std::stop_token stop) {
+            while (!stop.stop_requested()) {
+                if (buffer.Acquire()) {
+                    DoNotOptimize(buffer.ReadSlot().values[PlayerValue::kHealth]);
+                }
+            }
+        });
+        Run("TripleBuffer publish", 1000000, [&]() {
+            FillCapture(buffer.WriteSlot(), ++sequence);
+            buffer.Publish();
+        });
+    }
+    {
+        LockedSlot slot;
+        std::jthread writer([&](std::stop_token stop) {
+            std::uint32_t sequence = 0;
+            while (!stop.stop_requested()) {
+                std::scoped_lock lock(slot.mutex);
+                FillCapture(slot.raw, ++sequence);
+            }
+        });
+        Run("mutex slot read", 1000000, [&]() {
+            std::scoped_lock lock(slot.mutex);
+            DoNotOptimize(slot.raw.values[PlayerValue::kHealth]);
+        });
+    }
+    {
+        TripleBuffer<RawStatsCapture> buffer;
+        std::jthread writer([&](std::stop_token stop) {
+            std::uint32_t sequence = 0;
+            while (!stop.stop_requested()) {
+                FillCapture(buffer.WriteSlot(), ++sequence);
+                buffer.Publish();
+            }
+        });
+        Run("TripleBuffer acquire + read", 1000000, [&]() {
+            (void)buffer.Acquire();
+            DoNotOptimize(buffer.ReadSlot().values[PlayerValue::kHealth]);
+        });
+    }
+}
+
+}  // namespace TulliusWidgets::Bench
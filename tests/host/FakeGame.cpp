@@ -0,0 +1,109 @@
+#include "FakeGame.h"
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace {
+
+RE::UI g_ui;
+RE::PlayerCamera g_playerCamera;
+RE::PlayerCharacter g_player;
+RE::BSInputDeviceManager g_inputDeviceManager;
+SKSE::TaskInterface g_taskInterface;
+
+std::mutex g_taskMutex;
+std::deque<std::function<void()>> g_tasks;
+
+}  // namespace
+
+namespace RE {
+
+BSInputDeviceManager* BSInputDeviceManager::GetSingleton()
+{
+    return &g_inputDeviceManager;
+}
+
+UI* UI::GetSingleton()
+{
+    return &g_ui;
+}
+
+PlayerCamera* PlayerCamera::GetSingleton()
+{
+    return &g_playerCamera;
+}
+
+PlayerCharacter* PlayerCharacter::GetSingleton()
+{
+    return &g_player;
+}
+
+}  // namespace RE
+
+namespace SKSE {
+
+void TaskInterface::AddTask(std::function<void()> task)
+{
+    std::scoped_lock lock(g_taskMutex);
+    g_tasks.push_back(std::move(task));
+}
+
+TaskInterface* GetTaskInterface()
+{
+    return &g_taskInterface;
+}
+
+}  // namespace SKSE
+
+namespace TulliusWidgets::HostFakes {
+
+void ResetGameState()
+{
+    g_ui = RE::UI{};
+    g_playerCamera = RE::PlayerCamera{};
+    g_player = RE::PlayerCharacter{};
+    std::scoped_lock lock(g_taskMutex);
+    g_tasks.clear();
+}
+
+std::size_t RunGameTasks()
+{
+    std::size_t ran = 0;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::scoped_lock lock(g_taskMutex);
+            if (g_tasks.empty()) {
+                return ran;
+            }
+            task = std::move(g_tasks.front());
+            g_tasks.pop_front();
+        }
+        if (task) {
+            task();
+        }
+        ++ran;
+    }
+}
+
+std::size_t PendingGameTaskCount()
+{
+    std::scoped_lock lock(g_taskMutex);
+    return g_tasks.size();
+}
+
+void SendKeyboardEvent(std::uint32_t dxScanCode, bool down)
+{
+    RE::ButtonEvent event;
+    event.device = RE::INPUT_DEVICE::kKeyboard;
+    event.eventType = RE::INPUT_EVENT_TYPE::kButton;
+    event.idCode = dxScanCode;
+    event.value = down ? 1.0f : 0.0f;
+    event.heldDownSecs = down ? 0.0f : 0.1f;
+
+    RE::InputEvent* head = &event;
+    g_inputDeviceManager.SendEvent(&head);
+}
+
+}  // namespace TulliusWidgets::HostFakes
@@ -0,0 +1,250 @@
+#pragma once
+
+// Stand-ins for the slice of CommonLibSSE that the host-built plugin sources
+// touch. Member names and signatures follow the real ones so src/ compiles
+// unchanged; the state behind them is public and driven by tests through
+// TulliusWidgets::HostFakes. Nothing here aims to reproduce engine behavior.
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RE {
+
+enum class ActorValue;
+using ActorHandle = std::uint32_t;
+
+class BSFixedString {
+public:
+    BSFixedString() = default;
+    BSFixedString(const char* text) : text_(text ? text : "") {}
+    BSFixedString(std::string_view text) : text_(text) {}
+
+    const char* c_str() const noexcept { return text_.c_str(); }
+    bool empty() const noexcept { return text_.empty(); }
+    operator std::string_view() const noexcept { return text_; }
+
+private:
+    std::string text_;
+};
+
+enum class BSEventNotifyControl {
+    kContinue = 0,
+    kStop = 1,
+};
+
+template <class Event>
+class BSTEventSource;
+
+template <class Event>
+class BSTEventSink {
+public:
+    virtual ~BSTEventSink() = default;
+    virtual BSEventNotifyControl ProcessEvent(const Event* a_event, BSTEventSource<Event>* a_eventSource) = 0;
+};
+
+template <class Event>
+class BSTEventSource {
+public:
+    void AddEventSink(BSTEventSink<Event>* sink)
+    {
+        if (sink && std::find(sinks_.begin(), sinks_.end(), sink) == sinks_.end()) {
+            sinks_.push_back(sink);
+        }
+    }
+
+    void RemoveEventSink(BSTEventSink<Event>* sink)
+    {
+        sinks_.erase(std::remove(sinks_.begin(), sinks_.end(), sink), sinks_.end());
+    }
+
+    void SendEvent(const Event* event)
+    {
+        for (auto* sink : sinks_) {
+            if (sink->ProcessEvent(event, this) == BSEventNotifyControl::kStop) {
+                return;
+            }
+        }
+    }
+
+    std::size_t SinkCount() const noexcept { return sinks_.size(); }
+
+private:
+    std::vector<BSTEventSink<Event>*> sinks_;
+};
+
+enum class INPUT_DEVICE : std::uint32_t {
+    kNone = static_cast<std::uint32_t>(-1),
+    kKeyboard = 0,
+    kMouse,
+    kGamepad,
+};
+
+enum class INPUT_EVENT_TYPE : std::uint32_t {
+    kButton = 0,
+    kMouseMove,
+    kChar,
+    kThumbstick,
+    kDeviceConnect,
+    kKinect,
+    kNone,
+};
+
+class ButtonEvent;
+
+class InputEvent {
+public:
+    INPUT_DEVICE GetDevice() const noexcept { return device; }
+    ButtonEvent* AsButtonEvent() noexcept;
+
+    INPUT_DEVICE device{ INPUT_DEVICE::kNone };
+    INPUT_EVENT_TYPE eventType{ INPUT_EVENT_TYPE::kNone };
+    InputEvent* next{ nullptr };
+};
+
+class ButtonEvent : public InputEvent {
+public:
+    std::uint32_t GetIDCode() const noexcept { return idCode; }
+    bool IsPressed() const noexcept { return value > 0.0f; }
+    bool IsDown() const noexcept { return value > 0.0f && heldDownSecs == 0.0f; }
+    bool IsUp() const noexcept { return value == 0.0f && heldDownSecs > 0.0f; }
+
+    std::uint32_t idCode{ 0 };
+    float value{ 0.0f };
+    float heldDownSecs{ 0.0f };
+};
+
+inline ButtonEvent* InputEvent::AsButtonEvent() noexcept
+{
+    return eventType == INPUT_EVENT_TYPE::kButton ? static_cast<ButtonEvent*>(this) : nullptr;
+}
+
+class BSInputDeviceManager : public BSTEventSource<InputEvent*> {
+public:
+    static BSInputDeviceManager* GetSingleton();
+};
+
+#define TW_FAKE_MENU(Name)                                              \
+    struct Name {                                                       \
+        static constexpr std::string_view MENU_NAME = #Name;            \
+    }
+
+TW_FAKE_MENU(InventoryMenu);
+TW_FAKE_MENU(MagicMenu);
+TW_FAKE_MENU(MapMenu);
+TW_FAKE_MENU(StatsMenu);
+TW_FAKE_MENU(JournalMenu);
+TW_FAKE_MENU(TweenMenu);
+TW_FAKE_MENU(ContainerMenu);
+TW_FAKE_MENU(BarterMenu);
+TW_FAKE_MENU(GiftMenu);
+TW_FAKE_MENU(LockpickingMenu);
+TW_FAKE_MENU(BookMenu);
+TW_FAKE_MENU(FavoritesMenu);
+TW_FAKE_MENU(Console);
+TW_FAKE_MENU(CraftingMenu);
+TW_FAKE_MENU(TrainingMenu);
+TW_FAKE_MENU(SleepWaitMenu);
+TW_FAKE_MENU(RaceSexMenu);
+TW_FAKE_MENU(LevelUpMenu);
+TW_FAKE_MENU(LoadingMenu);
+
+#undef TW_FAKE_MENU
+
+class UI {
+public:
+    static UI* GetSingleton();
+
+    bool IsMenuOpen(std::string_view menuName) const
+    {
+        return std::find(openMenus.begin(), openMenus.end(), menuName) != openMenus.end();
+    }
+    bool IsShowingMenus() const noexcept { return showingMenus; }
+    bool GameIsPaused() const noexcept { return gamePaused; }
+    bool IsModalMenuOpen() const noexcept { return modalMenuOpen; }
+    bool IsApplicationMenuOpen() const noexcept { return applicationMenuOpen; }
+
+    std::vector<std::string> openMenus;
+    bool showingMenus{ true };
+    bool gamePaused{ false };
+    bool modalMenuOpen{ false };
+    bool applicationMenuOpen{ false };
+};
+
+class PlayerCamera {
+public:
+    static PlayerCamera* GetSingleton();
+
+    bool IsInFreeCameraMode() const noexcept { return freeCamera; }
+
+    bool freeCamera{ false };
+};
+
+class PlayerCharacter {
+public:
+    static PlayerCharacter* GetSingleton();
+
+    bool IsInCombat() const noexcept { return inCombat; }
+
+    bool inCombat{ false };
+};
+
+}  // namespace RE
+
+namespace SKSE {
+
+using PluginHandle = std::uint32_t;
+
+// Tasks are queued, not run, until HostFakes::RunGameTasks() plays the game
+// thread, so code that defers work can be observed before and after.
+class TaskInterface {
+public:
+    void AddTask(std::function<void()> task);
+};
+
+TaskInterface* GetTaskInterface();
+
+// Log calls compile against the same argument lists as spdlog and are
+// discarded; host runs should not depend on log output.
+namespace log {
+
+template <class... Args>
+void trace(std::string_view, Args&&...) noexcept {}
+template <class... Args>
+void debug(std::string_view, Args&&...) noexcept {}
+template <class... Args>
+void info(std::string_view, Args&&...) noexcept {}
+template <class... Args>
+void warn(std::string_view, Args&&...) noexcept {}
+template <class... Args>
+void error(std::string_view, Args&&...) noexcept {}
+template <class... Args>
+void critical(std::string_view, Args&&...) noexcept {}
+
+}  // namespace log
+
+}  // namespace SKSE
+
+// PrismaUI_API.h resolves the plugin through Win32; on the host there is
+// never a PrismaUI.dll, and tests hand a FakePrismaUI to the code instead.
+inline void* GetModuleHandle(const char*) noexcept { return nullptr; }
+inline void* GetProcAddress(void*, const char*) noexcept { return nullptr; }
+
+namespace TulliusWidgets::HostFakes {
+
+// Restores UI, camera, player and task queue to their defaults. Event sinks
+// stay registered, matching sinks that live for the whole game session.
+void ResetGameState();
+
+// Runs queued SKSE tasks, including any they queue in turn. Returns the
+// number of tasks run.
+std::size_t RunGameTasks();
+std::size_t PendingGameTaskCount();
+
+// Sends one keyboard button event through BSInputDeviceManager.
+void SendKeyboardEvent(std::uint32_t dxScanCode, bool down);
+
+}  // namespace TulliusWidgets::HostFakes
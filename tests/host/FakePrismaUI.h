@@ -0,0 +1,180 @@
+#pragma once
+
+#include "PrismaUI_API.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TulliusWidgets::HostFakes {
+
+// In-memory PrismaUI that records what the plugin sends to the view and lets
+// tests fire the JS listeners the plugin registered.
+class FakePrismaUI final : public PRISMA_UI_API::IVPrismaUI1 {
+public:
+    struct InteropRecord {
+        std::string functionName;
+        std::string argument;
+    };
+
+    // Benchmarks turn recording off so the fake's own copies do not show up
+    // in allocation counts; interopCallCount is kept either way.
+    bool recordCalls{ true };
+    std::uint64_t interopCallCount{ 0 };
+    std::vector<InteropRecord> interopCalls;
+    std::vector<std::string> invokedScripts;
+
+    void ClearRecords()
+    {
+        interopCallCount = 0;
+        interopCalls.clear();
+        invokedScripts.clear();
+    }
+
+    // Calls the listener registered for `functionName` on `view`. Returns
+    // false when there is none.
+    bool EmitJsListener(PrismaView view, std::string_view functionName, const char* argument)
+    {
+        const auto it = views_.find(view);
+        if (it == views_.end()) return false;
+        const auto listener = it->second.listeners.find(functionName);
+        if (listener == it->second.listeners.end() || !listener->second) return false;
+        listener->second(argument);
+        return true;
+    }
+
+    PrismaView CreateView(const char*, PRISMA_UI_API::OnDomReadyCallback onDomReadyCallback = nullptr) noexcept override
+    {
+        const PrismaView view = nextView_++;
+        views_[view].onDomReady = onDomReadyCallback;
+        return view;
+    }
+
+    // Plays the view finishing its page load.
+    void CompleteDomLoad(PrismaView view)
+    {
+        const auto it = views_.find(view);
+        if (it != views_.end() && it->second.onDomReady) {
+            it->second.onDomReady(view);
+        }
+    }
+
+    void Invoke(PrismaView view, const char* script, PRISMA_UI_API::JSCallback = nullptr) noexcept override
+    {
+        if (recordCalls && IsValid(view)) {
+            invokedScripts.emplace_back(script ? script : "");
+        }
+    }
+
+    void InteropCall(PrismaView view, const char* functionName, const char* argument) noexcept override
+    {
+        if (!IsValid(view)) return;
+        ++interopCallCount;
+        if (recordCalls) {
+            interopCalls.push_back(InteropRecord{ functionName ? functionName : "", argument ? argument : "" });
+        }
+    }
+
+    void RegisterJSListener(PrismaView view, const char* functionName, PRISMA_UI_API::JSListenerCallback callback) noexcept override
+    {
+        const auto it = views_.find(view);
+        if (it != views_.end() && functionName) {
+            it->second.listeners[functionName] = callback;
+        }
+    }
+
+    bool HasFocus(PrismaView view) noexcept override
+    {
+        const auto* state = Find(view);
+        return state && state->focused;
+    }
+
+    bool Focus(PrismaView view, bool = false, bool = false) noexcept override
+    {
+        if (!IsValid(view)) return false;
+        views_[view].focused = true;
+        return true;
+    }
+
+    void Unfocus(PrismaView view) noexcept override
+    {
+        if (IsValid(view)) views_[view].focused = false;
+    }
+
+    void Show(PrismaView view) noexcept override
+    {
+        if (IsValid(view)) views_[view].hidden = false;
+    }
+
+    void Hide(PrismaView view) noexcept override
+    {
+        if (IsValid(view)) views_[view].hidden = true;
+    }
+
+    bool IsHidden(PrismaView view) noexcept override
+    {
+        const auto* state = Find(view);
+        return !state || state->hidden;
+    }
+
+    int GetScrollingPixelSize(PrismaView view) noexcept override
+    {
+        const auto* state = Find(view);
+        return state ? state->scrollPixels : 0;
+    }
+
+    void SetScrollingPixelSize(PrismaView view, int pixelSize) noexcept override
+    {
+        if (IsValid(view)) views_[view].scrollPixels = pixelSize;
+    }
+
+    bool IsValid(PrismaView view) noexcept override { return views_.find(view) != views_.end(); }
+    void Destroy(PrismaView view) noexcept override { views_.erase(view); }
+
+    void SetOrder(PrismaView view, int order) noexcept override
+    {
+        if (IsValid(view)) views_[view].order = order;
+    }
+
+    int GetOrder(PrismaView view) noexcept override
+    {
+        const auto* state = Find(view);
+        return state ? state->order : 0;
+    }
+
+    void CreateInspectorView(PrismaView) noexcept override {}
+    void SetInspectorVisibility(PrismaView, bool) noexcept override {}
+    bool IsInspectorVisible(PrismaView) noexcept override { return false; }
+    void SetInspectorBounds(PrismaView, float, float, unsigned int, unsigned int) noexcept override {}
+
+    bool HasAnyActiveFocus() noexcept override
+    {
+        for (const auto& [view, state] : views_) {
+            if (state.focused) return true;
+        }
+        return false;
+    }
+
+private:
+    struct ViewState {
+        PRISMA_UI_API::OnDomReadyCallback onDomReady{ nullptr };
+        std::map<std::string, PRISMA_UI_API::JSListenerCallback, std::less<>> listeners;
+        bool hidden{ false };
+        bool focused{ false };
+        int scrollPixels{ 0 };
+        int order{ 0 };
+    };
+
+    const ViewState* Find(PrismaView view) const
+    {
+        const auto it = views_.find(view);
+        return it != views_.end() ? &it->second : nullptr;
+    }
+
+    std::map<PrismaView, ViewState> views_;
+    PrismaView nextView_{ 1 };
+};
+
+}  // namespace TulliusWidgets::HostFakes
@@ -1,5 +1,6 @@
 export const BRIDGE_HANDLERS = {
   updateStats: 'updateStats',
+  updateStatsSchema: 'updateStatsSchema',
   updateSettings: 'updateSettings',
   updateRuntimeStatus: 'updateRuntimeStatus',
   importSettingsFromNative: 'importSettingsFromNative',
@@ -16,6 +17,8 @@ export const BRIDGE_CALLBACKS = {
   onImportSettings: 'onImportSettings',
   onRequestUnfocus: 'onRequestUnfocus',
   onSettingsVisibilityChanged: 'onSettingsVisibilityChanged',
+  onRequestStatsKeyframe: 'onRequestStatsKeyframe',
+  onStatsCapabilities: 'onStatsCapabilities',
   onExportResult: 'onExportResult',
   onImportResult: 'onImportResult',
 } as const;
@@ -67,6 +67,11 @@ export const defaultSettings: WidgetSettings = {
     lowMagickaThreshold: 25,
     overencumbered: true,
   },
+  performance: {
+    minUpdateIntervalMs: 33,
+    maxUpdateIntervalMs: 2000,
+    gameTaskBudgetUs: 1000,
+  },
   positions: {},
   layouts: {},
 };
@@ -47,6 +47,10 @@ export const mockStats: CombatStats = {
     health: 320,
     magicka: 200,
     stamina: 250,
+    ammoCount: 48,
+    healthPotionCount: 6,
+    magickaPotionCount: 3,
+    staminaPotionCount: 2,
   },
   alertData: {
     healthPct: 100,
@@ -31,6 +31,21 @@ describe('settingsSchema', () => {
     expect(merged.general.language).toBe('fr');
   });
 
+  it('clamps update interval bounds and keeps max at or above min', () => {
+    const merged = mergeWithDefaults({
+      performance: {
+        minUpdateIntervalMs: 400,
+        maxUpdateIntervalMs: 100,
+        gameTaskBudgetUs: 20000,
+      },
+    });
+
+    expect(merged.performance).toEqual({ minUpdateIntervalMs: 400, maxUpdateIntervalMs: 400, gameTaskBudgetUs: 8000 });
+    expect(mergeWithDefaults({ performance: { minUpdateIntervalMs: 1 } }).performance.minUpdateIntervalMs).toBe(16);
+    expect(mergeWithDefaults({ performance: { gameTaskBudgetUs: 5 } }).performance.gameTaskBudgetUs).toBe(100);
+    expect(mergeWithDefaults({}).performance).toEqual(defaultSettings.performance);
+  });
+
   it('warns only once for future schema version payloads', () => {
     const warnedFutureSettingsSchemaRef = { current: false };
     const warnSpy = vi.spyOn(console, 'warn').mockImplementation(() => {});
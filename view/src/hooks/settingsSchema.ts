@@ -135,6 +135,18 @@ function mergeVisualAlertsSettings(target: WidgetSettings['visualAlerts'], incom
   target.overencumbered = readBoolean(incoming.overencumbered, target.overencumbered);
 }
 
+// Same limits as the plugin's ClampUpdateRateBounds and GameTaskQueue.
+function mergePerformanceSettings(target: WidgetSettings['performance'], incoming: unknown): void {
+  if (!isPlainObject(incoming)) {
+    return;
+  }
+
+  target.minUpdateIntervalMs = Math.round(readNumber(incoming.minUpdateIntervalMs, target.minUpdateIntervalMs, 16, 10000));
+  target.maxUpdateIntervalMs = Math.round(readNumber(incoming.maxUpdateIntervalMs, target.maxUpdateIntervalMs, 16, 10000));
+  target.maxUpdateIntervalMs = Math.max(target.maxUpdateIntervalMs, target.minUpdateIntervalMs);
+  target.gameTaskBudgetUs = Math.round(readNumber(incoming.gameTaskBudgetUs, target.gameTaskBudgetUs, 100, 8000));
+}
+
 export function mergeWithDefaults(saved: Record<string, unknown>): WidgetSettings {
   const merged = cloneDefaultSettings();
 
@@ -151,6 +163,7 @@ export function mergeWithDefaults(saved: Record<string, unknown>): WidgetSetting
   migrateLegacyExperienceToggle(merged.experience, saved.experience, saved.playerInfo);
   mergeTimedEffectsSettings(merged.timedEffects, saved.timedEffects);
   mergeVisualAlertsSettings(merged.visualAlerts, saved.visualAlerts);
+  mergePerformanceSettings(merged.performance, saved.performance);
   merged.positions = sanitizePositions(saved.positions);
   merged.layouts = sanitizeLayouts(saved.layouts);
   return merged;
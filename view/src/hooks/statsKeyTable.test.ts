@@ -0,0 +1,83 @@
+import { describe, expect, it } from 'vitest';
+import { compileStatsKeyTable } from './statsKeyTable';
+
+const keyTable = {
+  schemaVersion: 2,
+  sections: [
+    ['equipped', 'o', [['rightHand', 'v'], ['leftHand', 'v']]],
+    ['calcMeta', 'o', [['caps', 'o', [['critChance', 'v'], ['damageReduction', 'v']]], ['rawCritChance', 'v']]],
+    ['timedEffects', 'a', [['instanceId', 'v'], ['effectName', 'v']]],
+    ['isInCombat', 'v'],
+  ],
+};
+
+describe('statsKeyTable', () => {
+  it('decodes positional sections back into keyed objects', () => {
+    const decode = compileStatsKeyTable(keyTable);
+    expect(decode).not.toBeNull();
+
+    expect(decode!({
+      schemaVersion: 2,
+      seq: 7,
+      keyframe: false,
+      baseSeq: 6,
+      equipped: ['Daedric Sword', ''],
+      calcMeta: [[100, 80], 112.5],
+      timedEffects: [[102, 'Fortify Shout'], [103, 'Resist Fire']],
+      isInCombat: true,
+    })).toEqual({
+      schemaVersion: 2,
+      seq: 7,
+      keyframe: false,
+      baseSeq: 6,
+      equipped: { rightHand: 'Daedric Sword', leftHand: '' },
+      calcMeta: { caps: { critChance: 100, damageReduction: 80 }, rawCritChance: 112.5 },
+      timedEffects: [
+        { instanceId: 102, effectName: 'Fortify Shout' },
+        { instanceId: 103, effectName: 'Resist Fire' },
+      ],
+      isInCombat: true,
+    });
+  });
+
+  it('resolves name ids through the table carried by keyframes and deltas', () => {
+    const decode = compileStatsKeyTable({
+      schemaVersion: 2,
+      sections: [
+        ['equipped', 'o', [['rightHand', 'n'], ['leftHand', 'n']]],
+        ['timedEffects', 'a', [['instanceId', 'v'], ['sourceName', 'n'], ['effectName', 'n']]],
+      ],
+    })!;
+
+    expect(decode({ keyframe: true, nameBase: 0, names: ['', 'Iron Sword', 'Fortify Health'], equipped: [1, 0] }))
+      .toEqual({ keyframe: true, equipped: { rightHand: 'Iron Sword', leftHand: '' } });
+
+    // Deltas append from nameBase; earlier ids stay valid.
+    expect(decode({ keyframe: false, nameBase: 3, names: ['Resist Fire'], timedEffects: [[7, 3, 2]] }))
+      .toEqual({ keyframe: false, timedEffects: [{ instanceId: 7, sourceName: 'Resist Fire', effectName: 'Fortify Health' }] });
+    expect(decode({ equipped: [2, 1] })).toEqual({ equipped: { rightHand: 'Fortify Health', leftHand: 'Iron Sword' } });
+
+    // A keyframe replaces the table; unknown ids decode to an empty name.
+    expect(decode({ keyframe: true, nameBase: 0, names: ['', 'Steel Sword'], equipped: [1, 3] }))
+      .toEqual({ keyframe: true, equipped: { rightHand: 'Steel Sword', leftHand: '' } });
+  });
+
+  it('passes through values that do not match the table shape', () => {
+    const decode = compileStatsKeyTable(keyTable)!;
+
+    expect(decode({ equipped: { rightHand: 'Keyed' }, timedEffects: ['bad'], extra: 1 })).toEqual({
+      equipped: { rightHand: 'Keyed' },
+      timedEffects: ['bad'],
+      extra: 1,
+    });
+    expect(decode({ equipped: ['Only right'] })).toEqual({ equipped: { rightHand: 'Only right' } });
+  });
+
+  it('rejects malformed key tables', () => {
+    expect(compileStatsKeyTable(null)).toBeNull();
+    expect(compileStatsKeyTable({ schemaVersion: 1, sections: [] })).toBeNull();
+    expect(compileStatsKeyTable({ schemaVersion: 2, sections: [['equipped', 'o']] })).toBeNull();
+    expect(compileStatsKeyTable({ schemaVersion: 2, sections: [['equipped', 'x', []]] })).toBeNull();
+    expect(compileStatsKeyTable({ schemaVersion: 2, sections: [[1, 'v']] })).toBeNull();
+  });
+});
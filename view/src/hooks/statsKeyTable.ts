@@ -0,0 +1,85 @@
+import { isPlainObject } from '../utils/normalize';
+
+export const STATS_POSITIONAL_SCHEMA_VERSION = 2;
+
+// Mirrors the native key table (updateStatsSchema): "v" is a plain value,
+// "n" an id into the payload name table, "o" an object sent as an array in
+// child order, "a" an array of such rows.
+type StatsKeyTableEntry =
+  | { key: string; kind: 'v' | 'n' }
+  | { key: string; kind: 'o' | 'a'; children: StatsKeyTableEntry[] };
+
+export type StatsPayloadDecoder = (payload: Record<string, unknown>) => Record<string, unknown>;
+
+function compileEntry(value: unknown): StatsKeyTableEntry | null {
+  if (!Array.isArray(value) || typeof value[0] !== 'string') return null;
+  const [key, kind, children] = value as [string, unknown, unknown];
+  if (kind === 'v' || kind === 'n') return { key, kind };
+  if ((kind !== 'o' && kind !== 'a') || !Array.isArray(children)) return null;
+
+  const compiled: StatsKeyTableEntry[] = [];
+  for (const child of children) {
+    const entry = compileEntry(child);
+    if (!entry) return null;
+    compiled.push(entry);
+  }
+  return { key, kind, children: compiled };
+}
+
+// Payloads restate the whole name table on keyframes (nameBase 0) and send
+// only new entries otherwise. Ids missing after a dropped payload decode to
+// '' until the keyframe the sequence gap already requested.
+function applyNameUpdate(names: string[], nameBase: unknown, added: unknown): void {
+  if (typeof nameBase !== 'number' || !Number.isInteger(nameBase) || nameBase < 0 || !Array.isArray(added)) return;
+  names.length = Math.min(names.length, nameBase);
+  added.forEach((text, index) => {
+    names[nameBase + index] = typeof text === 'string' ? text : '';
+  });
+}
+
+function decodeObject(names: string[], children: StatsKeyTableEntry[], value: unknown[]): Record<string, unknown> {
+  const out: Record<string, unknown> = {};
+  children.forEach((child, index) => {
+    if (index < value.length) {
+      out[child.key] = decodeValue(names, child, value[index]);
+    }
+  });
+  return out;
+}
+
+// Anything that does not match the table is passed through untouched and
+// left to normalizeCombatStats, which already tolerates malformed sections.
+function decodeValue(names: string[], entry: StatsKeyTableEntry, value: unknown): unknown {
+  if (entry.kind === 'v') return value;
+  if (entry.kind === 'n') return typeof value === 'number' ? names[value] ?? '' : value;
+  if (!Array.isArray(value)) return value;
+  if (entry.kind === 'o') return decodeObject(names, entry.children, value);
+  return value.map(row => (Array.isArray(row) ? decodeObject(names, entry.children, row) : row));
+}
+
+// Returns a decoder that turns a positional (schemaVersion 2) payload back
+// into the keyed v1 shape, or null when the table is malformed. The decoder
+// keeps the name table, so feed it payloads in the order they are applied.
+export function compileStatsKeyTable(value: unknown): StatsPayloadDecoder | null {
+  if (!isPlainObject(value) || value.schemaVersion !== STATS_POSITIONAL_SCHEMA_VERSION) return null;
+  if (!Array.isArray(value.sections)) return null;
+
+  const sections = new Map<string, StatsKeyTableEntry>();
+  for (const section of value.sections) {
+    const entry = compileEntry(section);
+    if (!entry) return null;
+    sections.set(entry.key, entry);
+  }
+
+  const names: string[] = [];
+  return payload => {
+    applyNameUpdate(names, payload.nameBase, payload.names);
+    const decoded: Record<string, unknown> = {};
+    for (const [key, sectionValue] of Object.entries(payload)) {
+      if (key === 'nameBase' || key === 'names') continue;
+      const entry = sections.get(key);
+      decoded[key] = entry ? decodeValue(names, entry, sectionValue) : sectionValue;
+    }
+    return decoded;
+  };
+}
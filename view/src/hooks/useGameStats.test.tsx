@@ -46,6 +46,9 @@ describe('useGameStats', () => {
     vi.restoreAllMocks();
     // Safety: tests shouldn't leak bridge functions.
     delete window.updateStats;
+    delete window.onRequestStatsKeyframe;
+    delete window.updateStatsSchema;
+    delete window.onStatsCapabilities;
     delete window.TulliusWidgetsBridge;
   });
 
@@ -155,6 +158,71 @@ describe('useGameStats', () => {
     expect(latest!.timedEffects[0]?.stableKey).toBe(firstStableKey);
   });
 
+  it('applies delta payload sections on top of the previous keyframe', async () => {
+    const onRequestStatsKeyframe = vi.fn();
+    window.onRequestStatsKeyframe = onRequestStatsKeyframe;
+
+    await act(async () => {
+      root = createRoot(container);
+      root.render(<Harness onStats={stats => { latest = stats; }} />);
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify(createStatsPayload({ seq: 300, keyframe: true })));
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify({
+        schemaVersion: 1,
+        seq: 301,
+        keyframe: false,
+        baseSeq: 300,
+        playerInfo: { ...readPlayerInfo(latest!), health: 42 },
+      }));
+    });
+
+    expect(latest).not.toBeNull();
+    expect(latest!.playerInfo.health).toBe(42);
+    expect(latest!.equipped.rightHand).toBe('Daedric Sword');
+    expect(latest!.timedEffects).toHaveLength(1);
+    expect(onRequestStatsKeyframe).not.toHaveBeenCalled();
+  });
+
+  it('requests a keyframe once when a delta does not chain onto the last applied payload', async () => {
+    const onRequestStatsKeyframe = vi.fn();
+    window.onRequestStatsKeyframe = onRequestStatsKeyframe;
+
+    await act(async () => {
+      root = createRoot(container);
+      root.render(<Harness onStats={stats => { latest = stats; }} />);
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify(createStatsPayload({ seq: 400, keyframe: true })));
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify({ seq: 402, keyframe: false, baseSeq: 401, isInCombat: true }));
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify({ seq: 403, keyframe: false, baseSeq: 402, isInCombat: false }));
+    });
+
+    expect(onRequestStatsKeyframe).toHaveBeenCalledTimes(1);
+    expect(latest!.isInCombat).toBe(false);
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify(createStatsPayload({ seq: 404, keyframe: true })));
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify({ seq: 406, keyframe: false, baseSeq: 405 }));
+    });
+
+    expect(onRequestStatsKeyframe).toHaveBeenCalledTimes(2);
+  });
+
   it('warns once when stats payload schemaVersion is newer than the UI contract', async () => {
     const consoleWarn = vi.spyOn(console, 'warn').mockImplementation(() => {});
 
@@ -164,17 +232,81 @@ describe('useGameStats', () => {
     });
 
     await act(async () => {
-      window.updateStats?.(JSON.stringify(createStatsPayload({ schemaVersion: 2, seq: 201 })));
+      window.updateStats?.(JSON.stringify(createStatsPayload({ schemaVersion: 3, seq: 201 })));
     });
 
     await act(async () => {
-      window.updateStats?.(JSON.stringify(createStatsPayload({ schemaVersion: 3, seq: 202 })));
+      window.updateStats?.(JSON.stringify(createStatsPayload({ schemaVersion: 4, seq: 202 })));
     });
 
     expect(consoleWarn).toHaveBeenCalledTimes(1);
     expect(consoleWarn.mock.calls[0]?.[0]).toContain('schemaVersion');
   });
 
+  it('reports positional support and decodes schemaVersion 2 payloads after the key table arrives', async () => {
+    const onStatsCapabilities = vi.fn();
+    window.onStatsCapabilities = onStatsCapabilities;
+
+    await act(async () => {
+      root = createRoot(container);
+      root.render(<Harness onStats={stats => { latest = stats; }} />);
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify(createStatsPayload({ seq: 500, keyframe: true })));
+    });
+
+    await act(async () => {
+      window.updateStatsSchema?.(JSON.stringify({
+        schemaVersion: 2,
+        sections: [
+          ['equipped', 'o', [['rightHand', 'n'], ['leftHand', 'n']]],
+          ['isInCombat', 'v'],
+        ],
+      }));
+    });
+
+    expect(onStatsCapabilities).toHaveBeenCalledWith('{"schemaVersion":2}');
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify({
+        schemaVersion: 2,
+        seq: 501,
+        keyframe: false,
+        baseSeq: 500,
+        nameBase: 0,
+        names: ['', 'Dawnbreaker', 'Spell Breaker'],
+        equipped: [1, 2],
+        isInCombat: true,
+      }));
+    });
+
+    expect(latest!.equipped).toEqual({ rightHand: 'Dawnbreaker', leftHand: 'Spell Breaker' });
+    expect(latest!.isInCombat).toBe(true);
+    expect(latest!.playerInfo.health).toBe(300);
+  });
+
+  it('drops schemaVersion 2 payloads without a key table and falls back to keyed payloads', async () => {
+    const onStatsCapabilities = vi.fn();
+    window.onStatsCapabilities = onStatsCapabilities;
+
+    await act(async () => {
+      root = createRoot(container);
+      root.render(<Harness onStats={stats => { latest = stats; }} />);
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify(createStatsPayload({ seq: 600, keyframe: true })));
+    });
+
+    await act(async () => {
+      window.updateStats?.(JSON.stringify({ schemaVersion: 2, seq: 601, keyframe: false, baseSeq: 600, equipped: ['X', 'Y'] }));
+    });
+
+    expect(onStatsCapabilities).toHaveBeenCalledWith('{"schemaVersion":1}');
+    expect(latest!.equipped.rightHand).toBe('Daedric Sword');
+  });
+
   it('clamps negative health/magicka/stamina values to 0', async () => {
     await act(async () => {
       root = createRoot(container);
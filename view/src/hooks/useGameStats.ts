@@ -1,13 +1,18 @@
 import { useEffect, useRef, useState } from 'react';
-import { BRIDGE_HANDLERS } from '../constants/bridge';
+import { BRIDGE_CALLBACKS, BRIDGE_HANDLERS } from '../constants/bridge';
 import type { CombatStats, GameTimeInfo, TimedEffect } from '../types/stats';
 import { mockStats } from '../data/mockStats';
 import { isPlainObject, readBoolean, readNumber, readText } from '../utils/normalize';
 import { registerDualBridgeHandler } from '../utils/bridge';
 import { SKYRIM_MONTH_NAMES } from '../data/constants';
+import {
+  compileStatsKeyTable,
+  STATS_POSITIONAL_SCHEMA_VERSION,
+  type StatsPayloadDecoder,
+} from './statsKeyTable';
 
 const isDev = !('sendDataToSKSE' in window);
-const STATS_SCHEMA_VERSION = 1;
+const STATS_SCHEMA_VERSION = STATS_POSITIONAL_SCHEMA_VERSION;
 
 function quantize2(value: number): number {
   return Math.round(value * 100) / 100;
@@ -24,15 +29,6 @@ function toHexId(value: number): string {
   return value.toString(16).toUpperCase().padStart(8, '0');
 }
 
-function sanitizeEffectText(value: string): string {
-  let cleaned = '';
-  for (const char of value) {
-    const code = char.charCodeAt(0);
-    cleaned += (code >= 0x20 && code !== 0x7F) ? char : ' ';
-  }
-  return cleaned.replace(/\s+/g, ' ').trim();
-}
-
 function keySafeText(value: string): string {
   return encodeURIComponent(value);
 }
@@ -51,6 +47,23 @@ function readSchemaVersion(value: unknown): number | null {
   return schemaVersion;
 }
 
+function requestStatsKeyframe(): void {
+  try {
+    window[BRIDGE_CALLBACKS.onRequestStatsKeyframe]?.('');
+  } catch (e) {
+    console.error('[TulliusWidgets] Failed to request stats keyframe:', e);
+  }
+}
+
+// Native stays on keyed v1 payloads until the view reports what it can decode.
+function reportStatsCapabilities(schemaVersion: number): void {
+  try {
+    window[BRIDGE_CALLBACKS.onStatsCapabilities]?.(JSON.stringify({ schemaVersion }));
+  } catch (e) {
+    console.error('[TulliusWidgets] Failed to report stats capabilities:', e);
+  }
+}
+
 function warnFutureStatsSchemaVersion(
   parsed: Record<string, unknown>,
   warnedFutureStatsSchemaRef: { current: boolean },
@@ -166,15 +179,14 @@ function normalizeTimedEffects(value: unknown): TimedEffect[] {
     const item = value[index];
     if (!isPlainObject(item)) continue;
 
-    const rawSourceName = typeof item.sourceName === 'string'
+    // Names arrive already normalized by the plugin (control bytes and
+    // whitespace runs collapsed, invalid UTF-8 replaced), so they are used as-is.
+    let sourceName = typeof item.sourceName === 'string'
       ? item.sourceName
       : typeof item.name === 'string'
         ? item.name
         : '';
-    const rawEffectName = typeof item.effectName === 'string' ? item.effectName : rawSourceName;
-
-    let sourceName = sanitizeEffectText(rawSourceName);
-    let effectName = sanitizeEffectText(rawEffectName);
+    let effectName = typeof item.effectName === 'string' ? item.effectName : sourceName;
 
     const remainingSec = typeof item.remainingSec === 'number' && Number.isFinite(item.remainingSec)
       ? item.remainingSec
@@ -332,6 +344,10 @@ function normalizeCombatStats(value: unknown, fallback: CombatStats): CombatStat
       health: readNumber(rawPlayerInfo?.health, fallback.playerInfo.health, 0, 100000),
       magicka: readNumber(rawPlayerInfo?.magicka, fallback.playerInfo.magicka, 0, 100000),
       stamina: readNumber(rawPlayerInfo?.stamina, fallback.playerInfo.stamina, 0, 100000),
+      ammoCount: Math.trunc(readNumber(rawPlayerInfo?.ammoCount, fallback.playerInfo.ammoCount, 0, 999999999)),
+      healthPotionCount: Math.trunc(readNumber(rawPlayerInfo?.healthPotionCount, fallback.playerInfo.healthPotionCount, 0, 999999999)),
+      magickaPotionCount: Math.trunc(readNumber(rawPlayerInfo?.magickaPotionCount, fallback.playerInfo.magickaPotionCount, 0, 999999999)),
+      staminaPotionCount: Math.trunc(readNumber(rawPlayerInfo?.staminaPotionCount, fallback.playerInfo.staminaPotionCount, 0, 999999999)),
     },
     alertData: {
       healthPct: readNumber(rawAlertData?.healthPct, fallback.alertData.healthPct, 0, 1000),
@@ -379,19 +395,35 @@ export function useGameStatsState(): { stats: CombatStats; hasLiveStats: boolean
   const [hasLiveStats, setHasLiveStats] = useState<boolean>(isDev);
   const hasLiveStatsRef = useRef(hasLiveStats);
   const lastAppliedSequenceRef = useRef<number | null>(null);
+  const keyframeRequestPendingRef = useRef(false);
   const warnedFutureStatsSchemaRef = useRef(false);
   const warnedInvalidStatsContractRef = useRef(false);
   const warnedEmptyPayloadRef = useRef(false);
   const warnedParseFailureRef = useRef(false);
+  const statsDecoderRef = useRef<StatsPayloadDecoder | null>(null);
 
   useEffect(() => {
     hasLiveStatsRef.current = hasLiveStats;
   }, [hasLiveStats]);
 
   useEffect(() => {
+    const updateStatsSchemaHandler = (jsonString: string) => {
+      let decoder: StatsPayloadDecoder | null = null;
+      try {
+        decoder = compileStatsKeyTable(JSON.parse(jsonString) as unknown);
+      } catch (e) {
+        console.error('[TulliusWidgets] Failed to parse stats key table JSON:', e);
+      }
+      if (!decoder) {
+        console.warn('[TulliusWidgets] Ignoring malformed stats key table; staying on keyed stats payloads.');
+      }
+      statsDecoderRef.current = decoder;
+      reportStatsCapabilities(decoder ? STATS_POSITIONAL_SCHEMA_VERSION : 1);
+    };
+
     const updateStatsHandler = (jsonString: string) => {
       try {
-        const parsed = JSON.parse(jsonString) as unknown;
+        let parsed = JSON.parse(jsonString) as unknown;
 
         if (!isPlainObject(parsed)) {
           if (hasLiveStatsRef.current && !warnedParseFailureRef.current) {
@@ -409,18 +441,47 @@ export function useGameStatsState(): { stats: CombatStats; hasLiveStats: boolean
           return;
         }
 
-        warnFutureStatsSchemaVersion(parsed, warnedFutureStatsSchemaRef);
-        warnInvalidStatsContract(parsed, warnedInvalidStatsContractRef);
+        const isPositional = readSchemaVersion(parsed.schemaVersion) === STATS_POSITIONAL_SCHEMA_VERSION;
+        const positionalDecoder = isPositional ? statsDecoderRef.current : null;
+        if (isPositional && !positionalDecoder) {
+          // Positional sections are meaningless without the key table;
+          // ask native to fall back to keyed payloads (with a keyframe).
+          reportStatsCapabilities(1);
+          return;
+        }
 
         const sequence = readSequence(parsed.seq);
+        const lastAppliedSequence = lastAppliedSequenceRef.current;
         if (sequence !== null) {
-          const lastAppliedSequence = lastAppliedSequenceRef.current;
           if (lastAppliedSequence !== null && sequence <= lastAppliedSequence) {
             return;
           }
           lastAppliedSequenceRef.current = sequence;
         }
 
+        // The decoder tracks the name table, so only payloads that are
+        // actually applied may reach it.
+        if (positionalDecoder) {
+          parsed = positionalDecoder(parsed);
+        }
+
+        warnFutureStatsSchemaVersion(parsed, warnedFutureStatsSchemaRef);
+        warnInvalidStatsContract(parsed, warnedInvalidStatsContractRef);
+
+        // Delta payloads only carry changed sections on top of `baseSeq`.
+        // Sections are absolute values, so a delta is still applied after a
+        // gap, but the skipped payload may have changed other sections.
+        if (parsed.keyframe === false) {
+          const baseSequence = readSequence(parsed.baseSeq);
+          const hasGap = baseSequence === null || baseSequence !== lastAppliedSequence;
+          if (hasGap && !keyframeRequestPendingRef.current) {
+            keyframeRequestPendingRef.current = true;
+            requestStatsKeyframe();
+          }
+        } else {
+          keyframeRequestPendingRef.current = false;
+        }
+
         setStats(prev => normalizeCombatStats(parsed, prev));
         hasLiveStatsRef.current = true;
         setHasLiveStats(true);
@@ -434,6 +495,10 @@ export function useGameStatsState(): { stats: CombatStats; hasLiveStats: boolean
     };
 
     const unregisterUpdateStats = registerDualBridgeHandler(BRIDGE_HANDLERS.updateStats, updateStatsHandler);
+    const unregisterUpdateStatsSchema = registerDualBridgeHandler(
+      BRIDGE_HANDLERS.updateStatsSchema,
+      updateStatsSchemaHandler,
+    );
 
     if (isDev) {
       console.log('[TulliusWidgets] Dev mode - using mock stats');
@@ -441,6 +506,7 @@ export function useGameStatsState(): { stats: CombatStats; hasLiveStats: boolean
 
     return () => {
       unregisterUpdateStats();
+      unregisterUpdateStatsSchema();
     };
   }, []);
 
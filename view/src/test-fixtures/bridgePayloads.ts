@@ -50,6 +50,10 @@ export function createStatsPayload(overrides?: Record<string, unknown>): Record<
       health: 300,
       magicka: 100,
       stamina: 100,
+      ammoCount: 48,
+      healthPotionCount: 6,
+      magickaPotionCount: 3,
+      staminaPotionCount: 0,
     },
     alertData: {
       healthPct: 100,
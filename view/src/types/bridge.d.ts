@@ -3,6 +3,7 @@ export {};
 declare global {
   interface TulliusWidgetsBridgeV1 {
     updateStats?: (jsonString: string) => void;
+    updateStatsSchema?: (jsonString: string) => void;
     updateSettings?: (jsonString: string) => void;
     updateRuntimeStatus?: (jsonString: string) => void;
     importSettingsFromNative?: (jsonString: string) => void;
@@ -21,6 +22,7 @@ declare global {
     TulliusWidgetsBridge?: TulliusWidgetsBridgeNamespace;
 
     updateStats?: (jsonString: string) => void;
+    updateStatsSchema?: (jsonString: string) => void;
     updateSettings?: (jsonString: string) => void;
     updateRuntimeStatus?: (jsonString: string) => void;
     importSettingsFromNative?: (jsonString: string) => void;
@@ -35,6 +37,8 @@ declare global {
     onImportSettings?: (argument: string) => void;
     onRequestUnfocus?: (argument: string) => void;
     onSettingsVisibilityChanged?: (argument: string) => void;
+    onRequestStatsKeyframe?: (argument: string) => void;
+    onStatsCapabilities?: (jsonString: string) => void;
 
     onExportResult?: (success: boolean) => void;
     onImportResult?: (success: boolean) => void;
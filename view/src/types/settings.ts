@@ -73,6 +73,14 @@ export interface WidgetSettings {
     lowMagickaThreshold: number;
     overencumbered: boolean;
   };
+  // Read by the plugin: bounds of the stats update interval, which follows
+  // how fast the displayed values change, and how long it may spend on
+  // queued game-thread work per frame.
+  performance: {
+    minUpdateIntervalMs: number;
+    maxUpdateIntervalMs: number;
+    gameTaskBudgetUs: number;
+  };
   positions: Record<string, GroupPosition>;
   layouts: Record<string, WidgetLayout>;
 }
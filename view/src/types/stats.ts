@@ -50,6 +50,10 @@ export interface PlayerInfo {
   health: number;
   magicka: number;
   stamina: number;
+  ammoCount: number;
+  healthPotionCount: number;
+  magickaPotionCount: number;
+  staminaPotionCount: number;
 }
 
 export interface AlertData {
@@ -1,7 +1,9 @@
 -- set minimum xmake version
 set_xmakever("2.8.2")
 
-includes("lib/commonlibsse-ng")
+if is_plat("windows") then
+    includes("lib/commonlibsse-ng")
+end
 
 set_project("TulliusWidgets")
 set_version("1.2.1")
@@ -15,16 +17,84 @@ set_policy("package.requires_lock", true)
 add_rules("mode.release")
 add_rules("plugin.vsxmake.autoupdate")
 
-target("TulliusWidgets")
-    add_deps("commonlibsse-ng")
+if is_plat("windows") then
+    target("TulliusWidgets")
+        add_deps("commonlibsse-ng")
 
-    add_rules("commonlibsse-ng.plugin", {
-        name = "TulliusWidgets",
-        author = "kdw73",
-        description = "Combat stats HUD widgets powered by Prisma UI"
-    })
+        add_rules("commonlibsse-ng.plugin", {
+            name = "TulliusWidgets",
+            author = "kdw73",
+            description = "Combat stats HUD widgets powered by Prisma UI"
+        })
 
-    add_files("src/**.cpp")
-    add_headerfiles("src/**.h")
-    add_includedirs("src")
-    set_pcxxheader("src/pch.h")
+        add_files("src/**.cpp")
+        add_headerfiles("src/**.h")
+        add_includedirs("src")
+        set_pcxxheader("src/pch.h")
+    target_end()
+end
+
+-- Host-side native tests and benchmarks. Plugin sources that do not need
+-- the real engine are built once against the fake RE/SKSE/PrismaUI layer in
+-- tests/host, so they build on any platform without CommonLibSSE.
+option("tsan")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build the host tests and benchmarks with ThreadSanitizer (Linux)")
+option_end()
+
+target("TulliusWidgetsHost")
+    set_kind("static")
+    set_default(false)
+    add_files(
+        "src/ActorValueSnapshot.cpp",
+        "src/GameTaskQueue.cpp",
+        "src/InventoryIndex.cpp",
+        "src/NativeSettings.cpp",
+        "src/NativeStorage.cpp",
+        "src/ResistanceEvaluator.cpp",
+        "src/StatsCaptureFrame.cpp",
+        "src/StatsDiagnostics.cpp",
+        "src/StatsDispatcher.cpp",
+        "src/StatsJsonWriter.cpp",
+        "src/StatsNameTable.cpp",
+        "src/StatsPayloadDiff.cpp",
+        "src/StatsScratch.cpp",
+        "src/TimedEffectTable.cpp",
+        "src/UpdateRateController.cpp",
+        "src/WidgetRuntime.cpp",
+        "src/WidgetViewBridge.cpp",
+        "src/WidgetVisibilityState.cpp",
+        "src/keyhandler/keyhandler.cpp",
+        "tests/host/*.cpp")
+    add_headerfiles("tests/host/**.h")
+    add_includedirs("src", "tests", "tests/host", { public = true })
+    add_forceincludes("HostPrelude.h")
+    if is_plat("linux") then
+        add_syslinks("pthread", { public = true })
+        if has_config("tsan") then
+            add_cxxflags("-fsanitize=thread", { public = true })
+            add_ldflags("-fsanitize=thread", { public = true })
+        end
+    end
+target_end()
+
+target("TulliusWidgetsTests")
+    set_kind("binary")
+    set_default(false)
+    add_deps("TulliusWidgetsHost")
+    add_files("tests/*.cpp")
+    add_headerfiles("tests/*.h")
+    add_forceincludes("HostPrelude.h")
+    -- Tests read checked-in files by their repository path.
+    set_rundir("$(projectdir)")
+target_end()
+
+target("TulliusWidgetsBench")
+    set_kind("binary")
+    set_default(false)
+    add_deps("TulliusWidgetsHost")
+    add_files("tests/bench/*.cpp", "tests/AllocationCounter.cpp")
+    add_headerfiles("tests/bench/*.h")
+    add_forceincludes("HostPrelude.h")
+target_end()